@@ -0,0 +1,205 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/aligned_matrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+bool is_aligned(const T* p, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+class counting_resource
+  : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocated {0};
+
+  explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+    : upstream_ {upstream}
+  {
+  }
+
+private:
+  std::pmr::memory_resource* upstream_;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    allocated += bytes;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    upstream_->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+}
+
+template<typename T>
+class AlignedMatrixTest
+  : public ::testing::Test
+{
+protected:
+  AlignedMatrixTest()
+    : matrix_(7, 5)
+  {
+    std::iota(std::begin(matrix_), std::end(matrix_), T{1});
+  }
+
+  xmaho::std_ext::valmatrix<T> matrix_;
+};
+
+using AlignedMatrixTypes = ::testing::Types<char, int, float, double>;
+TYPED_TEST_CASE(AlignedMatrixTest, AlignedMatrixTypes);
+
+TYPED_TEST(AlignedMatrixTest, Alignment)
+{
+  for (std::size_t n {1}; n < 20; ++n) {
+    const xmaho::std_ext::aligned_matrix<TypeParam> m {n, n};
+    EXPECT_TRUE(is_aligned(m.data(), xmaho::std_ext::cache_line_alignment));
+  }
+  const xmaho::std_ext::aligned_matrix<TypeParam, xmaho::std_ext::huge_page_allocator<TypeParam>> huge {3, 3};
+  EXPECT_TRUE(is_aligned(huge.data(), xmaho::std_ext::huge_page_alignment));
+}
+
+TYPED_TEST(AlignedMatrixTest, Construct)
+{
+  const xmaho::std_ext::aligned_matrix<TypeParam> empty {};
+  EXPECT_EQ(0u, empty.size());
+  EXPECT_EQ(nullptr, empty.data());
+
+  const xmaho::std_ext::aligned_matrix<TypeParam> zero {4, 0};
+  EXPECT_EQ(0u, zero.row_size());
+  EXPECT_EQ(0u, zero.col_size());
+
+  const xmaho::std_ext::aligned_matrix<TypeParam> value {TypeParam{3}, 4, 2};
+  EXPECT_EQ(4u, value.row_size());
+  EXPECT_EQ(2u, value.col_size());
+  for (const auto& e : value)
+    EXPECT_EQ(TypeParam{3}, e);
+
+  const xmaho::std_ext::aligned_matrix<TypeParam> copy {this->matrix_};
+  EXPECT_EQ(this->matrix_.row_size(), copy.row_size());
+  EXPECT_EQ(this->matrix_.col_size(), copy.col_size());
+  EXPECT_EQ(std::vector<TypeParam>(std::begin(this->matrix_), std::end(this->matrix_)), std::vector<TypeParam>(copy.begin(), copy.end()));
+
+  const auto back {to_valmatrix(copy)};
+  EXPECT_EQ(std::vector<TypeParam>(std::begin(this->matrix_), std::end(this->matrix_)), std::vector<TypeParam>(std::begin(back), std::end(back)));
+}
+
+TYPED_TEST(AlignedMatrixTest, PositionAccess)
+{
+  using Position = typename xmaho::std_ext::aligned_matrix<TypeParam>::position_type;
+  xmaho::std_ext::aligned_matrix<TypeParam> m {this->matrix_};
+  for (std::size_t r {0}; r < m.col_size(); ++r)
+    for (std::size_t c {0}; c < m.row_size(); ++c) {
+      const Position position {c, r};
+      EXPECT_EQ(this->matrix_[position], m[position]);
+    }
+  m[Position{2, 3}] = TypeParam{0};
+  EXPECT_EQ(TypeParam{0}, m[3 * m.row_size() + 2]);
+}
+
+TYPED_TEST(AlignedMatrixTest, Expression)
+{
+  using xmaho::std_ext::lazy;
+  xmaho::std_ext::aligned_matrix<TypeParam> m {lazy(this->matrix_) + this->matrix_};
+  EXPECT_TRUE(is_aligned(m.data(), xmaho::std_ext::cache_line_alignment));
+  for (std::size_t i {0}; i < m.size(); ++i)
+    EXPECT_EQ(static_cast<TypeParam>(this->matrix_[i] + this->matrix_[i]), m[i]);
+
+  const auto data {m.data()};
+  m = lazy(m) - this->matrix_;
+  EXPECT_EQ(data, m.data());
+  for (std::size_t i {0}; i < m.size(); ++i)
+    EXPECT_EQ(this->matrix_[i], m[i]);
+
+  const xmaho::std_ext::valmatrix<TypeParam> twice {lazy(m) * TypeParam{2}};
+  for (std::size_t i {0}; i < m.size(); ++i)
+    EXPECT_EQ(static_cast<TypeParam>(this->matrix_[i] * 2), twice[i]);
+}
+
+TYPED_TEST(AlignedMatrixTest, View)
+{
+  xmaho::std_ext::aligned_matrix<TypeParam> m {this->matrix_};
+  view(m) += this->matrix_;
+  const auto& const_m {m};
+  const auto v {view(const_m)};
+  EXPECT_EQ(m.row_size(), v.row_size());
+  EXPECT_EQ(m.col_size(), v.col_size());
+  for (std::size_t i {0}; i < m.size(); ++i)
+    EXPECT_EQ(static_cast<TypeParam>(this->matrix_[i] * 2), m[i]);
+  EXPECT_EQ(m.data(), v.data());
+}
+
+TYPED_TEST(AlignedMatrixTest, Swap)
+{
+  xmaho::std_ext::aligned_matrix<TypeParam> a {this->matrix_};
+  xmaho::std_ext::aligned_matrix<TypeParam> b {TypeParam{1}, 2, 3};
+  const auto a_data {a.data()};
+  swap(a, b);
+  EXPECT_EQ(a_data, b.data());
+  EXPECT_EQ(2u, a.row_size());
+  EXPECT_EQ(3u, a.col_size());
+  EXPECT_EQ(this->matrix_.row_size(), b.row_size());
+
+  a = TypeParam{5};
+  for (const auto& e : a)
+    EXPECT_EQ(TypeParam{5}, e);
+}
+
+TEST(AlignedMatrixPmrTest, MemoryResource)
+{
+  alignas(64) std::byte buffer[1024];
+  std::pmr::monotonic_buffer_resource misaligned {buffer + 8, sizeof(buffer) - 8, std::pmr::null_memory_resource()};
+  counting_resource resource {&misaligned};
+  const xmaho::std_ext::pmr::aligned_matrix<double> m {1., 4, 3, &resource};
+  EXPECT_EQ(12 * sizeof(double), resource.allocated);
+  EXPECT_EQ(&resource, m.get_allocator().resource());
+  EXPECT_TRUE(is_aligned(m.data(), 64));
+  for (const auto& e : m)
+    EXPECT_DOUBLE_EQ(1., e);
+}
@@ -0,0 +1,164 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/batched_matrix.hpp"
+#include "xmaho/std_ext/decomposition.hpp"
+#include "xmaho/std_ext/matmul.hpp"
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+std::vector<xmaho::std_ext::valmatrix<T>> random_matrices(std::size_t count, std::size_t row_size, std::size_t col_size, unsigned seed)
+{
+  std::mt19937 engine {seed};
+  std::uniform_real_distribution<T> distribution {-1, 1};
+  std::vector<xmaho::std_ext::valmatrix<T>> matrices;
+  for (std::size_t i {0}; i < count; ++i) {
+    xmaho::std_ext::valmatrix<T> m {row_size, col_size};
+    for (auto& e : m)
+      e = distribution(engine);
+    matrices.push_back(std::move(m));
+  }
+  return matrices;
+}
+
+}
+
+template<typename T>
+class BatchedMatrixTest
+  : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t batch {37};
+};
+
+using BatchedMatrixTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BatchedMatrixTest, BatchedMatrixTypes);
+
+TYPED_TEST(BatchedMatrixTest, Layout)
+{
+  const auto matrices {random_matrices<TypeParam>(TestFixture::batch, 3, 2, 1)};
+  const xmaho::std_ext::batched_matrix<TypeParam> batched {matrices};
+  EXPECT_EQ(TestFixture::batch, batched.batch_size());
+  EXPECT_EQ(3u, batched.row_size());
+  EXPECT_EQ(2u, batched.col_size());
+  EXPECT_EQ(TestFixture::batch * 6, batched.size());
+
+  for (std::size_t i {0}; i < TestFixture::batch; ++i) {
+    const auto extracted {batched.extract(i)};
+    EXPECT_EQ(3u, extracted.row_size());
+    EXPECT_EQ(2u, extracted.col_size());
+    for (std::size_t e {0}; e < extracted.size(); ++e)
+      EXPECT_EQ(matrices[i][e], extracted[e]);
+    const std::pair<std::size_t, std::size_t> position {2, 1};
+    EXPECT_EQ(matrices[i][position], batched(i, position));
+    EXPECT_EQ(matrices[i][position], batched.lane(position)[i]);
+  }
+}
+
+TYPED_TEST(BatchedMatrixTest, ElementWise)
+{
+  const auto lhs {random_matrices<TypeParam>(TestFixture::batch, 4, 4, 2)};
+  const auto rhs {random_matrices<TypeParam>(TestFixture::batch, 4, 4, 3)};
+  const xmaho::std_ext::batched_matrix<TypeParam> a {lhs};
+  const xmaho::std_ext::batched_matrix<TypeParam> b {rhs};
+  const auto sum {a + b};
+  const auto difference {a - b};
+  const auto product {a * b};
+  const auto scaled {a * TypeParam{3}};
+  auto shifted {a};
+  shifted += TypeParam{1};
+  shifted /= TypeParam{2};
+  for (std::size_t i {0}; i < TestFixture::batch; ++i)
+    for (std::size_t e {0}; e < 16; ++e) {
+      EXPECT_DOUBLE_EQ(lhs[i][e] + rhs[i][e], sum.extract(i)[e]);
+      EXPECT_DOUBLE_EQ(lhs[i][e] - rhs[i][e], difference.extract(i)[e]);
+      EXPECT_DOUBLE_EQ(lhs[i][e] * rhs[i][e], product.extract(i)[e]);
+      EXPECT_DOUBLE_EQ(lhs[i][e] * 3, scaled.extract(i)[e]);
+      EXPECT_DOUBLE_EQ((lhs[i][e] + 1) / 2, shifted.extract(i)[e]);
+    }
+}
+
+TYPED_TEST(BatchedMatrixTest, Matmul)
+{
+  const auto lhs {random_matrices<TypeParam>(TestFixture::batch, 5, 3, 4)}; // 3 rows, 5 columns
+  const auto rhs {random_matrices<TypeParam>(TestFixture::batch, 2, 5, 5)}; // 5 rows, 2 columns
+  const auto product {matmul(xmaho::std_ext::batched_matrix<TypeParam>{lhs}, xmaho::std_ext::batched_matrix<TypeParam>{rhs})};
+  EXPECT_EQ(2u, product.row_size());
+  EXPECT_EQ(3u, product.col_size());
+  for (std::size_t i {0}; i < TestFixture::batch; ++i) {
+    const auto correct {xmaho::std_ext::matmul(lhs[i], rhs[i])};
+    const auto value {product.extract(i)};
+    for (std::size_t e {0}; e < correct.size(); ++e)
+      EXPECT_NEAR(correct[e], value[e], 1e-5);
+  }
+}
+
+TYPED_TEST(BatchedMatrixTest, Solve)
+{
+  auto coefficients {random_matrices<TypeParam>(TestFixture::batch, 6, 6, 6)};
+  for (auto& m : coefficients)
+    for (std::size_t d {0}; d < 6; ++d)
+      m[std::pair<std::size_t, std::size_t>{d, d}] += TypeParam{2};
+  const auto rhs {random_matrices<TypeParam>(TestFixture::batch, 2, 6, 7)};
+  const auto x {solve(xmaho::std_ext::batched_matrix<TypeParam>{coefficients}, xmaho::std_ext::batched_matrix<TypeParam>{rhs})};
+  EXPECT_EQ(2u, x.row_size());
+  EXPECT_EQ(6u, x.col_size());
+  for (std::size_t i {0}; i < TestFixture::batch; ++i) {
+    const auto correct {xmaho::std_ext::lu_decomposition<TypeParam>{coefficients[i]}.solve(rhs[i])};
+    const auto value {x.extract(i)};
+    for (std::size_t e {0}; e < correct.size(); ++e)
+      EXPECT_NEAR(correct[e], value[e], 1e-3);
+  }
+}
+
+TYPED_TEST(BatchedMatrixTest, Pivoting)
+{
+  xmaho::std_ext::batched_matrix<TypeParam> a {2, 2, 2};
+  a.assign(0, xmaho::std_ext::valmatrix<TypeParam>{{0, 1, 1, 0}, 2, 2});
+  a.assign(1, xmaho::std_ext::valmatrix<TypeParam>{{2, 1, 1, 3}, 2, 2});
+  xmaho::std_ext::batched_matrix<TypeParam> b {2, 1, 2};
+  b.assign(0, xmaho::std_ext::valmatrix<TypeParam>{{3, 5}, 1, 2});
+  b.assign(1, xmaho::std_ext::valmatrix<TypeParam>{{3, 5}, 1, 2});
+  const auto x {solve(a, b)};
+  EXPECT_NEAR(5, x.extract(0)[0], 1e-5);
+  EXPECT_NEAR(3, x.extract(0)[1], 1e-5);
+  EXPECT_NEAR(0.8, x.extract(1)[0], 1e-5);
+  EXPECT_NEAR(1.4, x.extract(1)[1], 1e-5);
+
+  a.assign(1, xmaho::std_ext::valmatrix<TypeParam>{{1, 2, 2, 4}, 2, 2});
+  EXPECT_THROW(solve(a, b), std::domain_error);
+}
@@ -0,0 +1,161 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/bitmatrix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+class BitmatrixTest
+  : public ::testing::Test
+{
+protected:
+  using position = xmaho::std_ext::bitmatrix::position_type;
+
+  BitmatrixTest()
+    : lhs_(width, height),
+      rhs_(width, height)
+  {
+    for (std::size_t y {0}; y < height; ++y) {
+      for (std::size_t x {0}; x < width; ++x) {
+        lhs_[position(x, y)] = (x * 7 + y * 3) % 5 < 2;
+        rhs_[position(x, y)] = (x + y) % 3 == 0;
+      }
+    }
+  }
+
+  static constexpr std::size_t width {130};
+  static constexpr std::size_t height {9};
+  xmaho::std_ext::valmatrix<bool> lhs_;
+  xmaho::std_ext::valmatrix<bool> rhs_;
+};
+
+TEST_F(BitmatrixTest, Construct)
+{
+  const xmaho::std_ext::bitmatrix empty {};
+  EXPECT_EQ(empty.row_size(), 0u);
+  EXPECT_EQ(empty.col_size(), 0u);
+  EXPECT_EQ(empty.data(), nullptr);
+
+  const xmaho::std_ext::bitmatrix zero_width {0, 4};
+  EXPECT_EQ(zero_width.col_size(), 0u);
+  EXPECT_EQ(zero_width.size(), 0u);
+
+  const xmaho::std_ext::bitmatrix cleared {width, height};
+  EXPECT_EQ(cleared.row_size(), width);
+  EXPECT_EQ(cleared.col_size(), height);
+  EXPECT_EQ(cleared.row_words(), 3u);
+  EXPECT_EQ(cleared.sum(), 0u);
+  EXPECT_FALSE(cleared.any());
+
+  const xmaho::std_ext::bitmatrix filled {true, width, height};
+  EXPECT_EQ(filled.sum(), width * height);
+  EXPECT_TRUE(filled.all());
+}
+
+TEST_F(BitmatrixTest, RoundTrip)
+{
+  const xmaho::std_ext::bitmatrix packed {lhs_};
+  for (std::size_t y {0}; y < height; ++y) {
+    for (std::size_t x {0}; x < width; ++x)
+      EXPECT_EQ(packed[position(x, y)], lhs_[position(x, y)]);
+  }
+  const auto unpacked = to_valmatrix(packed);
+  EXPECT_TRUE(std::equal(unpacked.begin(), unpacked.end(), lhs_.begin(), lhs_.end()));
+  EXPECT_EQ(packed.sum(), static_cast<std::size_t>(std::count(lhs_.begin(), lhs_.end(), true)));
+}
+
+TEST_F(BitmatrixTest, Element)
+{
+  xmaho::std_ext::bitmatrix m {width, height};
+  m.set(position(129, 8));
+  m.set(position(64, 0)).flip(position(0, 0));
+  EXPECT_TRUE(m.test(position(129, 8)));
+  EXPECT_TRUE(m.test(position(64, 0)));
+  EXPECT_TRUE(m.test(position(0, 0)));
+  EXPECT_EQ(m.sum(), 3u);
+  m.reset(position(64, 0)).set(position(0, 0), false);
+  EXPECT_EQ(m.sum(), 1u);
+}
+
+TEST_F(BitmatrixTest, Logical)
+{
+  const xmaho::std_ext::bitmatrix a {lhs_}, b {rhs_};
+  for (std::size_t y {0}; y < height; ++y) {
+    for (std::size_t x {0}; x < width; ++x) {
+      const position p {x, y};
+      EXPECT_EQ((a & b)[p], lhs_[p] && rhs_[p]);
+      EXPECT_EQ((a | b)[p], lhs_[p] || rhs_[p]);
+      EXPECT_EQ((a ^ b)[p], lhs_[p] != rhs_[p]);
+      EXPECT_EQ((!a)[p], !lhs_[p]);
+    }
+  }
+  EXPECT_EQ((!a).sum(), width * height - a.sum());
+  EXPECT_EQ(!!a, a);
+}
+
+TEST_F(BitmatrixTest, LogicalValue)
+{
+  xmaho::std_ext::bitmatrix m {lhs_};
+  const auto count = m.sum();
+  m ^= true;
+  EXPECT_EQ(m.sum(), width * height - count);
+  m |= true;
+  EXPECT_TRUE(m.all());
+  m &= false;
+  EXPECT_FALSE(m.any());
+}
+
+TEST_F(BitmatrixTest, RowCol)
+{
+  const xmaho::std_ext::bitmatrix m {lhs_};
+  for (std::size_t y {0}; y < height; ++y) {
+    const std::valarray<bool> expected {lhs_.row(y)};
+    EXPECT_TRUE((m.row(y) == expected).min());
+    EXPECT_EQ(m.row_sum(y), static_cast<std::size_t>(std::count(std::begin(expected), std::end(expected), true)));
+  }
+  for (std::size_t x {0}; x < width; ++x) {
+    const std::valarray<bool> expected {lhs_.col(x)};
+    EXPECT_TRUE((m.col(x) == expected).min());
+  }
+}
+
+TEST_F(BitmatrixTest, Compare)
+{
+  xmaho::std_ext::bitmatrix a {lhs_}, b {lhs_};
+  EXPECT_EQ(a, b);
+  b.flip(position(100, 4));
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, xmaho::std_ext::bitmatrix(height, width));
+  swap(a, b);
+  EXPECT_TRUE(a.test(position(100, 4)) != lhs_[position(100, 4)]);
+}
@@ -0,0 +1,180 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/convolution.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+T read(const xmaho::std_ext::valmatrix<T>& m, std::ptrdiff_t x, std::ptrdiff_t y, xmaho::std_ext::border_mode border)
+{
+  const auto cols {static_cast<std::ptrdiff_t>(m.row_size())};
+  const auto rows {static_cast<std::ptrdiff_t>(m.col_size())};
+  if (border == xmaho::std_ext::border_mode::zero && (x < 0 || cols <= x || y < 0 || rows <= y))
+    return T{};
+  if (border == xmaho::std_ext::border_mode::clamp) {
+    x = std::clamp<std::ptrdiff_t>(x, 0, cols - 1);
+    y = std::clamp<std::ptrdiff_t>(y, 0, rows - 1);
+  }
+  if (border == xmaho::std_ext::border_mode::wrap) {
+    x = (x % cols + cols) % cols;
+    y = (y % rows + rows) % rows;
+  }
+  return m[std::pair<std::size_t, std::size_t>{static_cast<std::size_t>(x), static_cast<std::size_t>(y)}];
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> naive_convolve(const xmaho::std_ext::valmatrix<T>& m, const xmaho::std_ext::valmatrix<T>& kernel, xmaho::std_ext::border_mode border)
+{
+  const auto rx {static_cast<std::ptrdiff_t>(kernel.row_size() / 2)};
+  const auto ry {static_cast<std::ptrdiff_t>(kernel.col_size() / 2)};
+  xmaho::std_ext::valmatrix<T> result(m.row_size(), m.col_size());
+  for (std::size_t y {0}; y < m.col_size(); ++y)
+    for (std::size_t x {0}; x < m.row_size(); ++x) {
+      T value {};
+      for (std::size_t j {0}; j < kernel.col_size(); ++j)
+        for (std::size_t i {0}; i < kernel.row_size(); ++i)
+          value += kernel[std::pair<std::size_t, std::size_t>{i, j}]
+                 * read(m, static_cast<std::ptrdiff_t>(x) + rx - static_cast<std::ptrdiff_t>(i), static_cast<std::ptrdiff_t>(y) + ry - static_cast<std::ptrdiff_t>(j), border);
+      result[std::pair<std::size_t, std::size_t>{x, y}] = value;
+    }
+  return result;
+}
+
+}
+
+template<typename T>
+class ConvolutionTest
+  : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    matrix = xmaho::std_ext::valmatrix<T> {600, 13};
+    for (std::size_t i {0}; i < matrix.size(); ++i)
+      matrix[i] = static_cast<T>(i * 7 % 11);
+    kernel = xmaho::std_ext::valmatrix<T> {{1, 2, 0, -1, 3, 1, 0, 2, 1, -2, 1, 1, 0, 2, 1}, 5, 3};
+  }
+
+  static constexpr xmaho::std_ext::border_mode borders[] {xmaho::std_ext::border_mode::zero, xmaho::std_ext::border_mode::clamp, xmaho::std_ext::border_mode::wrap};
+
+  xmaho::std_ext::valmatrix<T> matrix;
+  xmaho::std_ext::valmatrix<T> kernel;
+};
+
+using ConvolutionTypes = ::testing::Types<int, float, double>;
+TYPED_TEST_CASE(ConvolutionTest, ConvolutionTypes);
+
+TYPED_TEST(ConvolutionTest, Convolve)
+{
+  for (const auto border : TestFixture::borders) {
+    const auto correct {naive_convolve(this->matrix, this->kernel, border)};
+    const auto value {xmaho::std_ext::convolve(this->matrix, this->kernel, border)};
+    ASSERT_EQ(correct.row_size(), value.row_size());
+    ASSERT_EQ(correct.col_size(), value.col_size());
+    for (std::size_t i {0}; i < correct.size(); ++i)
+      ASSERT_EQ(correct[i], value[i]);
+  }
+}
+
+TYPED_TEST(ConvolutionTest, Identity)
+{
+  const xmaho::std_ext::valmatrix<TypeParam> identity {{0, 0, 0, 0, 1, 0, 0, 0, 0}, 3, 3};
+  const auto value {xmaho::std_ext::convolve(this->matrix, identity)};
+  for (std::size_t i {0}; i < this->matrix.size(); ++i)
+    EXPECT_EQ(this->matrix[i], value[i]);
+}
+
+TYPED_TEST(ConvolutionTest, Separable)
+{
+  const std::valarray<TypeParam> row_kernel {1, 3, -1, 2, 1};
+  const std::valarray<TypeParam> col_kernel {2, 1, -1};
+  xmaho::std_ext::valmatrix<TypeParam> outer {5, 3};
+  for (std::size_t j {0}; j < 3; ++j)
+    for (std::size_t i {0}; i < 5; ++i)
+      outer[std::pair<std::size_t, std::size_t>{i, j}] = col_kernel[j] * row_kernel[i];
+  for (const auto border : TestFixture::borders) {
+    const auto correct {naive_convolve(this->matrix, outer, border)};
+    const auto value {xmaho::std_ext::convolve_separable(this->matrix, row_kernel, col_kernel, border)};
+    for (std::size_t i {0}; i < correct.size(); ++i)
+      ASSERT_EQ(correct[i], value[i]);
+  }
+}
+
+TYPED_TEST(ConvolutionTest, Stencil)
+{
+  const auto maximum {[](TypeParam a, TypeParam b) {return std::max(a, b);}};
+  const std::pair<std::size_t, std::size_t> size {3, 5};
+  for (const auto border : TestFixture::borders) {
+    const auto value {xmaho::std_ext::stencil(this->matrix, size, maximum, border)};
+    for (std::size_t y {0}; y < this->matrix.col_size(); ++y)
+      for (std::size_t x {0}; x < this->matrix.row_size(); ++x) {
+        auto correct {read(this->matrix, static_cast<std::ptrdiff_t>(x), static_cast<std::ptrdiff_t>(y), border)};
+        for (std::ptrdiff_t j {-2}; j <= 2; ++j)
+          for (std::ptrdiff_t i {-1}; i <= 1; ++i)
+            correct = std::max(correct, read(this->matrix, static_cast<std::ptrdiff_t>(x) + i, static_cast<std::ptrdiff_t>(y) + j, border));
+        const std::pair<std::size_t, std::size_t> position {x, y};
+        ASSERT_EQ(correct, value[position]);
+      }
+  }
+}
+
+TYPED_TEST(ConvolutionTest, Parallel)
+{
+  xmaho::std_ext::parallel_context context {4, 1};
+  const std::valarray<TypeParam> row_kernel {1, 2, 1};
+  const std::pair<std::size_t, std::size_t> size {3, 3};
+  for (const auto border : TestFixture::borders) {
+    const auto convolved {xmaho::std_ext::convolve(this->matrix, this->kernel, border)};
+    const auto parallel_convolved {xmaho::std_ext::convolve(context, this->matrix, this->kernel, border)};
+    const auto separable {xmaho::std_ext::convolve_separable(this->matrix, row_kernel, row_kernel, border)};
+    const auto parallel_separable {xmaho::std_ext::convolve_separable(context, this->matrix, row_kernel, row_kernel, border)};
+    const auto summed {xmaho::std_ext::stencil(this->matrix, size, std::plus<>{}, border)};
+    const auto parallel_summed {xmaho::std_ext::stencil(context, this->matrix, size, std::plus<>{}, border)};
+    for (std::size_t i {0}; i < this->matrix.size(); ++i) {
+      ASSERT_EQ(convolved[i], parallel_convolved[i]);
+      ASSERT_EQ(separable[i], parallel_separable[i]);
+      ASSERT_EQ(summed[i], parallel_summed[i]);
+    }
+  }
+}
+
+TYPED_TEST(ConvolutionTest, Empty)
+{
+  const xmaho::std_ext::valmatrix<TypeParam> empty {};
+  EXPECT_EQ(0u, xmaho::std_ext::convolve(empty, this->kernel).size());
+}
@@ -0,0 +1,164 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/decomposition.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+#include "xmaho/std_ext/matmul.hpp"
+#include "xmaho/std_ext/transpose.hpp"
+
+#include "random_matrix.hpp"
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_spd_matrix(std::size_t n)
+{
+  const auto a {make_random_matrix<T>(n, n)};
+  auto spd {xmaho::std_ext::matmul(a, xmaho::std_ext::transpose(a))};
+  for (std::size_t i {0}; i < n; ++i)
+    spd[i * n + i] += static_cast<T>(n);
+  return spd;
+}
+
+template<typename T>
+void expect_solution(const xmaho::std_ext::valmatrix<T>& a, const xmaho::std_ext::valmatrix<T>& x, const xmaho::std_ext::valmatrix<T>& b)
+{
+  const auto ax {xmaho::std_ext::matmul(a, x)};
+  ASSERT_EQ(b.size(), ax.size());
+  for (std::size_t i {0}; i < b.size(); ++i)
+    EXPECT_NEAR(b[i], ax[i], 1e-8);
+}
+
+}
+
+TEST(DecompositionExampleTest, DocumentExample)
+{
+  const xmaho::std_ext::lu_decomposition<double> lu {xmaho::std_ext::valmatrix<double> {{2, 1, 1, 3}, 2, 2}};
+  const auto x {lu.solve(std::valarray<double> {3, 5})};
+  ASSERT_EQ(2u, x.size());
+  EXPECT_NEAR(0.8, x[0], 1e-12);
+  EXPECT_NEAR(1.4, x[1], 1e-12);
+  EXPECT_NEAR(5.0, lu.determinant(), 1e-12);
+}
+
+TEST(LUDecompositionTest, SolveSmall)
+{
+  const xmaho::std_ext::valmatrix<double> a {{0, 2, 1, 1, 1, 1, 2, 1, 3}, 3, 3};
+  const xmaho::std_ext::lu_decomposition<double> lu {a};
+  EXPECT_NEAR(-3.0, lu.determinant(), 1e-12);
+  const xmaho::std_ext::valmatrix<double> b {{3, 3, 6}, 1, 3};
+  expect_solution(a, lu.solve(b), b);
+}
+
+TEST(LUDecompositionTest, SolveBlocked)
+{
+  const std::size_t n {150};
+  const auto a {make_random_matrix<double>(n, n)};
+  const xmaho::std_ext::lu_decomposition<double> lu {a};
+  const auto b {make_random_matrix<double>(3, n)};
+  expect_solution(a, lu.solve(b), b);
+  const std::valarray<double> v {b.col(1)};
+  const auto x {lu.solve(v)};
+  const auto ax {xmaho::std_ext::matmul(a, xmaho::std_ext::valmatrix<double> {x, 1, n})};
+  for (std::size_t i {0}; i < n; ++i)
+    EXPECT_NEAR(v[i], ax[i], 1e-8);
+}
+
+TEST(LUDecompositionTest, Singular)
+{
+  const xmaho::std_ext::valmatrix<double> a {{1, 2, 2, 4}, 2, 2};
+  EXPECT_THROW(xmaho::std_ext::lu_decomposition<double> {a}, std::domain_error);
+}
+
+TEST(CholeskyDecompositionTest, SolveBlocked)
+{
+  const std::size_t n {140};
+  const auto a {make_spd_matrix<double>(n)};
+  const xmaho::std_ext::cholesky_decomposition<double> cholesky {a};
+  const auto& l {cholesky.matrix()};
+  for (std::size_t i {0}; i < n; ++i)
+    for (auto j {i + 1}; j < n; ++j)
+      EXPECT_EQ(0.0, l[i * n + j]);
+  const auto b {make_random_matrix<double>(2, n)};
+  expect_solution(a, cholesky.solve(b), b);
+  const std::valarray<double> v {b.col(0)};
+  const auto x {cholesky.solve(v)};
+  for (std::size_t i {0}; i < n; ++i)
+    EXPECT_NEAR(cholesky.solve(b)[i * 2], x[i], 1e-10);
+}
+
+TEST(CholeskyDecompositionTest, NotPositiveDefinite)
+{
+  const xmaho::std_ext::valmatrix<double> a {{1, 2, 2, 1}, 2, 2};
+  EXPECT_THROW(xmaho::std_ext::cholesky_decomposition<double> {a}, std::domain_error);
+}
+
+TEST(QRDecompositionTest, SolveSquare)
+{
+  const std::size_t n {130};
+  const auto a {make_random_matrix<double>(n, n)};
+  const xmaho::std_ext::qr_decomposition<double> qr {a};
+  const auto b {make_random_matrix<double>(4, n)};
+  expect_solution(a, qr.solve(b), b);
+}
+
+TEST(QRDecompositionTest, LeastSquares)
+{
+  const std::size_t rows {200};
+  const std::size_t cols {90};
+  const auto a {make_random_matrix<double>(cols, rows)};
+  const xmaho::std_ext::qr_decomposition<double> qr {a};
+  const auto x {qr.solve(std::valarray<double> (1.0, rows))};
+  ASSERT_EQ(cols, x.size());
+  // Normal equation "A^T (A x - b) = 0" holds at the least squares solution.
+  const auto ax {xmaho::std_ext::matmul(a, xmaho::std_ext::valmatrix<double> {x, 1, cols})};
+  for (std::size_t j {0}; j < cols; ++j) {
+    double residual {0};
+    for (std::size_t i {0}; i < rows; ++i)
+      residual += a[i * cols + j] * (ax[i] - 1.0);
+    EXPECT_NEAR(0.0, residual, 1e-8);
+  }
+  const auto r {qr.r()};
+  for (std::size_t i {0}; i < cols; ++i)
+    for (std::size_t j {0}; j < i; ++j)
+      EXPECT_EQ(0.0, r[i * cols + j]);
+}
+
+TEST(QRDecompositionTest, RankDeficient)
+{
+  const xmaho::std_ext::valmatrix<double> a {{1, 2, 2, 4, 3, 6}, 2, 3};
+  const xmaho::std_ext::qr_decomposition<double> qr {a};
+  EXPECT_THROW(qr.solve(std::valarray<double> {1, 2, 3}), std::domain_error);
+}
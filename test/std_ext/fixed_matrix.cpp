@@ -0,0 +1,135 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/fixed_matrix.hpp"
+
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+template<typename T>
+class FixedMatrixTest
+  : public ::testing::Test
+{
+};
+
+using FixedMatrixTypes = ::testing::Types<int, long long, float, double>;
+TYPED_TEST_CASE(FixedMatrixTest, FixedMatrixTypes);
+
+TEST(FixedMatrixConstexprTest, DocumentExample)
+{
+  constexpr xmaho::std_ext::fixed_matrix<int, 2, 2> a {{{1, 2, 3, 4}}};
+  constexpr auto b {xmaho::std_ext::matmul(a, a)};
+  static_assert(b == xmaho::std_ext::fixed_matrix<int, 2, 2> {{{7, 10, 15, 22}}});
+  const xmaho::std_ext::valmatrix<int> c {b};
+  ASSERT_EQ(2u, c.row_size());
+  ASSERT_EQ(2u, c.col_size());
+  EXPECT_EQ(7, c[0]);
+  EXPECT_EQ(10, c[1]);
+  EXPECT_EQ(15, c[2]);
+  EXPECT_EQ(22, c[3]);
+}
+
+TEST(FixedMatrixConstexprTest, CompileTimeOperation)
+{
+  constexpr xmaho::std_ext::fixed_matrix<int, 3, 2> a {{{1, 2, 3, 4, 5, 6}}};
+  static_assert(a.row_size() == 3);
+  static_assert(a.col_size() == 2);
+  static_assert(a.size() == 6);
+  static_assert(a[{2, 1}] == 6);
+  static_assert(a[{0, 1}] == 4);
+  static_assert((a + 1)[0] == 2);
+  static_assert((10 - a)[5] == 4);
+  static_assert((a * a)[2] == 9);
+  static_assert((-a)[1] == -2);
+  static_assert((a << 1)[3] == 8);
+  static_assert(a.sum() == 21);
+  static_assert(xmaho::std_ext::transpose(a) == xmaho::std_ext::fixed_matrix<int, 2, 3> {{{1, 4, 2, 5, 3, 6}}});
+  static_assert(a != xmaho::std_ext::fixed_matrix<int, 3, 2> {});
+}
+
+TYPED_TEST(FixedMatrixTest, Construct)
+{
+  const xmaho::std_ext::fixed_matrix<TypeParam, 4, 3> zero {};
+  for (auto e : zero)
+    EXPECT_EQ(TypeParam{0}, e);
+  const xmaho::std_ext::fixed_matrix<TypeParam, 4, 3> filled {TypeParam{5}};
+  for (auto e : filled)
+    EXPECT_EQ(TypeParam{5}, e);
+}
+
+TYPED_TEST(FixedMatrixTest, ConvertValmatrix)
+{
+  const xmaho::std_ext::valmatrix<TypeParam> v {{1, 2, 3, 4, 5, 6}, 2, 3};
+  const xmaho::std_ext::fixed_matrix<TypeParam, 2, 3> f {v};
+  for (std::size_t i {0}; i < v.size(); ++i)
+    EXPECT_EQ(v[i], f[i]);
+  EXPECT_EQ(TypeParam{6}, (f[{1, 2}]));
+  const xmaho::std_ext::valmatrix<TypeParam> back {f};
+  ASSERT_EQ(2u, back.row_size());
+  ASSERT_EQ(3u, back.col_size());
+  for (std::size_t i {0}; i < v.size(); ++i)
+    EXPECT_EQ(v[i], back[i]);
+}
+
+TYPED_TEST(FixedMatrixTest, CompoundAssign)
+{
+  xmaho::std_ext::fixed_matrix<TypeParam, 2, 2> f {{{1, 2, 3, 4}}};
+  const xmaho::std_ext::valmatrix<TypeParam> v {{4, 3, 2, 1}, 2, 2};
+  f += v;
+  for (auto e : f)
+    EXPECT_EQ(TypeParam{5}, e);
+  f *= f;
+  f -= TypeParam{5};
+  f /= xmaho::std_ext::fixed_matrix<TypeParam, 2, 2> {TypeParam{2}};
+  for (auto e : f)
+    EXPECT_EQ(TypeParam{10}, e);
+}
+
+TYPED_TEST(FixedMatrixTest, Product)
+{
+  const xmaho::std_ext::fixed_matrix<TypeParam, 3, 2> a {{{1, 2, 3, 4, 5, 6}}};
+  const xmaho::std_ext::fixed_matrix<TypeParam, 2, 3> b {{{1, 0, 0, 1, 1, 1}}};
+  const auto c {xmaho::std_ext::matmul(a, b)};
+  static_assert(c.row_size() == 2 && c.col_size() == 2);
+  const xmaho::std_ext::valmatrix<TypeParam> expected {xmaho::std_ext::matmul(xmaho::std_ext::valmatrix<TypeParam> {a}, xmaho::std_ext::valmatrix<TypeParam> {b})};
+  for (std::size_t i {0}; i < c.size(); ++i)
+    EXPECT_EQ(expected[i], c[i]);
+}
+
+TEST(FixedMatrixIntegralTest, BitwiseOperation)
+{
+  xmaho::std_ext::fixed_matrix<unsigned, 2, 2> a {{{1u, 2u, 3u, 4u}}};
+  a |= 8u;
+  a ^= xmaho::std_ext::fixed_matrix<unsigned, 2, 2> {1u};
+  a &= 0xeu;
+  a >>= 1u;
+  a %= 5u;
+  EXPECT_EQ((xmaho::std_ext::fixed_matrix<unsigned, 2, 2> {{{4u, 0u, 0u, 1u}}}), a);
+  EXPECT_EQ(~4u, (~a)[0]);
+}
@@ -0,0 +1,163 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/mapped_matrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::filesystem::path temporary_path(const std::string& name)
+{
+  return std::filesystem::temp_directory_path() / ("xmaho_mapped_matrix_" + name + ".mat");
+}
+
+}
+
+template<typename T>
+class MappedMatrixTest
+  : public ::testing::Test
+{
+protected:
+  MappedMatrixTest()
+    : matrix_(7, 5),
+      path_ {temporary_path(::testing::UnitTest::GetInstance()->current_test_info()->name())}
+  {
+    std::iota(std::begin(matrix_), std::end(matrix_), T{1});
+  }
+
+  ~MappedMatrixTest() override
+  {
+    std::filesystem::remove(path_);
+  }
+
+  xmaho::std_ext::valmatrix<T> matrix_;
+  std::filesystem::path path_;
+};
+
+using MappedMatrixTypes = ::testing::Types<char, int, unsigned long, float, double>;
+TYPED_TEST_CASE(MappedMatrixTest, MappedMatrixTypes);
+
+TYPED_TEST(MappedMatrixTest, CreateAndOpen)
+{
+  {
+    const xmaho::std_ext::mapped_matrix<TypeParam> created {this->path_, this->matrix_};
+  }
+  EXPECT_EQ(sizeof(xmaho::std_ext::matrix_file_header) + this->matrix_.size() * sizeof(TypeParam), std::filesystem::file_size(this->path_));
+
+  xmaho::std_ext::mapped_matrix<const TypeParam> m {this->path_};
+  EXPECT_EQ(this->matrix_.row_size(), m.row_size());
+  EXPECT_EQ(this->matrix_.col_size(), m.col_size());
+  EXPECT_EQ(std::vector<TypeParam>(std::begin(this->matrix_), std::end(this->matrix_)), std::vector<TypeParam>(m.begin(), m.end()));
+
+  using Position = typename xmaho::std_ext::mapped_matrix<TypeParam>::position_type;
+  const Position position {3, 2};
+  EXPECT_EQ(this->matrix_[position], m[position]);
+}
+
+TYPED_TEST(MappedMatrixTest, ReadWrite)
+{
+  {
+    xmaho::std_ext::mapped_matrix<TypeParam> created {this->path_, 3, 2};
+    for (const auto& e : created)
+      EXPECT_EQ(TypeParam{}, e);
+  }
+  {
+    xmaho::std_ext::mapped_matrix<TypeParam> m {this->path_};
+    m[1] = TypeParam{7};
+    m[typename xmaho::std_ext::mapped_matrix<TypeParam>::position_type{2, 1}] = TypeParam{9};
+    m.flush();
+  }
+  const xmaho::std_ext::mapped_matrix<const TypeParam> m {this->path_};
+  const std::vector<TypeParam> correct {0, 7, 0, 0, 0, 9};
+  EXPECT_EQ(correct, std::vector<TypeParam>(m.begin(), m.end()));
+}
+
+TYPED_TEST(MappedMatrixTest, Interoperation)
+{
+  using xmaho::std_ext::lazy;
+  xmaho::std_ext::mapped_matrix<TypeParam> m {this->path_, this->matrix_};
+  view(m) += this->matrix_;
+  const xmaho::std_ext::valmatrix<TypeParam> value {lazy(m) - this->matrix_};
+  EXPECT_EQ(std::vector<TypeParam>(std::begin(this->matrix_), std::end(this->matrix_)), std::vector<TypeParam>(std::begin(value), std::end(value)));
+
+  const xmaho::std_ext::mapped_matrix<const TypeParam> read_only {this->path_};
+  const auto copy {to_valmatrix(read_only)};
+  EXPECT_EQ(m.row_size(), copy.row_size());
+  EXPECT_EQ(m.col_size(), copy.col_size());
+  EXPECT_EQ(std::vector<TypeParam>(m.begin(), m.end()), std::vector<TypeParam>(std::begin(copy), std::end(copy)));
+}
+
+TYPED_TEST(MappedMatrixTest, Move)
+{
+  xmaho::std_ext::mapped_matrix<TypeParam> a {this->path_, this->matrix_};
+  const auto data {a.data()};
+  xmaho::std_ext::mapped_matrix<TypeParam> b {std::move(a)};
+  EXPECT_EQ(data, b.data());
+  EXPECT_EQ(this->matrix_.size(), b.size());
+  a = std::move(b);
+  EXPECT_EQ(data, a.data());
+}
+
+TYPED_TEST(MappedMatrixTest, Empty)
+{
+  { xmaho::std_ext::mapped_matrix<TypeParam> created {this->path_, 0, 4}; }
+  const xmaho::std_ext::mapped_matrix<const TypeParam> m {this->path_};
+  EXPECT_EQ(0u, m.size());
+  EXPECT_EQ(0u, m.row_size());
+  EXPECT_EQ(0u, m.col_size());
+}
+
+TEST(MappedMatrixErrorTest, InvalidFile)
+{
+  const auto path {temporary_path("InvalidFile")};
+  EXPECT_THROW(xmaho::std_ext::mapped_matrix<const double>{path}, std::system_error);
+
+  std::ofstream{path} << "text file";
+  EXPECT_THROW(xmaho::std_ext::mapped_matrix<const double>{path}, std::runtime_error);
+
+  { xmaho::std_ext::mapped_matrix<double> created {path, 3, 2}; }
+  EXPECT_THROW(xmaho::std_ext::mapped_matrix<const float>{path}, std::runtime_error);
+  EXPECT_THROW(xmaho::std_ext::mapped_matrix<std::int64_t>{path}, std::runtime_error);
+  EXPECT_NO_THROW(xmaho::std_ext::mapped_matrix<const double>{path});
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_THROW(xmaho::std_ext::mapped_matrix<const double>{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
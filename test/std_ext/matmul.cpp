@@ -0,0 +1,207 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/matmul.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "random_matrix.hpp"
+
+namespace
+{
+
+using Size = std::pair<std::size_t, std::size_t>;
+
+template<typename T>
+std::vector<T> naive_product(const xmaho::std_ext::valmatrix<T>& a, const xmaho::std_ext::valmatrix<T>& b)
+{
+  std::vector<T> result(a.col_size() * b.row_size());
+  for (std::size_t i {0}; i < a.col_size(); ++i)
+    for (std::size_t j {0}; j < b.row_size(); ++j) {
+      T sum {};
+      for (std::size_t p {0}; p < a.row_size(); ++p)
+        sum += a[i * a.row_size() + p] * b[p * b.row_size() + j];
+      result[i * b.row_size() + j] = sum;
+    }
+  return result;
+}
+
+}
+
+template<typename T>
+class MatmulTest
+  : public ::testing::Test
+{
+protected:
+  void check_product(std::size_t m, std::size_t k, std::size_t n)
+  {
+    const auto a {make_random_matrix<T>(k, m)};
+    const auto b {make_random_matrix<T>(n, k)};
+    const auto c {xmaho::std_ext::matmul(a, b)};
+    ASSERT_EQ(n, c.row_size());
+    ASSERT_EQ(m, c.col_size());
+    const auto correct {naive_product(a, b)};
+    for (std::size_t i {0}; i < correct.size(); ++i) {
+      if constexpr (std::is_floating_point_v<T>)
+        EXPECT_NEAR(correct[i], c[i], 1e-9 * static_cast<double>(k));
+      else
+        EXPECT_EQ(correct[i], c[i]);
+    }
+  }
+
+  void check_strassen(std::size_t m, std::size_t k, std::size_t n, std::size_t cutoff)
+  {
+    const auto a {make_random_matrix<T>(k, m)};
+    const auto b {make_random_matrix<T>(n, k)};
+    const auto c {xmaho::std_ext::strassen_matmul(a, b, cutoff)};
+    ASSERT_EQ(n, c.row_size());
+    ASSERT_EQ(m, c.col_size());
+    const auto correct {naive_product(a, b)};
+    for (std::size_t i {0}; i < correct.size(); ++i) {
+      if constexpr (std::is_floating_point_v<T>)
+        EXPECT_NEAR(correct[i], c[i], 1e-9 * static_cast<double>(k));
+      else
+        EXPECT_EQ(correct[i], c[i]);
+    }
+  }
+};
+
+using MatmulTypes = ::testing::Types<int, long long, double>;
+TYPED_TEST_CASE(MatmulTest, MatmulTypes);
+
+TEST(MatmulExampleTest, DocumentExample)
+{
+  const xmaho::std_ext::valmatrix<int> a {{1, 2, 3, 4, 5, 6}, 3, 2};
+  const xmaho::std_ext::valmatrix<int> b {{1, 0, 0, 1, 1, 1}, 2, 3};
+  const auto c {xmaho::std_ext::matmul(a, b)};
+  ASSERT_EQ(2u, c.row_size());
+  ASSERT_EQ(2u, c.col_size());
+  EXPECT_EQ(4, c[0]);
+  EXPECT_EQ(5, c[1]);
+  EXPECT_EQ(10, c[2]);
+  EXPECT_EQ(11, c[3]);
+}
+
+TYPED_TEST(MatmulTest, SmallProduct)
+{
+  this->check_product(1, 1, 1);
+  this->check_product(3, 5, 2);
+  this->check_product(7, 1, 9);
+}
+
+TYPED_TEST(MatmulTest, BlockedProduct)
+{
+  this->check_product(33, 17, 29);
+  this->check_product(130, 300, 70);
+}
+
+TYPED_TEST(MatmulTest, ReuseResult)
+{
+  const auto a {make_random_matrix<TypeParam>(20, 30)};
+  const auto b {make_random_matrix<TypeParam>(25, 20)};
+  xmaho::std_ext::valmatrix<TypeParam> c {TypeParam{1}, 25, 30};
+  xmaho::std_ext::matmul(a, b, c);
+  const auto correct {naive_product(a, b)};
+  for (std::size_t i {0}; i < correct.size(); ++i) {
+    if constexpr (std::is_floating_point_v<TypeParam>)
+      EXPECT_NEAR(correct[i], c[i], 1e-9 * 20);
+    else
+      EXPECT_EQ(correct[i], c[i]);
+  }
+}
+
+TYPED_TEST(MatmulTest, StrassenProduct)
+{
+  this->check_strassen(64, 64, 64, 8);
+  this->check_strassen(67, 45, 51, 4);
+  this->check_strassen(30, 31, 33, 1);
+  this->check_strassen(20, 20, 20, 64);
+}
+
+TYPED_TEST(MatmulTest, StrassenReuseResult)
+{
+  const auto a {make_random_matrix<TypeParam>(41, 37)};
+  const auto b {make_random_matrix<TypeParam>(39, 41)};
+  xmaho::std_ext::valmatrix<TypeParam> c {TypeParam{1}, 39, 37};
+  xmaho::std_ext::strassen_matmul(a, b, c, 5);
+  const auto correct {naive_product(a, b)};
+  for (std::size_t i {0}; i < correct.size(); ++i) {
+    if constexpr (std::is_floating_point_v<TypeParam>)
+      EXPECT_NEAR(correct[i], c[i], 1e-9 * 41);
+    else
+      EXPECT_EQ(correct[i], c[i]);
+  }
+}
+
+TYPED_TEST(MatmulTest, MultiplyChain)
+{
+  const auto a {make_random_matrix<TypeParam>(3, 17)};  // 17x3
+  const auto b {make_random_matrix<TypeParam>(40, 3)};  // 3x40
+  const auto c {make_random_matrix<TypeParam>(2, 40)};  // 40x2
+  const auto d {make_random_matrix<TypeParam>(25, 2)};  // 2x25
+  const auto e {make_random_matrix<TypeParam>(9, 25)};  // 25x9
+  const auto chain {xmaho::std_ext::multiply_chain(a, b, c, d, e)};
+  const auto correct {xmaho::std_ext::matmul(xmaho::std_ext::matmul(xmaho::std_ext::matmul(xmaho::std_ext::matmul(a, b), c), d), e)};
+  ASSERT_EQ(correct.row_size(), chain.row_size());
+  ASSERT_EQ(correct.col_size(), chain.col_size());
+  for (std::size_t i {0}; i < correct.size(); ++i) {
+    if constexpr (std::is_floating_point_v<TypeParam>)
+      EXPECT_NEAR(correct[i], chain[i], 1e-9 * 40);
+    else
+      EXPECT_EQ(correct[i], chain[i]);
+  }
+
+  const auto single {xmaho::std_ext::multiply_chain(std::vector<const xmaho::std_ext::valmatrix<TypeParam>*> {&b})};
+  for (std::size_t i {0}; i < b.size(); ++i)
+    EXPECT_EQ(b[i], single[i]);
+}
+
+TEST(MatmulChainTest, Plan)
+{
+  // 10x100, 100x5, 5x50: (A B) C costs 7500, A (B C) costs 75000.
+  EXPECT_EQ(1u, xmaho::std_ext::detail::plan_chain({10, 100, 5, 50})[0 * 3 + 2]);
+  // 50x5, 5x100, 100x10: A (B C) is cheaper.
+  EXPECT_EQ(0u, xmaho::std_ext::detail::plan_chain({50, 5, 100, 10})[0 * 3 + 2]);
+  // Classic example of CLRS: ((A1 (A2 A3)) ((A4 A5) A6)).
+  const auto split {xmaho::std_ext::detail::plan_chain({30, 35, 15, 5, 10, 20, 25})};
+  EXPECT_EQ(2u, split[0 * 6 + 5]);
+  EXPECT_EQ(0u, split[0 * 6 + 2]);
+  EXPECT_EQ(4u, split[3 * 6 + 5]);
+}
+
+TEST(MatmulEmptyTest, EmptyProduct)
+{
+  const xmaho::std_ext::valmatrix<int> a {};
+  const xmaho::std_ext::valmatrix<int> b {};
+  EXPECT_FALSE(xmaho::std_ext::matmul(a, b).size());
+  EXPECT_FALSE(xmaho::std_ext::strassen_matmul(a, b).size());
+}
@@ -0,0 +1,173 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/matvec.hpp"
+
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using position = std::pair<std::size_t, std::size_t>;
+
+template<typename T>
+std::valarray<T> random_values(std::size_t size, unsigned seed)
+{
+  std::mt19937 engine {seed};
+  std::uniform_real_distribution<T> distribution {-1, 1};
+  std::valarray<T> values(size);
+  for (auto& e : values)
+    e = distribution(engine);
+  return values;
+}
+
+}
+
+template<typename T>
+class MatvecTest
+  : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t row_count {37};
+  static constexpr std::size_t col_count {53};
+  static constexpr T tolerance {static_cast<T>(1e-4)};
+};
+
+using MatvecTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(MatvecTest, MatvecTypes);
+
+TYPED_TEST(MatvecTest, Gemv)
+{
+  const auto rows {TestFixture::row_count};
+  const auto cols {TestFixture::col_count};
+  const xmaho::std_ext::valmatrix<TypeParam> a {random_values<TypeParam>(rows * cols, 1), cols, rows};
+  const auto x {random_values<TypeParam>(cols, 2)};
+  const auto initial {random_values<TypeParam>(rows, 3)};
+  const TypeParam alpha {2};
+  const TypeParam beta {static_cast<TypeParam>(0.5)};
+  auto y {initial};
+  xmaho::std_ext::gemv(alpha, a, x, beta, y);
+  const auto product {xmaho::std_ext::gemv(a, x)};
+  for (std::size_t i {0}; i < rows; ++i) {
+    TypeParam correct {};
+    for (std::size_t j {0}; j < cols; ++j)
+      correct += a[position{j, i}] * x[j];
+    EXPECT_NEAR(correct, product[i], TestFixture::tolerance);
+    EXPECT_NEAR(alpha * correct + beta * initial[i], y[i], TestFixture::tolerance);
+  }
+}
+
+TYPED_TEST(MatvecTest, GemvTranspose)
+{
+  const auto rows {TestFixture::row_count};
+  const auto cols {TestFixture::col_count};
+  const xmaho::std_ext::valmatrix<TypeParam> a {random_values<TypeParam>(rows * cols, 4), cols, rows};
+  const auto x {random_values<TypeParam>(rows, 5)};
+  const TypeParam alpha {-1};
+  std::valarray<TypeParam> y(static_cast<TypeParam>(1) / 0, cols);
+  xmaho::std_ext::gemv(alpha, a, x, TypeParam{}, y, xmaho::std_ext::transpose_mode::transpose);
+  for (std::size_t j {0}; j < cols; ++j) {
+    TypeParam correct {};
+    for (std::size_t i {0}; i < rows; ++i)
+      correct += a[position{j, i}] * x[i];
+    EXPECT_NEAR(alpha * correct, y[j], TestFixture::tolerance);
+  }
+}
+
+TYPED_TEST(MatvecTest, Ger)
+{
+  const auto rows {TestFixture::row_count};
+  const auto cols {TestFixture::col_count};
+  const xmaho::std_ext::valmatrix<TypeParam> initial {random_values<TypeParam>(rows * cols, 6), cols, rows};
+  const auto x {random_values<TypeParam>(rows, 7)};
+  const auto y {random_values<TypeParam>(cols, 8)};
+  const TypeParam alpha {3};
+  auto a {initial};
+  xmaho::std_ext::ger(alpha, x, y, a);
+  for (std::size_t i {0}; i < rows; ++i)
+    for (std::size_t j {0}; j < cols; ++j) {
+      const position p {j, i};
+      EXPECT_NEAR(initial[p] + alpha * x[i] * y[j], a[p], TestFixture::tolerance);
+    }
+}
+
+TYPED_TEST(MatvecTest, Trsv)
+{
+  const std::size_t n {TestFixture::col_count};
+  auto a {xmaho::std_ext::valmatrix<TypeParam> {random_values<TypeParam>(n * n, 9) / static_cast<TypeParam>(n), n, n}};
+  for (std::size_t i {0}; i < n; ++i)
+    a[position{i, i}] += TypeParam{1};
+  const auto b {random_values<TypeParam>(n, 10)};
+  for (const auto uplo : {xmaho::std_ext::triangle::lower, xmaho::std_ext::triangle::upper})
+    for (const auto trans : {xmaho::std_ext::transpose_mode::none, xmaho::std_ext::transpose_mode::transpose})
+      for (const auto diag : {xmaho::std_ext::diagonal::non_unit, xmaho::std_ext::diagonal::unit}) {
+        auto x {b};
+        xmaho::std_ext::trsv(a, x, uplo, trans, diag);
+        const auto element {[&](std::size_t i, std::size_t j) {
+          if (trans == xmaho::std_ext::transpose_mode::transpose)
+            std::swap(i, j);
+          if (i == j)
+            return diag == xmaho::std_ext::diagonal::unit ? TypeParam{1} : a[position{j, i}];
+          const auto stored {uplo == xmaho::std_ext::triangle::lower ? j < i : i < j};
+          return stored ? a[position{j, i}] : TypeParam{};
+        }};
+        for (std::size_t i {0}; i < n; ++i) {
+          TypeParam value {};
+          for (std::size_t j {0}; j < n; ++j)
+            value += element(i, j) * x[j];
+          EXPECT_NEAR(b[i], value, TestFixture::tolerance);
+        }
+      }
+}
+
+TYPED_TEST(MatvecTest, Symv)
+{
+  const std::size_t n {TestFixture::col_count};
+  const xmaho::std_ext::valmatrix<TypeParam> a {random_values<TypeParam>(n * n, 11), n, n};
+  const auto x {random_values<TypeParam>(n, 12)};
+  const auto initial {random_values<TypeParam>(n, 13)};
+  const TypeParam alpha {static_cast<TypeParam>(1.5)};
+  const TypeParam beta {-2};
+  for (const auto uplo : {xmaho::std_ext::triangle::lower, xmaho::std_ext::triangle::upper}) {
+    auto y {initial};
+    xmaho::std_ext::symv(alpha, a, x, beta, y, uplo);
+    for (std::size_t i {0}; i < n; ++i) {
+      TypeParam correct {};
+      for (std::size_t j {0}; j < n; ++j) {
+        const auto lower {uplo == xmaho::std_ext::triangle::lower ? j <= i : i <= j};
+        correct += (lower ? a[position{j, i}] : a[position{i, j}]) * x[j];
+      }
+      EXPECT_NEAR(alpha * correct + beta * initial[i], y[i], TestFixture::tolerance);
+    }
+  }
+}
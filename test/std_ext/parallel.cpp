@@ -0,0 +1,164 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/parallel.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_sequence_matrix(std::size_t row_size, std::size_t col_size)
+{
+  xmaho::std_ext::valmatrix<T> m(row_size, col_size);
+  for (std::size_t i {0}; i < m.size(); ++i)
+    m[i] = static_cast<T>(i % 97 + 1);
+  return m;
+}
+
+}
+
+template<typename T>
+class ParallelTest
+  : public ::testing::Test
+{
+protected:
+  // Small grain size makes many chunks even for test-sized matrices.
+  xmaho::std_ext::parallel_context context {4, 1};
+};
+
+using ParallelTypes = ::testing::Types<int, unsigned long long, float, double>;
+TYPED_TEST_CASE(ParallelTest, ParallelTypes);
+
+TYPED_TEST(ParallelTest, CompoundAssignMatrix)
+{
+  auto a {make_sequence_matrix<TypeParam>(1001, 3)};
+  const auto b {make_sequence_matrix<TypeParam>(1001, 3)};
+  auto expected {a};
+  expected += b;
+  expected *= b;
+  expected -= b;
+  xmaho::std_ext::plus_assign(this->context, a, b);
+  xmaho::std_ext::multiplies_assign(this->context, a, b);
+  xmaho::std_ext::minus_assign(this->context, a, b);
+  for (std::size_t i {0}; i < a.size(); ++i)
+    EXPECT_EQ(expected[i], a[i]);
+}
+
+TYPED_TEST(ParallelTest, CompoundAssignValarrayAndValue)
+{
+  auto a {make_sequence_matrix<TypeParam>(77, 41)};
+  const std::valarray<TypeParam> b(TypeParam{2}, a.size());
+  auto expected {a};
+  expected *= b;
+  expected /= TypeParam{2};
+  expected += TypeParam{5};
+  xmaho::std_ext::multiplies_assign(this->context, a, b);
+  xmaho::std_ext::divides_assign(this->context, a, TypeParam{2});
+  xmaho::std_ext::plus_assign(this->context, a, TypeParam{5});
+  for (std::size_t i {0}; i < a.size(); ++i)
+    EXPECT_EQ(expected[i], a[i]);
+}
+
+TYPED_TEST(ParallelTest, Reduction)
+{
+  auto a {make_sequence_matrix<TypeParam>(513, 9)};
+  a[1000] = TypeParam{0};
+  a[2000] = TypeParam{200};
+  EXPECT_EQ(a.sum(), xmaho::std_ext::sum(this->context, a));
+  EXPECT_EQ(TypeParam{0}, xmaho::std_ext::min(this->context, a));
+  EXPECT_EQ(TypeParam{200}, xmaho::std_ext::max(this->context, a));
+}
+
+TYPED_TEST(ParallelTest, Negate)
+{
+  const auto a {make_sequence_matrix<TypeParam>(300, 7)};
+  const auto expected {-a};
+  const auto result {xmaho::std_ext::negate(this->context, a)};
+  ASSERT_EQ(a.row_size(), result.row_size());
+  ASSERT_EQ(a.col_size(), result.col_size());
+  for (std::size_t i {0}; i < a.size(); ++i)
+    EXPECT_EQ(expected[i], result[i]);
+}
+
+TEST(ParallelIntegralTest, BitwiseOperation)
+{
+  xmaho::std_ext::parallel_context context {3, 1};
+  auto a {make_sequence_matrix<unsigned>(100, 100)};
+  const auto b {make_sequence_matrix<unsigned>(100, 100)};
+  auto expected {a};
+  expected <<= 2u;
+  expected ^= b;
+  expected %= 7u;
+  expected |= b;
+  expected &= 0xf0u;
+  expected >>= 1u;
+  xmaho::std_ext::shift_left_assign(context, a, 2u);
+  xmaho::std_ext::bit_xor_assign(context, a, b);
+  xmaho::std_ext::modulus_assign(context, a, 7u);
+  xmaho::std_ext::bit_or_assign(context, a, b);
+  xmaho::std_ext::bit_and_assign(context, a, 0xf0u);
+  xmaho::std_ext::shift_right_assign(context, a, 1u);
+  for (std::size_t i {0}; i < a.size(); ++i)
+    EXPECT_EQ(expected[i], a[i]);
+  const auto inverted {xmaho::std_ext::bit_not(context, a)};
+  for (std::size_t i {0}; i < a.size(); ++i)
+    EXPECT_EQ(~a[i], inverted[i]);
+}
+
+TEST(ParallelContextTest, RunAllThreads)
+{
+  xmaho::std_ext::parallel_context context {4};
+  ASSERT_EQ(4u, context.thread_count());
+  std::valarray<int> called(0, context.thread_count());
+  for (int i {0}; i < 10; ++i)
+    context.run([&called](std::size_t index) {++called[index];});
+  for (auto count : called)
+    EXPECT_EQ(10, count);
+}
+
+TEST(ParallelContextTest, RethrowException)
+{
+  xmaho::std_ext::parallel_context context {2};
+  EXPECT_THROW(context.run([](std::size_t index) {if (index == 1) throw std::runtime_error {"fail"};}), std::runtime_error);
+  EXPECT_NO_THROW(context.run([](std::size_t) {}));
+}
+
+TEST(ParallelContextTest, SingleChunk)
+{
+  xmaho::std_ext::parallel_context context {4};
+  auto a {make_sequence_matrix<int>(10, 10)};
+  xmaho::std_ext::plus_assign(context, a, 1);
+  EXPECT_EQ(2, a[0]);
+  EXPECT_EQ(a.sum(), xmaho::std_ext::sum(context, a));
+}
@@ -0,0 +1,58 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_TEST_STD_EXT_RANDOM_MATRIX_H
+#define XMAHO_TEST_STD_EXT_RANDOM_MATRIX_H
+
+#include "xmaho/std_ext/valmatrix.hpp"
+
+#include <cstddef>
+#include <random>
+#include <type_traits>
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_random_matrix(std::size_t row_size, std::size_t col_size)
+{
+  std::default_random_engine rand {std::random_device{}()};
+  xmaho::std_ext::valmatrix<T> m(row_size, col_size);
+  if constexpr (std::is_integral_v<T>) {
+    std::uniform_int_distribution<T> dist {0, 9};
+    for (auto& e : m) e = dist(rand);
+  } else {
+    std::uniform_real_distribution<T> dist {-1, 1};
+    for (auto& e : m) e = dist(rand);
+  }
+  return m;
+}
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/reduction.hpp"
+
+#include <cstddef>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+template<typename T>
+class ReductionTest
+  : public ::testing::Test
+{
+protected:
+  ReductionTest()
+    : matrix_(37, 21)
+  {
+    for (std::size_t i {0}; i < matrix_.size(); ++i)
+      matrix_[i] = static_cast<T>((i * 7) % 23);
+  }
+
+  xmaho::std_ext::valmatrix<T> matrix_;
+};
+
+using ReductionTypes = ::testing::Types<int, float, double>;
+TYPED_TEST_CASE(ReductionTest, ReductionTypes);
+
+TEST(ReductionExampleTest, DocumentExample)
+{
+  const xmaho::std_ext::valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2};
+  const auto rows {xmaho::std_ext::row_sum(m)};
+  ASSERT_EQ(2u, rows.size());
+  EXPECT_EQ(6, rows[0]);
+  EXPECT_EQ(15, rows[1]);
+  const auto cols {xmaho::std_ext::col_max(m)};
+  ASSERT_EQ(3u, cols.size());
+  EXPECT_EQ(4, cols[0]);
+  EXPECT_EQ(5, cols[1]);
+  EXPECT_EQ(6, cols[2]);
+}
+
+TYPED_TEST(ReductionTest, Row)
+{
+  const auto& m {this->matrix_};
+  const auto sum {xmaho::std_ext::row_sum(m)};
+  const auto min {xmaho::std_ext::row_min(m)};
+  const auto max {xmaho::std_ext::row_max(m)};
+  const auto mean {xmaho::std_ext::row_mean(m)};
+  ASSERT_EQ(m.col_size(), sum.size());
+  ASSERT_EQ(m.col_size(), min.size());
+  ASSERT_EQ(m.col_size(), max.size());
+  ASSERT_EQ(m.col_size(), mean.size());
+  for (std::size_t i {0}; i < m.col_size(); ++i) {
+    const std::valarray<TypeParam> row {m.row(i)};
+    EXPECT_EQ(row.sum(), sum[i]);
+    EXPECT_EQ(row.min(), min[i]);
+    EXPECT_EQ(row.max(), max[i]);
+    EXPECT_EQ(static_cast<TypeParam>(row.sum() / static_cast<TypeParam>(m.row_size())), mean[i]);
+  }
+}
+
+TYPED_TEST(ReductionTest, Column)
+{
+  const auto& m {this->matrix_};
+  const auto sum {xmaho::std_ext::col_sum(m)};
+  const auto min {xmaho::std_ext::col_min(m)};
+  const auto max {xmaho::std_ext::col_max(m)};
+  const auto mean {xmaho::std_ext::col_mean(m)};
+  ASSERT_EQ(m.row_size(), sum.size());
+  ASSERT_EQ(m.row_size(), min.size());
+  ASSERT_EQ(m.row_size(), max.size());
+  ASSERT_EQ(m.row_size(), mean.size());
+  for (std::size_t i {0}; i < m.row_size(); ++i) {
+    const std::valarray<TypeParam> col {m.col(i)};
+    EXPECT_EQ(col.sum(), sum[i]);
+    EXPECT_EQ(col.min(), min[i]);
+    EXPECT_EQ(col.max(), max[i]);
+    EXPECT_EQ(static_cast<TypeParam>(col.sum() / static_cast<TypeParam>(m.col_size())), mean[i]);
+  }
+}
+
+TEST(ReductionEmptyTest, Empty)
+{
+  const xmaho::std_ext::valmatrix<int> m {};
+  EXPECT_FALSE(xmaho::std_ext::row_sum(m).size());
+  EXPECT_FALSE(xmaho::std_ext::col_sum(m).size());
+  EXPECT_FALSE(xmaho::std_ext::col_mean(m).size());
+}
@@ -0,0 +1,232 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/serialization.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+std::vector<T> as_vector(const T* first, std::size_t size)
+{
+  return std::vector<T>(first, first + size);
+}
+
+class forward_only_buffer
+  : public std::stringbuf
+{
+public:
+  using std::stringbuf::stringbuf;
+
+protected:
+  pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override
+  {
+    return pos_type(off_type(-1));
+  }
+
+  pos_type seekpos(pos_type, std::ios_base::openmode) override
+  {
+    return pos_type(off_type(-1));
+  }
+};
+
+template<typename U>
+void reverse_at(std::string& buffer, std::size_t offset)
+{
+  std::reverse(buffer.begin() + static_cast<std::ptrdiff_t>(offset), buffer.begin() + static_cast<std::ptrdiff_t>(offset + sizeof(U)));
+}
+
+template<typename T>
+void reverse_byte_order(std::string& buffer)
+{
+  constexpr std::size_t offsets32[] {8, 12, 16, 20, 48};
+  for (const auto& offset : offsets32)
+    reverse_at<std::uint32_t>(buffer, offset);
+  constexpr std::size_t offsets64[] {24, 32, 40};
+  for (const auto& offset : offsets64)
+    reverse_at<std::uint64_t>(buffer, offset);
+  constexpr auto header_size {sizeof(xmaho::std_ext::matrix_file_header)};
+  for (auto offset {header_size}; offset < buffer.size(); offset += sizeof(T))
+    reverse_at<T>(buffer, offset);
+
+  // The writer of other byte order computes checksum of its own payload.
+  xmaho::std_ext::matrix_file_checksum checksum;
+  checksum.update(buffer.data() + header_size, buffer.size() - header_size);
+  const auto value {checksum.value()};
+  std::memcpy(&buffer[40], &value, sizeof(value));
+  reverse_at<std::uint64_t>(buffer, 40);
+}
+
+}
+
+template<typename T>
+class SerializationTest
+  : public ::testing::Test
+{
+protected:
+  SerializationTest()
+    : matrix_(37, 21)
+  {
+    for (std::size_t i {0}; i < matrix_.size(); ++i)
+      matrix_[i] = static_cast<T>((i * 7) % 101);
+  }
+
+  xmaho::std_ext::valmatrix<T> matrix_;
+};
+
+using SerializationTypes = ::testing::Types<char, int, std::uint16_t, std::int64_t, float, double>;
+TYPED_TEST_CASE(SerializationTest, SerializationTypes);
+
+TYPED_TEST(SerializationTest, Valmatrix)
+{
+  for (const auto& checksum : {false, true}) {
+    std::stringstream stream;
+    xmaho::std_ext::serialize(stream, this->matrix_, checksum);
+    EXPECT_EQ(sizeof(xmaho::std_ext::matrix_file_header) + this->matrix_.size() * sizeof(TypeParam), stream.str().size());
+
+    const auto value {xmaho::std_ext::deserialize_valmatrix<TypeParam>(stream)};
+    EXPECT_EQ(this->matrix_.row_size(), value.row_size());
+    EXPECT_EQ(this->matrix_.col_size(), value.col_size());
+    EXPECT_EQ(as_vector(this->matrix_.data(), this->matrix_.size()), as_vector(value.data(), value.size()));
+  }
+}
+
+TYPED_TEST(SerializationTest, Valarray)
+{
+  const std::valarray<TypeParam> array {this->matrix_.row(3)};
+  std::stringstream stream;
+  xmaho::std_ext::serialize(stream, array, true);
+  xmaho::std_ext::serialize(stream, std::valarray<TypeParam>{});
+
+  const auto value {xmaho::std_ext::deserialize_valarray<TypeParam>(stream)};
+  EXPECT_EQ(as_vector(&array[0], array.size()), as_vector(&value[0], value.size()));
+  EXPECT_EQ(0u, xmaho::std_ext::deserialize_valarray<TypeParam>(stream).size());
+
+  std::stringstream matrix_stream;
+  xmaho::std_ext::serialize(matrix_stream, array);
+  const auto matrix {xmaho::std_ext::deserialize_valmatrix<TypeParam>(matrix_stream)};
+  EXPECT_EQ(array.size(), matrix.row_size());
+  EXPECT_EQ(1u, matrix.col_size());
+}
+
+TYPED_TEST(SerializationTest, OtherByteOrder)
+{
+  for (const auto& checksum : {false, true}) {
+    std::stringstream stream;
+    xmaho::std_ext::serialize(stream, this->matrix_, checksum);
+    auto buffer {stream.str()};
+    reverse_byte_order<TypeParam>(buffer);
+    std::stringstream swapped {buffer};
+
+    const auto value {xmaho::std_ext::deserialize_valmatrix<TypeParam>(swapped)};
+    EXPECT_EQ(this->matrix_.row_size(), value.row_size());
+    EXPECT_EQ(this->matrix_.col_size(), value.col_size());
+    EXPECT_EQ(as_vector(this->matrix_.data(), this->matrix_.size()), as_vector(value.data(), value.size()));
+  }
+}
+
+TYPED_TEST(SerializationTest, Corruption)
+{
+  std::stringstream stream;
+  xmaho::std_ext::serialize(stream, this->matrix_, true);
+  const auto buffer {stream.str()};
+
+  auto flipped {buffer};
+  flipped[flipped.size() / 2] = static_cast<char>(flipped[flipped.size() / 2] ^ 0x10);
+  std::stringstream flipped_stream {flipped};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(flipped_stream), std::runtime_error);
+
+  std::stringstream truncated {buffer.substr(0, buffer.size() - 1)};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(truncated), std::runtime_error);
+
+  std::stringstream header_only {buffer.substr(0, 10)};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(header_only), std::runtime_error);
+
+  std::stringstream text {std::string(100, '1')};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(text), std::runtime_error);
+
+  std::stringstream other_type {buffer};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<long double>(other_type), std::runtime_error);
+
+  auto reserved {buffer};
+  reserved[offsetof(xmaho::std_ext::matrix_file_header, reserved)] = 1;
+  std::stringstream reserved_stream {reserved};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(reserved_stream), std::runtime_error);
+}
+
+TYPED_TEST(SerializationTest, HugeHeader)
+{
+  const auto header {xmaho::std_ext::make_matrix_file_header<TypeParam>(std::size_t{1} << 20, std::size_t{1} << 20)};
+  const std::string buffer(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::stringstream seekable {buffer};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(seekable), std::runtime_error);
+
+  forward_only_buffer forward_only {buffer};
+  std::istream stream {&forward_only};
+  EXPECT_THROW(xmaho::std_ext::deserialize_valmatrix<TypeParam>(stream), std::runtime_error);
+}
+
+TYPED_TEST(SerializationTest, ForwardOnlyStream)
+{
+  std::stringstream source;
+  xmaho::std_ext::serialize(source, this->matrix_, true);
+  forward_only_buffer forward_only {source.str()};
+  std::istream stream {&forward_only};
+  const auto value {xmaho::std_ext::deserialize_valmatrix<TypeParam>(stream)};
+  EXPECT_EQ(as_vector(this->matrix_.data(), this->matrix_.size()), as_vector(value.data(), value.size()));
+}
+
+TEST(SerializationChecksumTest, Incremental)
+{
+  std::vector<unsigned char> bytes(1001);
+  std::iota(bytes.begin(), bytes.end(), static_cast<unsigned char>(0));
+  xmaho::std_ext::matrix_file_checksum whole;
+  whole.update(bytes.data(), bytes.size());
+  xmaho::std_ext::matrix_file_checksum parts;
+  parts.update(bytes.data(), 400);
+  parts.update(bytes.data() + 400, 601);
+  EXPECT_EQ(whole.value(), parts.value());
+
+  std::swap(bytes[0], bytes[4]);
+  xmaho::std_ext::matrix_file_checksum swapped;
+  swapped.update(bytes.data(), bytes.size());
+  EXPECT_NE(whole.value(), swapped.value());
+}
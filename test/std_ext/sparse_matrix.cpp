@@ -0,0 +1,212 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/sparse_matrix.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+#include "xmaho/std_ext/matmul.hpp"
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_sparse_dense(std::size_t row_size, std::size_t col_size)
+{
+  std::default_random_engine rand {std::random_device{}()};
+  std::uniform_int_distribution<int> dist {-9, 9};
+  std::bernoulli_distribution nonzero {0.1};
+  xmaho::std_ext::valmatrix<T> m(row_size, col_size);
+  for (auto& e : m)
+    if (nonzero(rand))
+      e = static_cast<T>(dist(rand));
+  return m;
+}
+
+}
+
+template<typename T>
+class SparseMatrixTest
+  : public ::testing::Test
+{
+};
+
+using SparseMatrixTypes = ::testing::Types<xmaho::std_ext::csr_matrix<int>, xmaho::std_ext::csc_matrix<int>,
+                                           xmaho::std_ext::csr_matrix<double>, xmaho::std_ext::csc_matrix<double>>;
+TYPED_TEST_CASE(SparseMatrixTest, SparseMatrixTypes);
+
+TEST(SparseMatrixExampleTest, DocumentExample)
+{
+  xmaho::std_ext::valmatrix<double> dense(3, 3);
+  dense[4] = 2.;
+  const xmaho::std_ext::csr_matrix<double> sparse {dense};
+  EXPECT_EQ(1u, sparse.nonzero_size());
+  const auto y {matmul(sparse, std::valarray<double>(1., 3))};
+  ASSERT_EQ(3u, y.size());
+  EXPECT_EQ(0., y[0]);
+  EXPECT_EQ(2., y[1]);
+  EXPECT_EQ(0., y[2]);
+}
+
+TYPED_TEST(SparseMatrixTest, ConvertValmatrix)
+{
+  using value_type = typename TypeParam::value_type;
+  const auto dense {make_sparse_dense<value_type>(23, 17)};
+  const TypeParam sparse {dense};
+  ASSERT_EQ(dense.row_size(), sparse.row_size());
+  ASSERT_EQ(dense.col_size(), sparse.col_size());
+  std::size_t nonzero {0};
+  for (std::size_t y {0}; y < dense.col_size(); ++y)
+    for (std::size_t x {0}; x < dense.row_size(); ++x) {
+      const auto value {dense[y * dense.row_size() + x]};
+      EXPECT_EQ(value, (sparse[{x, y}]));
+      if (!std::equal_to<>{}(value, value_type{}))
+        ++nonzero;
+    }
+  EXPECT_EQ(nonzero, sparse.nonzero_size());
+  const auto back {to_valmatrix(sparse)};
+  for (std::size_t i {0}; i < dense.size(); ++i)
+    EXPECT_EQ(dense[i], back[i]);
+}
+
+TYPED_TEST(SparseMatrixTest, ConstructByEntries)
+{
+  using value_type = typename TypeParam::value_type;
+  const TypeParam sparse {{{{2, 0}, value_type{1}}, {{0, 1}, value_type{3}}, {{2, 0}, value_type{4}}, {{1, 1}, value_type{0}}}, 3, 2};
+  EXPECT_EQ(2u, sparse.nonzero_size());
+  EXPECT_EQ(value_type{5}, (sparse[{2, 0}]));
+  EXPECT_EQ(value_type{3}, (sparse[{0, 1}]));
+  EXPECT_EQ(value_type{0}, (sparse[{1, 1}]));
+}
+
+TYPED_TEST(SparseMatrixTest, ConvertMajor)
+{
+  using value_type = typename TypeParam::value_type;
+  constexpr auto other_major {TypeParam::major == xmaho::std_ext::sparse_major::row ? xmaho::std_ext::sparse_major::column : xmaho::std_ext::sparse_major::row};
+  const auto dense {make_sparse_dense<value_type>(19, 31)};
+  const TypeParam sparse {dense};
+  const xmaho::std_ext::sparse_matrix<value_type, other_major> converted {sparse};
+  EXPECT_EQ(sparse.nonzero_size(), converted.nonzero_size());
+  const auto back {to_valmatrix(converted)};
+  for (std::size_t i {0}; i < dense.size(); ++i)
+    EXPECT_EQ(dense[i], back[i]);
+}
+
+TYPED_TEST(SparseMatrixTest, Product)
+{
+  using value_type = typename TypeParam::value_type;
+  const auto a {make_sparse_dense<value_type>(40, 30)};
+  const auto b {make_sparse_dense<value_type>(20, 40)};
+  const auto c {make_sparse_dense<value_type>(30, 25)};
+  const TypeParam sparse {a};
+
+  std::valarray<value_type> x(a.row_size());
+  for (std::size_t i {0}; i < x.size(); ++i)
+    x[i] = static_cast<value_type>(i % 7);
+  const auto y {matmul(sparse, x)};
+  const auto expected_y {xmaho::std_ext::matmul(a, xmaho::std_ext::valmatrix<value_type> {x, 1, x.size()})};
+  ASSERT_EQ(expected_y.size(), y.size());
+  for (std::size_t i {0}; i < y.size(); ++i)
+    EXPECT_EQ(expected_y[i], y[i]);
+
+  const auto ab {matmul(sparse, b)};
+  const auto expected_ab {xmaho::std_ext::matmul(a, b)};
+  ASSERT_EQ(expected_ab.size(), ab.size());
+  for (std::size_t i {0}; i < ab.size(); ++i)
+    EXPECT_EQ(expected_ab[i], ab[i]);
+
+  const auto ca {matmul(c, sparse)};
+  const auto expected_ca {xmaho::std_ext::matmul(c, a)};
+  ASSERT_EQ(expected_ca.size(), ca.size());
+  for (std::size_t i {0}; i < ca.size(); ++i)
+    EXPECT_EQ(expected_ca[i], ca[i]);
+}
+
+TYPED_TEST(SparseMatrixTest, ElementwiseOperation)
+{
+  using value_type = typename TypeParam::value_type;
+  const auto a {make_sparse_dense<value_type>(21, 13)};
+  const auto b {make_sparse_dense<value_type>(21, 13)};
+  const TypeParam sa {a};
+  const TypeParam sb {b};
+  const auto sum {to_valmatrix(sa + sb)};
+  const auto difference {to_valmatrix(sa - sb)};
+  const auto product {to_valmatrix(sa * sb)};
+  const auto dense_product {to_valmatrix(sa * b)};
+  const auto scaled {to_valmatrix(value_type{2} * sa / value_type{2} * value_type{3})};
+  const auto negative {to_valmatrix(-sa)};
+  auto accumulated {b};
+  accumulated += sa;
+  accumulated -= sb;
+  for (std::size_t i {0}; i < a.size(); ++i) {
+    EXPECT_EQ(a[i] + b[i], sum[i]);
+    EXPECT_EQ(a[i] - b[i], difference[i]);
+    EXPECT_EQ(a[i] * b[i], product[i]);
+    EXPECT_EQ(a[i] * b[i], dense_product[i]);
+    EXPECT_EQ(a[i] * value_type{3}, scaled[i]);
+    EXPECT_EQ(-a[i], negative[i]);
+    EXPECT_EQ(a[i], accumulated[i]);
+  }
+  EXPECT_EQ(0u, (sa - sa).nonzero_size());
+}
+
+TYPED_TEST(SparseMatrixTest, ScaleToZero)
+{
+  using value_type = typename TypeParam::value_type;
+  const auto a {make_sparse_dense<value_type>(21, 13)};
+  TypeParam sa {a};
+  sa *= value_type{0};
+  EXPECT_EQ(0u, sa.nonzero_size());
+  EXPECT_EQ(std::vector<std::size_t>(sa.outer_index().size(), 0), sa.outer_index());
+  EXPECT_EQ(a.size(), to_valmatrix(sa).size());
+}
+
+TEST(SparseMatrixIntegralTest, DivisionErasesZeros)
+{
+  const xmaho::std_ext::csr_matrix<int> sparse {{{{0, 0}, 1}, {{2, 0}, 4}, {{1, 1}, 1}, {{2, 1}, 6}}, 3, 2};
+  const auto divided {sparse / 2};
+  EXPECT_EQ(2u, divided.nonzero_size());
+  EXPECT_EQ(0, (divided[{0, 0}]));
+  EXPECT_EQ(2, (divided[{2, 0}]));
+  EXPECT_EQ(0, (divided[{1, 1}]));
+  EXPECT_EQ(3, (divided[{2, 1}]));
+}
+
+TEST(SparseMatrixEmptyTest, Empty)
+{
+  const xmaho::std_ext::csr_matrix<int> sparse {};
+  EXPECT_EQ(0u, sparse.row_size());
+  EXPECT_EQ(0u, sparse.col_size());
+  EXPECT_EQ(0u, sparse.nonzero_size());
+  EXPECT_FALSE(to_valmatrix(sparse).size());
+}
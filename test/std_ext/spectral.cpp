@@ -0,0 +1,202 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/spectral.hpp"
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using position = std::pair<std::size_t, std::size_t>;
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> random_matrix(std::size_t rows, std::size_t cols, unsigned seed)
+{
+  std::mt19937 engine {seed};
+  std::uniform_real_distribution<T> distribution {-1, 1};
+  xmaho::std_ext::valmatrix<T> m {cols, rows};
+  for (auto& e : m)
+    e = distribution(engine);
+  return m;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> random_symmetric(std::size_t n, unsigned seed)
+{
+  auto m {random_matrix<T>(n, n, seed)};
+  for (std::size_t i {0}; i < n; ++i)
+    for (std::size_t j {0}; j < i; ++j)
+      m[position(i, j)] = m[position(j, i)];
+  return m;
+}
+
+template<typename T>
+T column_dot(const xmaho::std_ext::valmatrix<T>& a, std::size_t i, const xmaho::std_ext::valmatrix<T>& b, std::size_t j)
+{
+  T result {};
+  for (std::size_t r {0}; r < a.col_size(); ++r)
+    result += a[position(i, r)] * b[position(j, r)];
+  return result;
+}
+
+}
+
+template<typename T>
+class SpectralTest
+  : public ::testing::Test
+{
+protected:
+  static constexpr T tolerance {std::is_same_v<T, float> ? static_cast<T>(1e-4) : static_cast<T>(1e-10)};
+
+  void expect_orthonormal_columns(const xmaho::std_ext::valmatrix<T>& m)
+  {
+    for (std::size_t i {0}; i < m.row_size(); ++i)
+      for (std::size_t j {0}; j < m.row_size(); ++j)
+        EXPECT_NEAR(i == j ? T{1} : T{}, column_dot(m, i, m, j), tolerance);
+  }
+
+  void expect_eigen(const xmaho::std_ext::valmatrix<T>& a, const xmaho::std_ext::symmetric_eigen_decomposition<T>& eigen)
+  {
+    const auto n {a.row_size()};
+    ASSERT_EQ(n, eigen.order());
+    const auto& w {eigen.eigenvalues()};
+    const auto& v {eigen.eigenvectors()};
+    for (std::size_t i {1}; i < n; ++i)
+      EXPECT_LE(w[i - 1], w[i]);
+    expect_orthonormal_columns(v);
+    for (std::size_t c {0}; c < n; ++c)
+      for (std::size_t r {0}; r < n; ++r) {
+        T product {};
+        for (std::size_t k {0}; k < n; ++k)
+          product += a[position(k, r)] * v[position(c, k)];
+        EXPECT_NEAR(w[c] * v[position(c, r)], product, tolerance * static_cast<T>(n));
+      }
+  }
+
+  void expect_svd(const xmaho::std_ext::valmatrix<T>& a, const xmaho::std_ext::singular_value_decomposition<T>& svd, bool full_rank)
+  {
+    const auto rows {a.col_size()};
+    const auto cols {a.row_size()};
+    const auto k {std::min(rows, cols)};
+    ASSERT_EQ(k, svd.rank_size());
+    ASSERT_EQ(k, svd.u().row_size());
+    ASSERT_EQ(rows, svd.u().col_size());
+    ASSERT_EQ(k, svd.v().row_size());
+    ASSERT_EQ(cols, svd.v().col_size());
+    const auto& s {svd.singular_values()};
+    for (std::size_t i {1}; i < k; ++i)
+      EXPECT_GE(s[i - 1], s[i]);
+    if (full_rank) {
+      expect_orthonormal_columns(svd.u());
+      expect_orthonormal_columns(svd.v());
+    }
+    for (std::size_t r {0}; r < rows; ++r)
+      for (std::size_t c {0}; c < cols; ++c) {
+        T value {};
+        for (std::size_t i {0}; i < k; ++i)
+          value += svd.u()[position(i, r)] * s[i] * svd.v()[position(i, c)];
+        EXPECT_NEAR(a[position(c, r)], value, tolerance * static_cast<T>(k));
+      }
+  }
+};
+
+using SpectralTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(SpectralTest, SpectralTypes);
+
+TYPED_TEST(SpectralTest, Eigen)
+{
+  const auto a {random_symmetric<TypeParam>(31, 1)};
+  const xmaho::std_ext::symmetric_eigen_decomposition<TypeParam> eigen {a};
+  this->expect_eigen(a, eigen);
+}
+
+TYPED_TEST(SpectralTest, EigenKnown)
+{
+  const xmaho::std_ext::valmatrix<TypeParam> a {{2, 1, 0, 1, 2, 0, 0, 0, 5}, 3, 3};
+  const xmaho::std_ext::symmetric_eigen_decomposition<TypeParam> eigen {a};
+  EXPECT_NEAR(1, eigen.eigenvalues()[0], TestFixture::tolerance);
+  EXPECT_NEAR(3, eigen.eigenvalues()[1], TestFixture::tolerance);
+  EXPECT_NEAR(5, eigen.eigenvalues()[2], TestFixture::tolerance);
+  this->expect_eigen(a, eigen);
+}
+
+TYPED_TEST(SpectralTest, EigenReuse)
+{
+  xmaho::std_ext::symmetric_eigen_decomposition<TypeParam> eigen {};
+  EXPECT_EQ(0u, eigen.order());
+  for (const std::size_t n : {1u, 12u, 12u, 5u}) {
+    const auto a {random_symmetric<TypeParam>(n, static_cast<unsigned>(n) + 2)};
+    eigen.compute(a);
+    this->expect_eigen(a, eigen);
+  }
+  const auto identity {xmaho::std_ext::valmatrix<TypeParam> {{1, 0, 0, 1}, 2, 2}};
+  eigen.compute(identity);
+  this->expect_eigen(identity, eigen);
+}
+
+TYPED_TEST(SpectralTest, SvdTall)
+{
+  const auto a {random_matrix<TypeParam>(40, 25, 3)};
+  const xmaho::std_ext::singular_value_decomposition<TypeParam> svd {a};
+  this->expect_svd(a, svd, true);
+}
+
+TYPED_TEST(SpectralTest, SvdWide)
+{
+  const auto a {random_matrix<TypeParam>(25, 40, 4)};
+  const xmaho::std_ext::singular_value_decomposition<TypeParam> svd {a};
+  this->expect_svd(a, svd, true);
+}
+
+TYPED_TEST(SpectralTest, SvdKnown)
+{
+  const xmaho::std_ext::valmatrix<TypeParam> a {{3, 0, 0, -4, 0, 0}, 2, 3}; // 3 rows, 2 columns
+  const xmaho::std_ext::singular_value_decomposition<TypeParam> svd {a};
+  EXPECT_NEAR(4, svd.singular_values()[0], TestFixture::tolerance);
+  EXPECT_NEAR(3, svd.singular_values()[1], TestFixture::tolerance);
+  this->expect_svd(a, svd, true);
+}
+
+TYPED_TEST(SpectralTest, SvdRankDeficient)
+{
+  auto a {random_matrix<TypeParam>(20, 6, 5)};
+  for (std::size_t r {0}; r < a.col_size(); ++r)
+    a[position(5, r)] = a[position(0, r)] + a[position(1, r)];
+  xmaho::std_ext::singular_value_decomposition<TypeParam> svd {};
+  svd.compute(a);
+  EXPECT_NEAR(0, svd.singular_values()[5], TestFixture::tolerance);
+  this->expect_svd(a, svd, false);
+  svd.compute(xmaho::std_ext::valmatrix<TypeParam> {});
+  EXPECT_EQ(0u, svd.rank_size());
+}
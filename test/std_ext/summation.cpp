@@ -0,0 +1,96 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/summation.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <valarray>
+
+#include <gtest/gtest.h>
+
+template<typename T>
+class SummationTest
+  : public ::testing::Test
+{
+protected:
+  static constexpr xmaho::std_ext::summation_method methods[] {xmaho::std_ext::summation_method::naive, xmaho::std_ext::summation_method::pairwise, xmaho::std_ext::summation_method::kahan};
+};
+
+using SummationTypes = ::testing::Types<int, float, double>;
+TYPED_TEST_CASE(SummationTest, SummationTypes);
+
+TYPED_TEST(SummationTest, Exact)
+{
+  std::valarray<TypeParam> v(1000);
+  for (std::size_t i {0}; i < v.size(); ++i)
+    v[i] = static_cast<TypeParam>(i % 17);
+  const xmaho::std_ext::valmatrix<TypeParam> m {v, 40, 25};
+  const std::valarray<TypeParam> ones(1, v.size());
+  xmaho::std_ext::parallel_context context {4, 1};
+  for (const auto method : TestFixture::methods) {
+    EXPECT_EQ(v.sum(), xmaho::std_ext::sum(v, method));
+    EXPECT_EQ(v.sum(), xmaho::std_ext::sum(m, method));
+    EXPECT_EQ(v.sum(), xmaho::std_ext::sum(context, v, method));
+    EXPECT_EQ(v.sum(), xmaho::std_ext::sum(context, m, method));
+    EXPECT_EQ(v.sum(), xmaho::std_ext::inner_product(v, ones, method));
+    EXPECT_EQ(v.sum(), xmaho::std_ext::inner_product(context, v, ones, method));
+  }
+}
+
+TYPED_TEST(SummationTest, Empty)
+{
+  const std::valarray<TypeParam> v {};
+  xmaho::std_ext::parallel_context context {2, 1};
+  for (const auto method : TestFixture::methods) {
+    EXPECT_EQ(TypeParam{}, xmaho::std_ext::sum(v, method));
+    EXPECT_EQ(TypeParam{}, xmaho::std_ext::sum(context, v, method));
+  }
+}
+
+TEST(SummationTest, Accuracy)
+{
+  const std::size_t size {1u << 22};
+  const std::valarray<float> v(0.1f, size);
+  const auto correct {static_cast<double>(0.1f) * size};
+  const auto error {[correct](float value) {return std::abs(static_cast<double>(value) - correct) / correct;}};
+  xmaho::std_ext::parallel_context context {4, 1};
+  EXPECT_GT(error(xmaho::std_ext::sum(v, xmaho::std_ext::summation_method::naive)), 1e-3);
+  EXPECT_LT(error(xmaho::std_ext::sum(v, xmaho::std_ext::summation_method::pairwise)), 1e-6);
+  EXPECT_LT(error(xmaho::std_ext::sum(v, xmaho::std_ext::summation_method::kahan)), 1e-7);
+  EXPECT_LT(error(xmaho::std_ext::sum(context, v, xmaho::std_ext::summation_method::pairwise)), 1e-6);
+  EXPECT_LT(error(xmaho::std_ext::sum(context, v, xmaho::std_ext::summation_method::kahan)), 1e-7);
+  EXPECT_LT(error(xmaho::std_ext::inner_product(v, v, xmaho::std_ext::summation_method::kahan) / 0.1f), 1e-6);
+}
+
+TEST(SummationTest, Cancellation)
+{
+  const std::valarray<double> v {1e16, 1.0, 1.0, -1e16};
+  EXPECT_EQ(0.0, xmaho::std_ext::sum(v, xmaho::std_ext::summation_method::naive));
+  EXPECT_EQ(2.0, xmaho::std_ext::sum(v, xmaho::std_ext::summation_method::kahan));
+}
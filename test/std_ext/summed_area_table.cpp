@@ -0,0 +1,100 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/summed_area_table.hpp"
+
+#include <cstddef>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+template<typename T>
+class SummedAreaTableTest
+  : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    matrix = xmaho::std_ext::valmatrix<T> {5, 4};
+    for (std::size_t i {0}; i < matrix.size(); ++i)
+      matrix[i] = static_cast<T>(i % 7 + 1);
+  }
+
+  xmaho::std_ext::valmatrix<T> matrix;
+};
+
+using SummedAreaTableTypes = ::testing::Types<int, long long, double>;
+TYPED_TEST_CASE(SummedAreaTableTest, SummedAreaTableTypes);
+
+TYPED_TEST(SummedAreaTableTest, Construct)
+{
+  const xmaho::std_ext::summed_area_table<TypeParam> table {this->matrix};
+  EXPECT_EQ(this->matrix.row_size(), table.row_size());
+  EXPECT_EQ(this->matrix.col_size(), table.col_size());
+  EXPECT_EQ(this->matrix.row_size() + 1, table.table().row_size());
+  EXPECT_EQ(this->matrix.col_size() + 1, table.table().col_size());
+  EXPECT_EQ(this->matrix.sum(), table.sum());
+}
+
+TYPED_TEST(SummedAreaTableTest, BlockSum)
+{
+  using position_type = typename xmaho::std_ext::summed_area_table<TypeParam>::position_type;
+  const xmaho::std_ext::summed_area_table<TypeParam> table {this->matrix};
+  for (std::size_t x {0}; x < this->matrix.row_size(); ++x)
+    for (std::size_t y {0}; y < this->matrix.col_size(); ++y)
+      for (std::size_t w {1}; x + w <= this->matrix.row_size(); ++w)
+        for (std::size_t h {1}; y + h <= this->matrix.col_size(); ++h) {
+          const position_type pos {x, y};
+          const position_type size {w, h};
+          EXPECT_EQ(this->matrix.block(pos, size).sum(), table.sum(pos, size));
+        }
+}
+
+TYPED_TEST(SummedAreaTableTest, EmptyBlock)
+{
+  using position_type = typename xmaho::std_ext::summed_area_table<TypeParam>::position_type;
+  const xmaho::std_ext::summed_area_table<TypeParam> table {this->matrix};
+  const position_type pos {2, 1};
+  const position_type zero_width {0, 3};
+  const position_type zero_height {2, 0};
+  EXPECT_EQ(TypeParam{}, table.sum(pos, zero_width));
+  EXPECT_EQ(TypeParam{}, table.sum(pos, zero_height));
+}
+
+TYPED_TEST(SummedAreaTableTest, Update)
+{
+  using position_type = typename xmaho::std_ext::summed_area_table<TypeParam>::position_type;
+  xmaho::std_ext::summed_area_table<TypeParam> table {this->matrix};
+  this->matrix[position_type{1, 2}] = TypeParam{20};
+  this->matrix[position_type{3, 3}] = TypeParam{30};
+  table.update(this->matrix, 2);
+  const xmaho::std_ext::summed_area_table<TypeParam> rebuilt {this->matrix};
+  for (std::size_t i {0}; i < rebuilt.table().size(); ++i)
+    EXPECT_EQ(rebuilt.table()[i], table.table()[i]);
+  EXPECT_EQ(this->matrix.sum(), table.sum());
+}
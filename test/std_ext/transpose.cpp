@@ -0,0 +1,112 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/transpose.hpp"
+
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_sequence_matrix(std::size_t row_size, std::size_t col_size)
+{
+  xmaho::std_ext::valmatrix<T> m(row_size, col_size);
+  for (std::size_t i {0}; i < m.size(); ++i)
+    m[i] = static_cast<T>(i);
+  return m;
+}
+
+template<typename T>
+void expect_transposed(const xmaho::std_ext::valmatrix<T>& m, const xmaho::std_ext::valmatrix<T>& t)
+{
+  ASSERT_EQ(m.row_size(), t.col_size());
+  ASSERT_EQ(m.col_size(), t.row_size());
+  for (std::size_t i {0}; i < m.col_size(); ++i)
+    for (std::size_t j {0}; j < m.row_size(); ++j)
+      EXPECT_EQ(m[i * m.row_size() + j], t[j * t.row_size() + i]);
+}
+
+}
+
+template<typename T>
+class TransposeTest
+  : public ::testing::Test
+{
+};
+
+using TransposeTypes = ::testing::Types<int, double>;
+TYPED_TEST_CASE(TransposeTest, TransposeTypes);
+
+TEST(TransposeExampleTest, DocumentExample)
+{
+  const xmaho::std_ext::valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2};
+  const auto t {xmaho::std_ext::transpose(m)};
+  ASSERT_EQ(2u, t.row_size());
+  ASSERT_EQ(3u, t.col_size());
+  const int expected[] {1, 4, 2, 5, 3, 6};
+  for (std::size_t i {0}; i < t.size(); ++i)
+    EXPECT_EQ(expected[i], t[i]);
+}
+
+TYPED_TEST(TransposeTest, OutOfPlace)
+{
+  for (const auto& [row_size, col_size] : {std::pair<std::size_t, std::size_t> {1, 1}, {7, 3}, {33, 32}, {100, 65}, {1, 200}}) {
+    const auto m {make_sequence_matrix<TypeParam>(row_size, col_size)};
+    expect_transposed(m, xmaho::std_ext::transpose(m));
+  }
+}
+
+TYPED_TEST(TransposeTest, InPlaceSquare)
+{
+  for (const std::size_t n : {1u, 5u, 32u, 33u, 129u}) {
+    const auto m {make_sequence_matrix<TypeParam>(n, n)};
+    auto t {m};
+    xmaho::std_ext::transpose_in_place(t);
+    expect_transposed(m, t);
+  }
+}
+
+TYPED_TEST(TransposeTest, InPlaceRectangular)
+{
+  for (const auto& [row_size, col_size] : {std::pair<std::size_t, std::size_t> {2, 1}, {7, 3}, {40, 90}, {1, 17}}) {
+    const auto m {make_sequence_matrix<TypeParam>(row_size, col_size)};
+    auto t {m};
+    xmaho::std_ext::transpose_in_place(t);
+    expect_transposed(m, t);
+  }
+}
+
+TEST(TransposeEmptyTest, Empty)
+{
+  xmaho::std_ext::valmatrix<int> m {};
+  EXPECT_FALSE(xmaho::std_ext::transpose(m).size());
+  EXPECT_FALSE(xmaho::std_ext::transpose_in_place(m).size());
+}
@@ -0,0 +1,168 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/transposed.hpp"
+
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> make_sequence_matrix(std::size_t row_size, std::size_t col_size)
+{
+  xmaho::std_ext::valmatrix<T> m(row_size, col_size);
+  for (std::size_t i {0}; i < m.size(); ++i)
+    m[i] = static_cast<T>(i % 13 + 1);
+  return m;
+}
+
+template<typename T>
+T at(const xmaho::std_ext::valmatrix<T>& m, std::size_t i, std::size_t j)
+{
+  return m[i * m.row_size() + j];
+}
+
+}
+
+template<typename T>
+class TransposedTest
+  : public ::testing::Test
+{
+};
+
+using TransposedTypes = ::testing::Types<int, double>;
+TYPED_TEST_CASE(TransposedTest, TransposedTypes);
+
+TYPED_TEST(TransposedTest, Access)
+{
+  const auto m {make_sequence_matrix<TypeParam>(5, 3)};
+  const auto t {xmaho::std_ext::transposed(m)};
+  ASSERT_EQ(3u, t.row_size());
+  ASSERT_EQ(5u, t.col_size());
+  ASSERT_EQ(m.size(), t.size());
+  for (std::size_t i {0}; i < t.col_size(); ++i)
+    for (std::size_t j {0}; j < t.row_size(); ++j) {
+      EXPECT_EQ(at(m, j, i), (t[{j, i}]));
+      EXPECT_EQ(at(m, j, i), t[i * t.row_size() + j]);
+    }
+  EXPECT_EQ(&m, &xmaho::std_ext::transposed(t));
+  EXPECT_EQ(m.sum(), t.sum());
+  EXPECT_EQ(m.min(), t.min());
+  EXPECT_EQ(m.max(), t.max());
+  const auto copy {xmaho::std_ext::to_valmatrix(t)};
+  for (std::size_t i {0}; i < t.size(); ++i)
+    EXPECT_EQ(t[i], copy[i]);
+}
+
+TYPED_TEST(TransposedTest, Matmul)
+{
+  const auto a {make_sequence_matrix<TypeParam>(40, 70)};
+  const auto b {make_sequence_matrix<TypeParam>(30, 70)};
+  const auto at_copy {xmaho::std_ext::to_valmatrix(xmaho::std_ext::transposed(a))};
+  const auto bt_copy {xmaho::std_ext::to_valmatrix(xmaho::std_ext::transposed(b))};
+  const auto atb {xmaho::std_ext::matmul(xmaho::std_ext::transposed(a), b)};
+  const auto expected_atb {xmaho::std_ext::matmul(at_copy, b)};
+  ASSERT_EQ(expected_atb.size(), atb.size());
+  for (std::size_t i {0}; i < atb.size(); ++i)
+    EXPECT_EQ(expected_atb[i], atb[i]);
+  const auto abt {xmaho::std_ext::matmul(at_copy, xmaho::std_ext::transposed(bt_copy))};
+  for (std::size_t i {0}; i < abt.size(); ++i)
+    EXPECT_EQ(expected_atb[i], abt[i]);
+  const auto btta {xmaho::std_ext::matmul(xmaho::std_ext::transposed(b), xmaho::std_ext::transposed(at_copy))};
+  const auto expected_btta {xmaho::std_ext::matmul(bt_copy, a)};
+  ASSERT_EQ(expected_btta.size(), btta.size());
+  for (std::size_t i {0}; i < btta.size(); ++i)
+    EXPECT_EQ(expected_btta[i], btta[i]);
+}
+
+TYPED_TEST(TransposedTest, CompoundAssign)
+{
+  const auto m {make_sequence_matrix<TypeParam>(50, 37)};
+  auto result {make_sequence_matrix<TypeParam>(37, 50)};
+  const auto original {result};
+  result += xmaho::std_ext::transposed(m);
+  result *= xmaho::std_ext::transposed(m);
+  for (std::size_t i {0}; i < result.col_size(); ++i)
+    for (std::size_t j {0}; j < result.row_size(); ++j)
+      EXPECT_EQ((at(original, i, j) + at(m, j, i)) * at(m, j, i), at(result, i, j));
+}
+
+TYPED_TEST(TransposedTest, CompoundAssignSelf)
+{
+  auto m {make_sequence_matrix<TypeParam>(40, 40)};
+  const auto original {m};
+  m -= xmaho::std_ext::transposed(m);
+  for (std::size_t i {0}; i < m.col_size(); ++i)
+    for (std::size_t j {0}; j < m.row_size(); ++j)
+      EXPECT_EQ(at(original, i, j) - at(original, j, i), at(m, i, j));
+}
+
+TYPED_TEST(TransposedTest, LazyExpression)
+{
+  const auto m {make_sequence_matrix<TypeParam>(45, 33)};
+  const auto n {make_sequence_matrix<TypeParam>(33, 45)};
+  const xmaho::std_ext::valmatrix<TypeParam> result {lazy(n) + lazy(xmaho::std_ext::transposed(m)) * TypeParam{2}};
+  ASSERT_EQ(n.row_size(), result.row_size());
+  ASSERT_EQ(n.col_size(), result.col_size());
+  for (std::size_t i {0}; i < result.col_size(); ++i)
+    for (std::size_t j {0}; j < result.row_size(); ++j)
+      EXPECT_EQ(at(n, i, j) + at(m, j, i) * TypeParam{2}, at(result, i, j));
+  xmaho::std_ext::valmatrix<TypeParam> difference(n.row_size(), n.col_size());
+  difference = lazy(n) - xmaho::std_ext::transposed(m);
+  for (std::size_t i {0}; i < difference.col_size(); ++i)
+    for (std::size_t j {0}; j < difference.row_size(); ++j)
+      EXPECT_EQ(at(n, i, j) - at(m, j, i), at(difference, i, j));
+  const auto expression {-xmaho::std_ext::lazy(xmaho::std_ext::transposed(m))};
+  for (std::size_t i {0}; i < expression.size(); ++i)
+    EXPECT_EQ(-xmaho::std_ext::transposed(m)[i], expression[i]);
+}
+
+TYPED_TEST(TransposedTest, LazyExpressionSelf)
+{
+  auto m {make_sequence_matrix<TypeParam>(40, 40)};
+  const auto original {m};
+  m = xmaho::std_ext::lazy(xmaho::std_ext::transposed(m)) * TypeParam{1} + lazy(original);
+  for (std::size_t i {0}; i < m.col_size(); ++i)
+    for (std::size_t j {0}; j < m.row_size(); ++j)
+      EXPECT_EQ(at(original, j, i) + at(original, i, j), at(m, i, j));
+}
+
+TEST(TransposedIntegralTest, BitwiseAssign)
+{
+  const auto m {make_sequence_matrix<unsigned>(3, 4)};
+  auto result {make_sequence_matrix<unsigned>(4, 3)};
+  const auto original {result};
+  result ^= xmaho::std_ext::transposed(m);
+  result <<= xmaho::std_ext::transposed(m);
+  for (std::size_t i {0}; i < result.col_size(); ++i)
+    for (std::size_t j {0}; j < result.row_size(); ++j)
+      EXPECT_EQ((at(original, i, j) ^ at(m, j, i)) << at(m, j, i), at(result, i, j));
+}
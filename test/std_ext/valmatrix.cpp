@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "xmaho/std_ext/valmatrix.hpp"
 
 #include <algorithm>
+#include <complex>
 #include <cstddef>
 #include <numeric>
 #include <random>
@@ -217,7 +218,7 @@ TYPED_TEST(ValmatrixTest, ReadValueByPosition)
   for (auto i {0u}; i < TestFixture::size.first; ++i)
     for (auto j {0u}; j < TestFixture::size.second; ++j) {
       const auto value {this->iota_matrix_[typename TestFixture::Valmatrix::position_type{i, j}]};
-      EXPECT_EQ(this->iota_array_[j * TestFixture::size.second + i], value);
+      EXPECT_EQ(this->iota_array_[j * TestFixture::size.first + i], value);
     }
 }
 
@@ -1071,6 +1072,32 @@ TYPED_TEST(ValmatrixTest, ValueInverseCounterShiftOperator)
   }
 }
 
+TYPED_TEST(ValmatrixTest, TemporaryInverseOperator)
+{
+  const auto check = [this](auto op) {
+    const auto array_correct {op(this->operation_array_, this->iota_matrix_)};
+    auto array_temporary {this->iota_matrix_};
+    const auto array_data {array_temporary.data()};
+    const auto array_result {op(this->operation_array_, std::move(array_temporary))};
+    EXPECT_EQ(array_data, array_result.data());
+    EXPECT_EQ(as_validator(array_correct), as_validator(array_result));
+
+    const auto value_correct {op(this->operation_value_, this->iota_matrix_)};
+    auto value_temporary {this->iota_matrix_};
+    const auto value_data {value_temporary.data()};
+    const auto value_result {op(this->operation_value_, std::move(value_temporary))};
+    EXPECT_EQ(value_data, value_result.data());
+    EXPECT_EQ(as_validator(value_correct), as_validator(value_result));
+  };
+  check([](const auto& lhs, auto&& rhs){return lhs - std::forward<decltype(rhs)>(rhs);});
+  check([](const auto& lhs, auto&& rhs){return lhs / std::forward<decltype(rhs)>(rhs);});
+  if constexpr (!std::is_floating_point_v<TypeParam>) {
+    check([](const auto& lhs, auto&& rhs){return lhs % std::forward<decltype(rhs)>(rhs);});
+    check([](const auto& lhs, auto&& rhs){return lhs << std::forward<decltype(rhs)>(rhs);});
+    check([](const auto& lhs, auto&& rhs){return lhs >> std::forward<decltype(rhs)>(rhs);});
+  }
+}
+
 TYPED_TEST(ValmatrixTest, ReadRow)
 {
   for (auto i {0u}; i < TestFixture::size.second; ++i) {
@@ -1178,6 +1205,85 @@ TYPED_TEST(ValmatrixTest, VoidSwap)
   EXPECT_FALSE(swap_target.size());
 }
 
+TYPED_TEST(ValmatrixTest, Reshape)
+{
+  const auto row_size {this->iota_matrix_.row_size()};
+  const auto col_size {this->iota_matrix_.col_size()};
+  this->iota_matrix_.reshape(col_size, row_size);
+
+  EXPECT_EQ(col_size, this->iota_matrix_.row_size());
+  EXPECT_EQ(row_size, this->iota_matrix_.col_size());
+  for (auto i {0u}; i < size_of(TestFixture::size); ++i)
+    EXPECT_EQ(this->iota_matrix_[i], this->iota_array_[i]);
+}
+
+TYPED_TEST(ValmatrixTest, ColumnMajorLayout)
+{
+  using Position = typename TestFixture::Valmatrix::position_type;
+  const xmaho::std_ext::valmatrix<TypeParam, xmaho::std_ext::column_major> column {this->iota_matrix_};
+  EXPECT_EQ(this->iota_matrix_.row_size(), column.row_size());
+  EXPECT_EQ(this->iota_matrix_.col_size(), column.col_size());
+
+  for (auto i {0u}; i < TestFixture::size.first; ++i)
+    for (auto j {0u}; j < TestFixture::size.second; ++j) {
+      const Position position {i, j};
+      EXPECT_EQ(this->iota_matrix_[position], column[position]);
+      EXPECT_EQ(this->iota_array_[j * TestFixture::size.first + i], column[i * TestFixture::size.second + j]);
+    }
+
+  const auto& row_major {this->iota_matrix_};
+  for (auto i {0u}; i < TestFixture::size.second; ++i)
+    EXPECT_EQ(as_validator(row_major.row(i)), as_validator(column.row(i)));
+  for (auto i {0u}; i < TestFixture::size.first; ++i)
+    EXPECT_EQ(as_validator(row_major.col(i)), as_validator(column.col(i)));
+
+  const typename TestFixture::Valmatrix round_trip {column};
+  EXPECT_EQ(as_validator(this->iota_matrix_), as_validator(round_trip));
+}
+
+TYPED_TEST(ValmatrixTest, ColumnMajorWrite)
+{
+  using Position = typename TestFixture::Valmatrix::position_type;
+  xmaho::std_ext::valmatrix<TypeParam, xmaho::std_ext::column_major> column {this->iota_matrix_};
+  constexpr auto new_value {5};
+  column.row(TestFixture::size.second - 1) = new_value;
+  this->iota_matrix_.row(TestFixture::size.second - 1) = new_value;
+  column.col(0) = new_value;
+  this->iota_matrix_.col(0) = new_value;
+  column[Position{1, 0}] = new_value;
+  this->iota_matrix_[Position{1, 0}] = new_value;
+
+  const typename TestFixture::Valmatrix value {column};
+  EXPECT_EQ(as_validator(this->iota_matrix_), as_validator(value));
+}
+
+TYPED_TEST(ValmatrixTest, ColumnMajorBlock)
+{
+  constexpr Size index {1, 0};
+  constexpr Size block_size {2, 2};
+  const xmaho::std_ext::valmatrix<TypeParam, xmaho::std_ext::column_major> column {this->iota_matrix_};
+
+  const auto value {column.block(index, block_size)};
+  const typename TestFixture::Valmatrix correct {this->iota_matrix_.block(index, block_size)};
+  const typename TestFixture::Valmatrix converted {value};
+  EXPECT_EQ(block_size.first, value.row_size());
+  EXPECT_EQ(block_size.second, value.col_size());
+  EXPECT_EQ(as_validator(correct), as_validator(converted));
+}
+
+TYPED_TEST(ValmatrixTest, ColumnMajorOperation)
+{
+  xmaho::std_ext::valmatrix<TypeParam, xmaho::std_ext::column_major> column {this->iota_matrix_};
+  const xmaho::std_ext::valmatrix<TypeParam, xmaho::std_ext::column_major> operation {this->operation_matrix_};
+  column += operation;
+  column = column * operation;
+  this->iota_matrix_ += this->operation_matrix_;
+  this->iota_matrix_ = this->iota_matrix_ * this->operation_matrix_;
+
+  const typename TestFixture::Valmatrix value {column};
+  EXPECT_EQ(as_validator(this->iota_matrix_), as_validator(value));
+}
+
 namespace
 {
 
@@ -1194,3 +1300,64 @@ TEST(ValmatrixUserClassTest, Construct)
   xmaho::std_ext::valmatrix<C>{2, 2};
   xmaho::std_ext::valmatrix<C>{10, 10};
 }
+
+TEST(ValmatrixComplexTest, TemporaryInverseOperator)
+{
+  using value_type = std::complex<double>;
+  xmaho::std_ext::valmatrix<value_type> matrix {3, 2};
+  for (auto i {0u}; i < matrix.size(); ++i)
+    matrix.data()[i] = {i + 1., 2. - i};
+  const std::valarray<value_type> array(value_type{3., -1.}, matrix.size());
+  const value_type value {-2., 5.};
+
+  const auto check = [&](auto op) {
+    const auto array_correct {op(array, matrix)};
+    auto array_temporary {matrix};
+    const auto array_data {array_temporary.data()};
+    const auto array_result {op(array, std::move(array_temporary))};
+    EXPECT_EQ(array_data, array_result.data());
+    EXPECT_EQ(as_validator(array_correct), as_validator(array_result));
+
+    const auto value_correct {op(value, matrix)};
+    auto value_temporary {matrix};
+    const auto value_data {value_temporary.data()};
+    const auto value_result {op(value, std::move(value_temporary))};
+    EXPECT_EQ(value_data, value_result.data());
+    EXPECT_EQ(as_validator(value_correct), as_validator(value_result));
+  };
+  check([](const auto& lhs, auto&& rhs){return lhs - std::forward<decltype(rhs)>(rhs);});
+  check([](const auto& lhs, auto&& rhs){return lhs / std::forward<decltype(rhs)>(rhs);});
+}
+
+template<typename T>
+class ValmatrixFloatingTest
+  : public ::testing::Test
+{
+};
+
+using ValmatrixFloatingTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(ValmatrixFloatingTest, ValmatrixFloatingTypes);
+
+TYPED_TEST(ValmatrixFloatingTest, LongCompoundAssign)
+{
+  constexpr Size size {37, 5};
+  std::default_random_engine rand {std::random_device{}()};
+  std::uniform_real_distribution<TypeParam> dist {1, 2};
+  xmaho::std_ext::valmatrix<TypeParam> matrix {size.first, size.second};
+  xmaho::std_ext::valmatrix<TypeParam> operand {size.first, size.second};
+  for (auto& e : matrix) e = dist(rand);
+  for (auto& e : operand) e = dist(rand);
+  std::valarray<TypeParam> correct(matrix.data(), matrix.size());
+  const std::valarray<TypeParam> operand_array(operand.data(), operand.size());
+  const auto value {dist(rand)};
+
+  matrix += operand;
+  matrix *= value;
+  matrix -= operand_array;
+  matrix /= operand;
+  correct += operand_array;
+  correct *= value;
+  correct -= operand_array;
+  correct /= operand_array;
+  EXPECT_EQ(as_validator(correct), as_validator(matrix));
+}
@@ -0,0 +1,153 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/valmatrix_expression.hpp"
+
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template<typename Container>
+std::vector<typename Container::value_type> as_validator(const Container& container)
+{
+  return std::vector<typename Container::value_type>(std::begin(container), std::end(container));
+}
+
+}
+
+template<typename T>
+class ValmatrixExpressionTest
+  : public ::testing::Test
+{
+protected:
+  using Valmatrix = xmaho::std_ext::valmatrix<T>;
+  using Valarray = std::valarray<T>;
+
+  static constexpr std::size_t row_size {4};
+  static constexpr std::size_t col_size {3};
+
+  Valmatrix a_ {row_size, col_size};
+  Valmatrix b_ {row_size, col_size};
+  Valmatrix c_ {row_size, col_size};
+  Valarray array_ = Valarray(row_size * col_size);
+  T value_ {3};
+
+  void SetUp()
+  {
+    std::default_random_engine rand {std::random_device{}()};
+    std::uniform_int_distribution<int> dist {1, 9};
+    for (auto& e : a_) e = static_cast<T>(dist(rand));
+    for (auto& e : b_) e = static_cast<T>(dist(rand));
+    for (auto& e : c_) e = static_cast<T>(dist(rand));
+    for (auto& e : array_) e = static_cast<T>(dist(rand));
+  }
+};
+
+template<typename T>
+constexpr std::size_t ValmatrixExpressionTest<T>::row_size;
+template<typename T>
+constexpr std::size_t ValmatrixExpressionTest<T>::col_size;
+
+using ValmatrixExpressionTypes = ::testing::Types<int, unsigned int, double>;
+TYPED_TEST_CASE(ValmatrixExpressionTest, ValmatrixExpressionTypes);
+
+TYPED_TEST(ValmatrixExpressionTest, ConstructFromChain)
+{
+  using xmaho::std_ext::lazy;
+  const typename TestFixture::Valmatrix correct {this->a_ + this->b_ * this->c_ - this->b_};
+  const typename TestFixture::Valmatrix result {lazy(this->a_) + lazy(this->b_) * this->c_ - this->b_};
+  EXPECT_EQ(this->a_.row_size(), result.row_size());
+  EXPECT_EQ(this->a_.col_size(), result.col_size());
+  EXPECT_EQ(as_validator(correct), as_validator(result));
+}
+
+TYPED_TEST(ValmatrixExpressionTest, ArrayAndValueOperands)
+{
+  using xmaho::std_ext::lazy;
+  const typename TestFixture::Valmatrix correct {(this->value_ * this->a_ + this->array_) / this->value_};
+  const typename TestFixture::Valmatrix result {(this->value_ * lazy(this->a_) + this->array_) / this->value_};
+  EXPECT_EQ(as_validator(correct), as_validator(result));
+
+  const typename TestFixture::Valmatrix reverse_correct {this->array_ * this->b_ + this->value_};
+  const typename TestFixture::Valmatrix reverse_result {this->array_ * lazy(this->b_) + this->value_};
+  EXPECT_EQ(as_validator(reverse_correct), as_validator(reverse_result));
+}
+
+TYPED_TEST(ValmatrixExpressionTest, AssignReuseAndAlias)
+{
+  using xmaho::std_ext::lazy;
+  const typename TestFixture::Valmatrix correct {this->a_ * this->a_ + this->b_};
+  this->a_ = lazy(this->a_) * this->a_ + this->b_;
+  EXPECT_EQ(as_validator(correct), as_validator(this->a_));
+}
+
+TYPED_TEST(ValmatrixExpressionTest, UnaryOperators)
+{
+  using xmaho::std_ext::lazy;
+  const typename TestFixture::Valmatrix plus {+lazy(this->a_)};
+  EXPECT_EQ(as_validator(this->a_), as_validator(plus));
+  if constexpr (!std::is_unsigned_v<TypeParam>) {
+    const typename TestFixture::Valmatrix correct {-this->a_};
+    const typename TestFixture::Valmatrix result {-lazy(this->a_)};
+    EXPECT_EQ(as_validator(correct), as_validator(result));
+  }
+  if constexpr (std::is_integral_v<TypeParam>) {
+    const typename TestFixture::Valmatrix correct {~this->a_};
+    const typename TestFixture::Valmatrix result {~lazy(this->a_)};
+    EXPECT_EQ(as_validator(correct), as_validator(result));
+  }
+}
+
+TYPED_TEST(ValmatrixExpressionTest, IntegralOperators)
+{
+  if constexpr (std::is_integral_v<TypeParam>) {
+    using xmaho::std_ext::lazy;
+    constexpr TypeParam one {1};
+    const typename TestFixture::Valmatrix correct {(((this->a_ % this->b_) & this->c_) | this->a_) ^ ((this->b_ << one) >> one)};
+    const typename TestFixture::Valmatrix result {(((lazy(this->a_) % this->b_) & this->c_) | this->a_) ^ ((lazy(this->b_) << one) >> one)};
+    EXPECT_EQ(as_validator(correct), as_validator(result));
+  }
+}
+
+TYPED_TEST(ValmatrixExpressionTest, ElementAccess)
+{
+  using xmaho::std_ext::lazy;
+  const auto expression {lazy(this->a_) - this->b_};
+  EXPECT_EQ(this->a_.row_size(), expression.row_size());
+  EXPECT_EQ(this->a_.col_size(), expression.col_size());
+  ASSERT_EQ(this->a_.size(), expression.size());
+  for (std::size_t i {0}; i < expression.size(); ++i)
+    EXPECT_EQ(static_cast<TypeParam>(this->a_[i] - this->b_[i]), expression[i]);
+}
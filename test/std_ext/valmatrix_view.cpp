@@ -0,0 +1,224 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xmaho/std_ext/valmatrix_view.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using Size = std::pair<std::size_t, std::size_t>;
+
+template<typename Container>
+std::vector<std::remove_const_t<typename Container::value_type>> as_validator(const Container& container)
+{
+  return {std::begin(container), std::end(container)};
+}
+
+}
+
+template<typename T>
+class ValmatrixViewTest
+  : public ::testing::Test
+{
+protected:
+  using Valmatrix = xmaho::std_ext::valmatrix<T>;
+  using Valarray = std::valarray<T>;
+
+  static constexpr Size size {4, 3};
+
+  Valmatrix iota_matrix_ {size.first, size.second};
+  Valarray iota_array_ = Valarray(size.first * size.second);
+
+  void SetUp()
+  {
+    std::iota(std::begin(iota_matrix_), std::end(iota_matrix_), 1);
+    std::iota(std::begin(iota_array_), std::end(iota_array_), 1);
+  }
+};
+
+template<typename T>
+constexpr Size ValmatrixViewTest<T>::size;
+
+using ValmatrixViewTypes = ::testing::Types<int, unsigned int, double>;
+TYPED_TEST_CASE(ValmatrixViewTest, ValmatrixViewTypes);
+
+TYPED_TEST(ValmatrixViewTest, ReadRowAndColumn)
+{
+  const auto& m {this->iota_matrix_};
+  for (std::size_t i {0}; i < TestFixture::size.second; ++i)
+    EXPECT_EQ(as_validator(m.row(i)), as_validator(xmaho::std_ext::row_view(m, i)));
+  for (std::size_t i {0}; i < TestFixture::size.first; ++i)
+    EXPECT_EQ(as_validator(m.col(i)), as_validator(xmaho::std_ext::col_view(m, i)));
+}
+
+TYPED_TEST(ValmatrixViewTest, ReadBlock)
+{
+  constexpr Size index {1, 1};
+  constexpr Size block_size {2, 2};
+  const auto& m {this->iota_matrix_};
+  const auto value {xmaho::std_ext::block_view(m, index, block_size)};
+  const std::gslice specification {
+    index.second * TestFixture::size.first + index.first,
+      {block_size.second, block_size.first},
+      {TestFixture::size.first, 1}};
+  const typename TestFixture::Valarray correct {this->iota_array_[specification]};
+  EXPECT_EQ(as_validator(correct), as_validator(value));
+  EXPECT_EQ(correct.sum(), value.sum());
+  EXPECT_EQ(correct.min(), value.min());
+  EXPECT_EQ(correct.max(), value.max());
+  EXPECT_EQ(as_validator(correct), as_validator(xmaho::std_ext::to_valmatrix(value)));
+}
+
+TYPED_TEST(ValmatrixViewTest, WriteBlock)
+{
+  constexpr Size index {2, 1};
+  constexpr Size block_size {2, 2};
+  constexpr TypeParam new_value {7};
+  xmaho::std_ext::block_view(this->iota_matrix_, index, block_size) = new_value;
+  const std::gslice specification {
+    index.second * TestFixture::size.first + index.first,
+      {block_size.second, block_size.first},
+      {TestFixture::size.first, 1}};
+  this->iota_array_[specification] = new_value;
+  EXPECT_EQ(as_validator(this->iota_array_), as_validator(this->iota_matrix_));
+}
+
+TYPED_TEST(ValmatrixViewTest, CompoundAssignBlock)
+{
+  constexpr Size block_size {2, 2};
+  const typename TestFixture::Valmatrix operand {TypeParam{2}, block_size.first, block_size.second};
+  auto block {xmaho::std_ext::block_view(this->iota_matrix_, {0, 1}, block_size)};
+  block += operand;
+  block *= TypeParam{3};
+  block -= xmaho::std_ext::block_view(this->iota_matrix_, {2, 0}, block_size);
+
+  auto correct {this->iota_array_};
+  for (std::size_t y {0}; y < block_size.second; ++y)
+    for (std::size_t x {0}; x < block_size.first; ++x) {
+      auto& e {correct[(y + 1) * TestFixture::size.first + x]};
+      e = (e + 2) * 3 - this->iota_array_[y * TestFixture::size.first + x + 2];
+    }
+  EXPECT_EQ(as_validator(correct), as_validator(this->iota_matrix_));
+}
+
+TYPED_TEST(ValmatrixViewTest, AssignOverlappedBlock)
+{
+  constexpr Size block_size {3, 2};
+  auto forward {this->iota_matrix_};
+  xmaho::std_ext::block_view(forward, {1, 1}, block_size) = xmaho::std_ext::block_view(forward, {0, 0}, block_size);
+  auto backward {this->iota_matrix_};
+  xmaho::std_ext::block_view(backward, {0, 0}, block_size) = xmaho::std_ext::block_view(backward, {1, 1}, block_size);
+  auto added {this->iota_matrix_};
+  xmaho::std_ext::block_view(added, {1, 1}, block_size) += xmaho::std_ext::block_view(added, {0, 0}, block_size);
+
+  auto forward_correct {this->iota_array_};
+  auto backward_correct {this->iota_array_};
+  auto added_correct {this->iota_array_};
+  for (std::size_t y {0}; y < block_size.second; ++y)
+    for (std::size_t x {0}; x < block_size.first; ++x) {
+      const auto shifted {(y + 1) * TestFixture::size.first + x + 1};
+      const auto origin {y * TestFixture::size.first + x};
+      forward_correct[shifted] = this->iota_array_[origin];
+      backward_correct[origin] = this->iota_array_[shifted];
+      added_correct[shifted] += this->iota_array_[origin];
+    }
+  EXPECT_EQ(as_validator(forward_correct), as_validator(forward));
+  EXPECT_EQ(as_validator(backward_correct), as_validator(backward));
+  EXPECT_EQ(as_validator(added_correct), as_validator(added));
+
+  auto row {this->iota_matrix_};
+  xmaho::std_ext::view(row).block({1, 0}, {3, 1}).row(0) = xmaho::std_ext::view(row).block({0, 0}, {3, 1}).row(0);
+  auto row_correct {this->iota_array_};
+  std::copy_n(std::begin(this->iota_array_), 3, std::begin(row_correct) + 1);
+  EXPECT_EQ(as_validator(row_correct), as_validator(row));
+}
+
+TYPED_TEST(ValmatrixViewTest, WriteRowAndColumn)
+{
+  auto row {xmaho::std_ext::row_view(this->iota_matrix_, 1)};
+  row += TypeParam{10};
+  auto col {xmaho::std_ext::col_view(this->iota_matrix_, 3)};
+  const typename TestFixture::Valarray operand(TypeParam{2}, TestFixture::size.second);
+  col *= operand;
+
+  this->iota_array_[std::slice{TestFixture::size.first, TestFixture::size.first, 1}] += typename TestFixture::Valarray(TypeParam{10}, TestFixture::size.first);
+  this->iota_array_[std::slice{3, TestFixture::size.second, TestFixture::size.first}] *= operand;
+  EXPECT_EQ(as_validator(this->iota_array_), as_validator(this->iota_matrix_));
+}
+
+TYPED_TEST(ValmatrixViewTest, IntegralOperators)
+{
+  if constexpr (std::is_integral_v<TypeParam>) {
+    auto v {xmaho::std_ext::view(this->iota_matrix_)};
+    v <<= TypeParam{2};
+    v |= TypeParam{1};
+    v >>= TypeParam{1};
+    v %= TypeParam{5};
+    for (auto& e : this->iota_array_)
+      e = static_cast<TypeParam>((((e << 2) | 1) >> 1) % 5);
+    EXPECT_EQ(as_validator(this->iota_array_), as_validator(this->iota_matrix_));
+  }
+}
+
+TYPED_TEST(ValmatrixViewTest, NestedViewAndPosition)
+{
+  const auto whole {xmaho::std_ext::view(this->iota_matrix_)};
+  const auto inner {whole.block({1, 1}, {3, 2}).block({1, 0}, {2, 2})};
+  EXPECT_EQ(this->iota_matrix_[1 * TestFixture::size.first + 2], (inner[{0, 0}]));
+  EXPECT_EQ(this->iota_matrix_[2 * TestFixture::size.first + 3], (inner[{1, 1}]));
+  const auto& m {this->iota_matrix_};
+  EXPECT_EQ(as_validator(m.col(3)), as_validator(whole.col(3)));
+  EXPECT_EQ(4, std::distance(inner.begin(), inner.end()));
+}
+
+TEST(ValmatrixViewEmptyTest, EmptyIteration)
+{
+  xmaho::std_ext::valmatrix<int> m {};
+  const auto v {xmaho::std_ext::view(m)};
+  EXPECT_EQ(v.begin(), v.end());
+  EXPECT_EQ(0u, v.size());
+}
+
+TEST(ValmatrixViewConvertibleScalarTest, IntLiteralOnFloatingView)
+{
+  xmaho::std_ext::valmatrix<double> m {{1., 2., 3., 4., 5., 6.}, 3, 2};
+  auto whole {xmaho::std_ext::view(m)};
+  whole += 1;
+  auto row {xmaho::std_ext::row_view(m, 1)};
+  row *= 2;
+  const std::vector<double> correct {2., 3., 4., 10., 12., 14.};
+  EXPECT_EQ(correct, as_validator(m));
+}
@@ -0,0 +1,551 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_ALIGNED_MATRIX_H
+#define XMAHO_STD_EXT_ALIGNED_MATRIX_H
+
+#include "valmatrix.hpp"
+#include "valmatrix_expression.hpp"
+#include "valmatrix_view.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/**
+ * @file std_ext/aligned_matrix.hpp
+ * @brief The matrix on allocator-aware aligned storage.
+ */
+
+namespace xmaho::std_ext
+{
+
+//! @brief Default alignment which fits cache line and 512-bit vector register.
+constexpr std::size_t cache_line_alignment {64};
+
+//! @brief Alignment of transparent huge page.
+constexpr std::size_t huge_page_alignment {std::size_t{1} << 21};
+
+/**
+ * @brief The allocator which returns over-aligned storage.
+ *
+ * If Alignment is huge_page_alignment or more,
+ * the storage is advised to be backed by transparent huge pages where it is supported.
+ *
+ * @tparam T Value type.
+ * @tparam Alignment Alignment of allocated storage. It is power of 2.
+ */
+template<typename T, std::size_t Alignment = cache_line_alignment>
+class aligned_allocator
+{
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be power of 2");
+  static_assert(Alignment >= alignof(T), "Alignment must not be less than alignof(T)");
+
+public:
+  //! @brief Value type.
+  using value_type = T;
+
+  //! @brief Allocator for other value type.
+  template<typename U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  //! @brief Default constructor.
+  aligned_allocator() = default;
+
+  /**
+   * @brief Construct by allocator of other value type.
+   *
+   * @param[in] other Source allocator. It has no state.
+   */
+  template<typename U>
+  constexpr aligned_allocator(const aligned_allocator<U, Alignment>& other) noexcept;
+
+  /**
+   * @brief Allocate storage.
+   *
+   * @param[in] n Count of elements.
+   * @return Pointer to first element which is aligned to Alignment.
+   * @exception std::bad_array_new_length n * sizeof(T) overflows.
+   * @exception std::bad_alloc Allocation failed.
+   */
+  T* allocate(std::size_t n);
+
+  /**
+   * @brief Deallocate storage.
+   *
+   * @param[in] p Pointer which is returned by allocate.
+   * @param[in] n Count of elements passed to allocate.
+   */
+  void deallocate(T* p, std::size_t n) noexcept;
+};
+
+/**
+ * @brief Compare allocators.
+ *
+ * @param[in] lhs Left hand side allocator.
+ * @param[in] rhs Right hand side allocator.
+ * @return Always true because the allocators have no state.
+ */
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool operator==(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept;
+
+/**
+ * @brief Compare allocators.
+ *
+ * @param[in] lhs Left hand side allocator.
+ * @param[in] rhs Right hand side allocator.
+ * @return Always false because the allocators have no state.
+ */
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool operator!=(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept;
+
+//! @brief The allocator which prefers transparent huge pages.
+template<typename T>
+using huge_page_allocator = aligned_allocator<T, huge_page_alignment>;
+
+/**
+ * @brief The matrix which stores elements by allocator.
+ *
+ * valmatrix can't select storage because it is valarray.
+ * This class stores elements row by row in std::vector with Allocator,
+ * so the storage is aligned to cache line by default.
+ * pmr::aligned_matrix also requests the cache line alignment from its memory resource.
+ * It exchanges elements with valmatrix, and it works with other functions by
+ * view() for valmatrix_view and by lazy() for valmatrix_expression.
+ *
+ * @code
+ * const valmatrix<double> a(1., 3, 2), b(2., 3, 2);
+ * aligned_matrix<double> c {lazy(a) + b};       // evaluate into aligned storage
+ * view(c) += a;                                  // compound assign by view
+ * const valmatrix<double> d {lazy(c) * 2.};      // use as expression operand
+ *
+ * std::pmr::monotonic_buffer_resource resource;
+ * pmr::aligned_matrix<double> e {3, 2, &resource};
+ * @endcode
+ *
+ * @invariant size() == row_size() * col_size()
+ *
+ * @tparam T Value type.
+ * @tparam Allocator Allocator of T.
+ */
+template<typename T, typename Allocator = aligned_allocator<T>>
+class aligned_matrix
+{
+public:
+  //! @brief Value type.
+  using value_type = T;
+  //! @brief Allocator type.
+  using allocator_type = Allocator;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Default constructor for empty matrix.
+   *
+   * @post row_size() == 0
+   * @post col_size() == 0
+   */
+  aligned_matrix() = default;
+
+  /**
+   * @brief Construct empty matrix with allocator.
+   *
+   * @param[in] allocator Allocator for elements.
+   */
+  explicit aligned_matrix(const Allocator& allocator) noexcept;
+
+  /**
+   * @brief Construct by matrix size.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @post all elements are `T{}`.
+   *
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   * @param[in] allocator Allocator for elements.
+   */
+  aligned_matrix(size_type row_size, size_type col_size, const Allocator& allocator = Allocator{});
+
+  /**
+   * @brief Construct by matrix size with default value.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @post all elements are value.
+   *
+   * @param[in] value Default value.
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   * @param[in] allocator Allocator for elements.
+   */
+  aligned_matrix(const T& value, size_type row_size, size_type col_size, const Allocator& allocator = Allocator{});
+
+  /**
+   * @brief Construct by copy of valmatrix.
+   *
+   * @param[in] m Source matrix.
+   * @param[in] allocator Allocator for elements.
+   */
+  explicit aligned_matrix(const valmatrix<T>& m, const Allocator& allocator = Allocator{});
+
+  /**
+   * @brief Construct by evaluating lazy expression.
+   *
+   * @param[in] expression Expression of valmatrix_expression.hpp.
+   * @param[in] allocator Allocator for elements.
+   */
+  template<typename E>
+  aligned_matrix(const valmatrix_expression<E>& expression, const Allocator& allocator = Allocator{});
+
+  //! @brief Default copy constructor for overload.
+  aligned_matrix(const aligned_matrix&) = default;
+  //! @brief Default move constructor for overload.
+  aligned_matrix(aligned_matrix&&) noexcept = default;
+  //! @brief Default copy assign for overload.
+  aligned_matrix& operator=(const aligned_matrix&) = default;
+  //! @brief Default move assign for overload.
+  aligned_matrix& operator=(aligned_matrix&&) = default;
+
+  /**
+   * @brief Assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  aligned_matrix& operator=(const T& rhs) &;
+
+  /**
+   * @brief Assign by evaluating lazy expression.
+   *
+   * The storage is reused.
+   *
+   * @pre row_size() == expression.row_size()
+   * @pre col_size() == expression.col_size()
+   *
+   * @param[in] expression Expression of valmatrix_expression.hpp.
+   * @return This reference.
+   */
+  template<typename E>
+  aligned_matrix& operator=(const valmatrix_expression<E>& expression) &;
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Const reference of element.
+   */
+  const T& operator[](size_type index) const;
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Reference of element.
+   */
+  T& operator[](size_type index);
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return Const reference of access point.
+   */
+  const T& operator[](position_type position) const;
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return Reference of access point.
+   */
+  T& operator[](position_type position);
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get element count.
+   *
+   * @return row_size() * col_size()
+   */
+  size_type size() const noexcept;
+
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * The element of row r and column c is `data()[r * row_size() + c]`.
+   *
+   * @return Const pointer to first element, or nullptr if empty.
+   */
+  const T* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * The element of row r and column c is `data()[r * row_size() + c]`.
+   *
+   * @return Pointer to first element, or nullptr if empty.
+   */
+  T* data() noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Const begin iterator.
+   */
+  const T* begin() const noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Begin iterator.
+   */
+  T* begin() noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return Const end iterator.
+   */
+  const T* end() const noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return End iterator.
+   */
+  T* end() noexcept;
+
+  /**
+   * @brief Get allocator.
+   *
+   * @return Copy of allocator.
+   */
+  allocator_type get_allocator() const noexcept;
+
+  /**
+   * @brief Swap objects.
+   *
+   * @param[in,out] other Swap target.
+   */
+  void swap(aligned_matrix& other) noexcept;
+
+private:
+  std::vector<T, Allocator> values_;
+  position_type size_ {};
+};
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return Read only view.
+ */
+template<typename T, typename Allocator>
+valmatrix_view<const T> view(const aligned_matrix<T, Allocator>& m) noexcept;
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return View.
+ */
+template<typename T, typename Allocator>
+valmatrix_view<T> view(aligned_matrix<T, Allocator>& m) noexcept;
+
+/**
+ * @brief Start lazy expression from aligned_matrix.
+ *
+ * @param[in] m The operand matrix.
+ * @return The expression that refers m.
+ */
+template<typename T, typename Allocator>
+constexpr auto lazy(const aligned_matrix<T, Allocator>& m) noexcept;
+
+/**
+ * @brief Copy elements to new valmatrix.
+ *
+ * @param[in] m Source matrix.
+ * @return Copy of matrix.
+ */
+template<typename T, typename Allocator>
+valmatrix<T> to_valmatrix(const aligned_matrix<T, Allocator>& m);
+
+/**
+ * @brief Swap objects.
+ *
+ * @param[in,out] a Swap target.
+ * @param[in,out] b Swap target.
+ */
+template<typename T, typename Allocator>
+void swap(aligned_matrix<T, Allocator>& a, aligned_matrix<T, Allocator>& b) noexcept;
+
+namespace pmr
+{
+
+/**
+ * @brief The polymorphic allocator which requests over-aligned storage.
+ *
+ * std::pmr::polymorphic_allocator requests only alignof(T) from the resource,
+ * so this allocator passes Alignment to the resource instead.
+ *
+ * @tparam T Value type.
+ * @tparam Alignment Alignment of allocated storage. It is power of 2.
+ */
+template<typename T, std::size_t Alignment = cache_line_alignment>
+class aligned_allocator
+{
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be power of 2");
+  static_assert(Alignment >= alignof(T), "Alignment must not be less than alignof(T)");
+
+public:
+  //! @brief Value type.
+  using value_type = T;
+
+  //! @brief Allocator for other value type.
+  template<typename U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  //! @brief Construct by default memory resource.
+  aligned_allocator() noexcept;
+
+  /**
+   * @brief Construct by memory resource.
+   *
+   * @pre resource != nullptr
+   *
+   * @param[in] resource Memory resource to allocate storage.
+   */
+  aligned_allocator(std::pmr::memory_resource* resource) noexcept;
+
+  /**
+   * @brief Construct by allocator of other value type.
+   *
+   * @param[in] other Source allocator.
+   */
+  template<typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment>& other) noexcept;
+
+  /**
+   * @brief Allocate storage.
+   *
+   * @param[in] n Count of elements.
+   * @return Pointer to first element which is aligned to Alignment.
+   * @exception std::bad_array_new_length n * sizeof(T) overflows.
+   * @exception std::bad_alloc Allocation failed.
+   */
+  T* allocate(std::size_t n);
+
+  /**
+   * @brief Deallocate storage.
+   *
+   * @param[in] p Pointer which is returned by allocate.
+   * @param[in] n Count of elements passed to allocate.
+   */
+  void deallocate(T* p, std::size_t n) noexcept;
+
+  /**
+   * @brief Get allocator for copy constructed container.
+   *
+   * @return Allocator on default memory resource as std::pmr::polymorphic_allocator.
+   */
+  aligned_allocator select_on_container_copy_construction() const noexcept;
+
+  /**
+   * @brief Get memory resource.
+   *
+   * @return Memory resource of this allocator.
+   */
+  std::pmr::memory_resource* resource() const noexcept;
+
+private:
+  std::pmr::memory_resource* resource_;
+};
+
+/**
+ * @brief Compare allocators.
+ *
+ * @param[in] lhs Left hand side allocator.
+ * @param[in] rhs Right hand side allocator.
+ * @return true if memory resources are equal.
+ */
+template<typename T, typename U, std::size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept;
+
+/**
+ * @brief Compare allocators.
+ *
+ * @param[in] lhs Left hand side allocator.
+ * @param[in] rhs Right hand side allocator.
+ * @return true if memory resources are not equal.
+ */
+template<typename T, typename U, std::size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept;
+
+//! @brief aligned_matrix on polymorphic memory resource.
+template<typename T>
+using aligned_matrix = xmaho::std_ext::aligned_matrix<T, aligned_allocator<T>>;
+
+}
+
+}
+
+#include "detail/aligned_matrix.hpp"
+
+#endif
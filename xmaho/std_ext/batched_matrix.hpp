@@ -0,0 +1,403 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_BATCHED_MATRIX_H
+#define XMAHO_STD_EXT_BATCHED_MATRIX_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <valarray>
+#include <vector>
+
+/**
+ * @file std_ext/batched_matrix.hpp
+ * @brief The batch of many small matrices which have same dimention.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The batch of same dimention matrices.
+ *
+ * Elements are interleaved across the batch.
+ * Same position of all matrices is contiguous,
+ * so operations run vector registers across the batch instead of the tiny matrix.
+ * The element at position p of matrix i is `lane(p)[i]`.
+ *
+ * @code
+ * batched_matrix<double> a(1., 100000, 4, 4), b(2., 100000, 4, 4);
+ * const auto c {matmul(a, b)};           // 100000 products of 4x4
+ * const auto x {solve(c, b)};            // 100000 systems "c x = b"
+ * const valmatrix<double> first {x.extract(0)};
+ * @endcode
+ *
+ * @invariant size() == batch_size() * row_size() * col_size()
+ *
+ * @tparam T Value type.
+ */
+template<typename T>
+class batched_matrix
+{
+public:
+  //! @brief Value type.
+  using value_type = T;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Default constructor for empty batch.
+   *
+   * @post batch_size() == 0
+   */
+  batched_matrix() = default;
+
+  /**
+   * @brief Construct by batch size and matrix size.
+   *
+   * @post all elements are `T{}`.
+   *
+   * @param[in] batch_size Count of matrices.
+   * @param[in] row_size Row size of each matrix.
+   * @param[in] col_size Column size of each matrix.
+   */
+  batched_matrix(size_type batch_size, size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by batch size and matrix size with default value.
+   *
+   * @post all elements are value.
+   *
+   * @param[in] value Default value.
+   * @param[in] batch_size Count of matrices.
+   * @param[in] row_size Row size of each matrix.
+   * @param[in] col_size Column size of each matrix.
+   */
+  batched_matrix(const T& value, size_type batch_size, size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by copy of matrices.
+   *
+   * @pre All matrices have same dimention.
+   *
+   * @param[in] matrices Source matrices.
+   */
+  explicit batched_matrix(const std::vector<valmatrix<T>>& matrices);
+
+  /**
+   * @brief Access element of a matrix.
+   *
+   * @pre index < batch_size()
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] index Index of matrix.
+   * @param[in] position Position in the matrix.
+   * @return Const reference of element.
+   */
+  const T& operator()(size_type index, position_type position) const;
+
+  /**
+   * @brief Access element of a matrix.
+   *
+   * @pre index < batch_size()
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] index Index of matrix.
+   * @param[in] position Position in the matrix.
+   * @return Reference of element.
+   */
+  T& operator()(size_type index, position_type position);
+
+  /**
+   * @brief Get copy of a matrix.
+   *
+   * @pre index < batch_size()
+   *
+   * @param[in] index Index of matrix.
+   * @return Copy of matrix.
+   */
+  valmatrix<T> extract(size_type index) const;
+
+  /**
+   * @brief Overwrite a matrix.
+   *
+   * @pre index < batch_size()
+   * @pre m.row_size() == row_size()
+   * @pre m.col_size() == col_size()
+   *
+   * @param[in] index Index of matrix.
+   * @param[in] m Source matrix.
+   */
+  void assign(size_type index, const valmatrix<T>& m);
+
+  /**
+   * @brief Get elements at same position of all matrices.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Position in the matrix.
+   * @return Const pointer to batch_size() elements.
+   */
+  const T* lane(position_type position) const;
+
+  /**
+   * @brief Get elements at same position of all matrices.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Position in the matrix.
+   * @return Pointer to batch_size() elements.
+   */
+  T* lane(position_type position);
+
+  /**
+   * @brief Addition assign to each element.
+   *
+   * @pre Same batch size and dimention.
+   *
+   * @param[in] rhs Same shape batch.
+   * @return This reference.
+   */
+  batched_matrix& operator+=(const batched_matrix& rhs) &;
+
+  /**
+   * @brief Addition assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  batched_matrix& operator+=(const T& rhs) &;
+
+  /**
+   * @brief Subtraction assign to each element.
+   *
+   * @pre Same batch size and dimention.
+   *
+   * @param[in] rhs Same shape batch.
+   * @return This reference.
+   */
+  batched_matrix& operator-=(const batched_matrix& rhs) &;
+
+  /**
+   * @brief Subtraction assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  batched_matrix& operator-=(const T& rhs) &;
+
+  /**
+   * @brief Multiplication assign to each element.
+   *
+   * @pre Same batch size and dimention.
+   *
+   * @param[in] rhs Same shape batch.
+   * @return This reference.
+   */
+  batched_matrix& operator*=(const batched_matrix& rhs) &;
+
+  /**
+   * @brief Multiplication assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  batched_matrix& operator*=(const T& rhs) &;
+
+  /**
+   * @brief Divition assign to each element.
+   *
+   * @pre Same batch size and dimention.
+   *
+   * @param[in] rhs Same shape batch.
+   * @return This reference.
+   */
+  batched_matrix& operator/=(const batched_matrix& rhs) &;
+
+  /**
+   * @brief Divition assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  batched_matrix& operator/=(const T& rhs) &;
+
+  /**
+   * @brief Get count of matrices.
+   *
+   * @return Count of matrices.
+   */
+  size_type batch_size() const noexcept;
+
+  /**
+   * @brief Get row size of each matrix.
+   *
+   * @return Count of column.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size of each matrix.
+   *
+   * @return Count of row.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get count of all elements.
+   *
+   * @return batch_size() * row_size() * col_size()
+   */
+  size_type size() const noexcept;
+
+  /**
+   * @brief Get pointer to the interleaved storage.
+   *
+   * @return Const pointer to first element, or nullptr if empty.
+   */
+  const T* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the interleaved storage.
+   *
+   * @return Pointer to first element, or nullptr if empty.
+   */
+  T* data() noexcept;
+
+private:
+  std::valarray<T> values_;
+  size_type batch_size_ {0};
+  position_type size_ {};
+};
+
+/**
+ * @brief Addition operator for batched_matrix.
+ *
+ * @pre Same batch size and dimention.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of addition.
+ */
+template<typename T>
+batched_matrix<T> operator+(batched_matrix<T> lhs, const batched_matrix<T>& rhs);
+
+/**
+ * @brief Subtraction operator for batched_matrix.
+ *
+ * @pre Same batch size and dimention.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of subtraction.
+ */
+template<typename T>
+batched_matrix<T> operator-(batched_matrix<T> lhs, const batched_matrix<T>& rhs);
+
+/**
+ * @brief Multiplication operator for batched_matrix.
+ *
+ * This is element-wise product. Use matmul for matrix product.
+ *
+ * @pre Same batch size and dimention.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T>
+batched_matrix<T> operator*(batched_matrix<T> lhs, const batched_matrix<T>& rhs);
+
+/**
+ * @brief Multiplication operator for batched_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value that is value.
+ * @return Result of multiplication.
+ */
+template<typename T>
+batched_matrix<T> operator*(batched_matrix<T> lhs, const T& rhs);
+
+/**
+ * @brief Divition operator for batched_matrix.
+ *
+ * @pre Same batch size and dimention.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of divition.
+ */
+template<typename T>
+batched_matrix<T> operator/(batched_matrix<T> lhs, const batched_matrix<T>& rhs);
+
+/**
+ * @brief Return matrix product "a b" of each matrix.
+ *
+ * @pre a.batch_size() == b.batch_size()
+ * @pre a.row_size() == b.col_size()
+ * @post result.row_size() == b.row_size()
+ * @post result.col_size() == a.col_size()
+ *
+ * @param[in] a Left hand side matrices.
+ * @param[in] b Right hand side matrices.
+ * @return The matrix products.
+ */
+template<typename T>
+batched_matrix<T> matmul(const batched_matrix<T>& a, const batched_matrix<T>& b);
+
+/**
+ * @brief Solve linear system "a x = b" of each matrix.
+ *
+ * Gaussian elimination with partial pivoting is run for all matrices at once.
+ * Pivot is selected for each matrix.
+ *
+ * @pre a.batch_size() == b.batch_size()
+ * @pre a.row_size() == a.col_size()
+ * @pre b.col_size() == a.col_size()
+ *
+ * @param[in] a Square coefficient matrices.
+ * @param[in] b Right hand side matrices that have one system per column.
+ * @return Solution x which has same shape as b.
+ * @exception std::domain_error Any matrix of a is singular.
+ */
+template<typename T>
+batched_matrix<T> solve(batched_matrix<T> a, batched_matrix<T> b);
+
+}
+
+#include "detail/batched_matrix.hpp"
+
+#endif
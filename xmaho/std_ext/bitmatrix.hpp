@@ -0,0 +1,448 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_BITMATRIX_H
+#define XMAHO_STD_EXT_BITMATRIX_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <valarray>
+#include <vector>
+
+/**
+ * @file std_ext/bitmatrix.hpp
+ * @brief The boolean matrix which packs 64 elements into a word.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The boolean matrix on packed bits.
+ *
+ * valmatrix<bool> stores an element per byte and the logical operators
+ * process the elements one by one.
+ * This class stores each row on whole 64 bit words,
+ * so the storage is 8 times smaller and the logical operators and the count
+ * process 64 elements per instruction.
+ * The padding bits after the last column are always 0.
+ *
+ * @code
+ * bitmatrix occupied {1024, 1024};
+ * occupied.set({3, 5});                         // column 3, row 5
+ * bitmatrix visible {true, 1024, 1024};
+ * visible ^= occupied;
+ * const auto count = (occupied & visible).sum();
+ * const std::valarray<bool> line {occupied.row(5)};
+ * @endcode
+ *
+ * @invariant size() == row_size() * col_size()
+ */
+class bitmatrix
+{
+public:
+  //! @brief Value type.
+  using value_type = bool;
+  //! @brief Storage word type.
+  using word_type = std::uint64_t;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  //! @brief Count of elements in a word.
+  static constexpr size_type word_bits {64};
+
+  /**
+   * @brief Default constructor for empty matrix.
+   *
+   * @post row_size() == 0
+   * @post col_size() == 0
+   */
+  bitmatrix() = default;
+
+  /**
+   * @brief Construct by matrix size.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @post all elements are false.
+   *
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  bitmatrix(size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by matrix size with default value.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @post all elements are value.
+   *
+   * @param[in] value Default value.
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  bitmatrix(bool value, size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by packing valmatrix.
+   *
+   * @param[in] m Source matrix.
+   */
+  explicit bitmatrix(const valmatrix<bool>& m);
+
+  /**
+   * @brief Assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  bitmatrix& operator=(bool rhs) &;
+
+  /**
+   * @brief Access to element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return The value of element.
+   */
+  bool operator[](position_type position) const;
+
+  /**
+   * @brief Access to element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return The value of element.
+   */
+  bool test(position_type position) const;
+
+  /**
+   * @brief Set element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @param[in] value New value.
+   * @return This reference.
+   */
+  bitmatrix& set(position_type position, bool value = true);
+
+  /**
+   * @brief Set false to element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return This reference.
+   */
+  bitmatrix& reset(position_type position);
+
+  /**
+   * @brief Invert element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return This reference.
+   */
+  bitmatrix& flip(position_type position);
+
+  /**
+   * @brief Invert all elements.
+   *
+   * @return This reference.
+   */
+  bitmatrix& flip() noexcept;
+
+  /**
+   * @brief Logical and assign.
+   *
+   * @pre row_size() == rhs.row_size()
+   * @pre col_size() == rhs.col_size()
+   *
+   * @param[in] rhs Right hand side matrix.
+   * @return This reference.
+   */
+  bitmatrix& operator&=(const bitmatrix& rhs) &;
+
+  /**
+   * @brief Logical or assign.
+   *
+   * @pre row_size() == rhs.row_size()
+   * @pre col_size() == rhs.col_size()
+   *
+   * @param[in] rhs Right hand side matrix.
+   * @return This reference.
+   */
+  bitmatrix& operator|=(const bitmatrix& rhs) &;
+
+  /**
+   * @brief Logical xor assign.
+   *
+   * @pre row_size() == rhs.row_size()
+   * @pre col_size() == rhs.col_size()
+   *
+   * @param[in] rhs Right hand side matrix.
+   * @return This reference.
+   */
+  bitmatrix& operator^=(const bitmatrix& rhs) &;
+
+  /**
+   * @brief Logical and assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  bitmatrix& operator&=(bool rhs) &;
+
+  /**
+   * @brief Logical or assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  bitmatrix& operator|=(bool rhs) &;
+
+  /**
+   * @brief Logical xor assign to each element.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  bitmatrix& operator^=(bool rhs) &;
+
+  /**
+   * @brief Logical not.
+   *
+   * @return Inverted matrix.
+   */
+  bitmatrix operator!() const;
+
+  /**
+   * @brief Count true elements.
+   *
+   * @return Count of true.
+   */
+  size_type sum() const noexcept;
+
+  /**
+   * @brief Check any element is true.
+   *
+   * @return True if one or more elements are true.
+   */
+  bool any() const noexcept;
+
+  /**
+   * @brief Check all elements are true.
+   *
+   * @return True if all elements are true or the matrix is empty.
+   */
+  bool all() const noexcept;
+
+  /**
+   * @brief Get copy of row.
+   *
+   * @pre index < col_size()
+   *
+   * @param[in] index Row index.
+   * @return Values of the row.
+   */
+  std::valarray<bool> row(size_type index) const;
+
+  /**
+   * @brief Get copy of column.
+   *
+   * @pre index < row_size()
+   *
+   * @param[in] index Column index.
+   * @return Values of the column.
+   */
+  std::valarray<bool> col(size_type index) const;
+
+  /**
+   * @brief Count true elements in row.
+   *
+   * @pre index < col_size()
+   *
+   * @param[in] index Row index.
+   * @return Count of true.
+   */
+  size_type row_sum(size_type index) const;
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get element count.
+   *
+   * @return row_size() * col_size()
+   */
+  size_type size() const noexcept;
+
+  /**
+   * @brief Get word count of a row.
+   *
+   * @return Count of words which store a row.
+   */
+  size_type row_words() const noexcept;
+
+  /**
+   * @brief Get pointer to the packed storage.
+   *
+   * The element of row r and column c is the bit `c % word_bits` of
+   * `data()[r * row_words() + c / word_bits]`.
+   *
+   * @return Const pointer to first word, or nullptr if empty.
+   */
+  const word_type* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the packed storage.
+   *
+   * The element of row r and column c is the bit `c % word_bits` of
+   * `data()[r * row_words() + c / word_bits]`.
+   * The padding bits must be kept 0.
+   *
+   * @return Pointer to first word, or nullptr if empty.
+   */
+  word_type* data() noexcept;
+
+  /**
+   * @brief Swap objects.
+   *
+   * @param[in,out] other Swap target.
+   */
+  void swap(bitmatrix& other) noexcept;
+
+private:
+  void clear_padding() noexcept;
+
+  std::vector<word_type> words_;
+  position_type size_ {};
+  size_type row_words_ {};
+};
+
+/**
+ * @brief Logical and.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side matrix.
+ * @param[in] rhs Right hand side matrix.
+ * @return Result matrix.
+ */
+bitmatrix operator&(bitmatrix lhs, const bitmatrix& rhs);
+
+/**
+ * @brief Logical or.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side matrix.
+ * @param[in] rhs Right hand side matrix.
+ * @return Result matrix.
+ */
+bitmatrix operator|(bitmatrix lhs, const bitmatrix& rhs);
+
+/**
+ * @brief Logical xor.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side matrix.
+ * @param[in] rhs Right hand side matrix.
+ * @return Result matrix.
+ */
+bitmatrix operator^(bitmatrix lhs, const bitmatrix& rhs);
+
+/**
+ * @brief Compare matrices.
+ *
+ * @param[in] lhs Left hand side matrix.
+ * @param[in] rhs Right hand side matrix.
+ * @return True if the sizes and all elements are same.
+ */
+bool operator==(const bitmatrix& lhs, const bitmatrix& rhs) noexcept;
+
+/**
+ * @brief Compare matrices.
+ *
+ * @param[in] lhs Left hand side matrix.
+ * @param[in] rhs Right hand side matrix.
+ * @return !(lhs == rhs)
+ */
+bool operator!=(const bitmatrix& lhs, const bitmatrix& rhs) noexcept;
+
+/**
+ * @brief Unpack elements to new valmatrix.
+ *
+ * @param[in] m Source matrix.
+ * @return Copy of matrix.
+ */
+valmatrix<bool> to_valmatrix(const bitmatrix& m);
+
+/**
+ * @brief Swap objects.
+ *
+ * @param[in,out] a Swap target.
+ * @param[in,out] b Swap target.
+ */
+void swap(bitmatrix& a, bitmatrix& b) noexcept;
+
+}
+
+#include "detail/bitmatrix.hpp"
+
+#endif
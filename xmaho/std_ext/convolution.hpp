@@ -0,0 +1,173 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_CONVOLUTION_H
+#define XMAHO_STD_EXT_CONVOLUTION_H
+
+#include "parallel.hpp"
+#include "valmatrix.hpp"
+
+#include <valarray>
+
+/**
+ * @file std_ext/convolution.hpp
+ * @brief The two dimensional convolution and stencil operations for valmatrix.
+ *
+ * The source is copied once into a buffer with halo of the border mode,
+ * so the inner loops don't branch on the border.
+ * Output rows are computed in tiles that stay in cache,
+ * and each tap is applied to a whole tile with vector registers.
+ * The overloads with parallel_context split the rows into bands for the threads.
+ *
+ * @code
+ * const valmatrix<float> image(1.f, 640, 480);
+ * const std::valarray<float> gauss {0.25f, 0.5f, 0.25f};
+ * const auto blurred {convolve_separable(image, gauss, gauss, border_mode::clamp)};
+ * const auto dilated {stencil(image, {3, 3}, [](float a, float b) {return std::max(a, b);}, border_mode::clamp)};
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The values read outside of the source matrix.
+ */
+enum class border_mode
+{
+  zero,  //!< Zero.
+  clamp, //!< The nearest element.
+  wrap   //!< The element of the periodic extension.
+};
+
+/**
+ * @brief Convolve matrix with kernel.
+ *
+ * result(x, y) = sum of kernel(i, j) * m(x + r - i, y + s - j),
+ * where (r, s) is the center of kernel.
+ *
+ * @pre kernel.row_size() and kernel.col_size() are odd.
+ *
+ * @param[in] m Source matrix.
+ * @param[in] kernel Convolution kernel.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T>
+valmatrix<T> convolve(const valmatrix<T>& m, const valmatrix<T>& kernel, border_mode border = border_mode::zero);
+
+/**
+ * @brief Convolve matrix with kernel in parallel.
+ *
+ * Same as `convolve(m, kernel, border)`.
+ *
+ * @pre kernel.row_size() and kernel.col_size() are odd.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Source matrix.
+ * @param[in] kernel Convolution kernel.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T>
+valmatrix<T> convolve(parallel_context& context, const valmatrix<T>& m, const valmatrix<T>& kernel, border_mode border = border_mode::zero);
+
+/**
+ * @brief Convolve matrix with separable kernel.
+ *
+ * Same as convolve() with the outer product of col_kernel and row_kernel,
+ * but costs row_kernel.size() + col_kernel.size() multiplications per element.
+ *
+ * @pre row_kernel.size() and col_kernel.size() are odd.
+ *
+ * @param[in] m Source matrix.
+ * @param[in] row_kernel Kernel along each row.
+ * @param[in] col_kernel Kernel along each column.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T>
+valmatrix<T> convolve_separable(const valmatrix<T>& m, const std::valarray<T>& row_kernel, const std::valarray<T>& col_kernel, border_mode border = border_mode::zero);
+
+/**
+ * @brief Convolve matrix with separable kernel in parallel.
+ *
+ * Same as `convolve_separable(m, row_kernel, col_kernel, border)`.
+ *
+ * @pre row_kernel.size() and col_kernel.size() are odd.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Source matrix.
+ * @param[in] row_kernel Kernel along each row.
+ * @param[in] col_kernel Kernel along each column.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T>
+valmatrix<T> convolve_separable(parallel_context& context, const valmatrix<T>& m, const std::valarray<T>& row_kernel, const std::valarray<T>& col_kernel, border_mode border = border_mode::zero);
+
+/**
+ * @brief Fold the window around each element.
+ *
+ * result(x, y) is the fold by op of the elements in the window
+ * that size is size and center is (x, y).
+ * Minimum and maximum give the morphological erosion and dilation.
+ *
+ * @pre size.first and size.second are odd.
+ *
+ * @param[in] m Source matrix.
+ * @param[in] size Window's size.
+ * @param[in] op Associative binary operation.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T, typename Op>
+valmatrix<T> stencil(const valmatrix<T>& m, typename valmatrix<T>::position_type size, Op op, border_mode border = border_mode::zero);
+
+/**
+ * @brief Fold the window around each element in parallel.
+ *
+ * Same as `stencil(m, size, op, border)`.
+ *
+ * @pre size.first and size.second are odd.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Source matrix.
+ * @param[in] size Window's size.
+ * @param[in] op Associative binary operation.
+ * @param[in] border Values outside of m.
+ * @return Result that has same dimention as m.
+ */
+template<typename T, typename Op>
+valmatrix<T> stencil(parallel_context& context, const valmatrix<T>& m, typename valmatrix<T>::position_type size, Op op, border_mode border = border_mode::zero);
+
+}
+
+#include "detail/convolution.hpp"
+
+#endif
@@ -0,0 +1,282 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DECOMPOSITION_H
+#define XMAHO_STD_EXT_DECOMPOSITION_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <valarray>
+#include <vector>
+
+/**
+ * @file std_ext/decomposition.hpp
+ * @brief The dense matrix decompositions for solving linear systems.
+ *
+ * Each class factorizes the matrix once at construction,
+ * and solve() reuses the factorization for any count of right hand sides.
+ * Right hand side matrix has one system per column.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief LU decomposition with partial pivoting "P A = L U".
+ *
+ * Factorization is blocked, and the trailing update uses the matrix product kernel.
+ *
+ * @code
+ * const lu_decomposition<double> lu {valmatrix<double> {{2, 1, 1, 3}, 2, 2}};
+ * const auto x {lu.solve(std::valarray<double> {3, 5})}; // {0.8, 1.4}
+ * @endcode
+ *
+ * @tparam T Floating point type.
+ */
+template<typename T>
+class lu_decomposition
+{
+  static_assert(std::is_floating_point_v<T>, "lu_decomposition requires floating point type.");
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  /**
+   * @brief Factorize square matrix.
+   *
+   * The storage of a is reused for the factors.
+   *
+   * @pre a.row_size() == a.col_size()
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error a is singular.
+   */
+  explicit lu_decomposition(valmatrix<T> a);
+
+  /**
+   * @brief Solve "A x = b".
+   *
+   * @pre b.size() == order()
+   *
+   * @param[in] b Right hand side vector.
+   * @return Solution x.
+   */
+  std::valarray<T> solve(std::valarray<T> b) const;
+
+  /**
+   * @brief Solve "A X = B".
+   *
+   * @pre b.col_size() == order()
+   *
+   * @param[in] b Right hand side matrix.
+   * @return Solution X.
+   */
+  valmatrix<T> solve(valmatrix<T> b) const;
+
+  /**
+   * @brief Get determinant of A.
+   *
+   * @return Determinant.
+   */
+  T determinant() const noexcept;
+
+  /**
+   * @brief Get order of A.
+   *
+   * @return Count of rows and columns.
+   */
+  size_type order() const noexcept;
+
+  /**
+   * @brief Get combined factors.
+   *
+   * Strict lower part is L that has unit diagonal, and upper part is U.
+   *
+   * @return Factors.
+   */
+  const valmatrix<T>& matrix() const noexcept;
+
+  /**
+   * @brief Get row interchanges.
+   *
+   * Row i was interchanged with row pivots()[i] at step i.
+   *
+   * @return Pivot indices.
+   */
+  const std::vector<size_type>& pivots() const noexcept;
+
+private:
+  valmatrix<T> lu_;
+  std::vector<size_type> pivots_;
+  bool odd_ {false};
+};
+
+/**
+ * @brief Cholesky decomposition "A = L L^T" of symmetric positive definite matrix.
+ *
+ * Only the lower part of A is read.
+ * Factorization is blocked, and the trailing update uses the matrix product kernel.
+ *
+ * @tparam T Floating point type.
+ */
+template<typename T>
+class cholesky_decomposition
+{
+  static_assert(std::is_floating_point_v<T>, "cholesky_decomposition requires floating point type.");
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  /**
+   * @brief Factorize symmetric positive definite matrix.
+   *
+   * The storage of a is reused for the factor.
+   *
+   * @pre a.row_size() == a.col_size()
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error a is not positive definite.
+   */
+  explicit cholesky_decomposition(valmatrix<T> a);
+
+  /**
+   * @brief Solve "A x = b".
+   *
+   * @pre b.size() == order()
+   *
+   * @param[in] b Right hand side vector.
+   * @return Solution x.
+   */
+  std::valarray<T> solve(std::valarray<T> b) const;
+
+  /**
+   * @brief Solve "A X = B".
+   *
+   * @pre b.col_size() == order()
+   *
+   * @param[in] b Right hand side matrix.
+   * @return Solution X.
+   */
+  valmatrix<T> solve(valmatrix<T> b) const;
+
+  /**
+   * @brief Get order of A.
+   *
+   * @return Count of rows and columns.
+   */
+  size_type order() const noexcept;
+
+  /**
+   * @brief Get lower triangular factor.
+   *
+   * @return L that upper part is zero.
+   */
+  const valmatrix<T>& matrix() const noexcept;
+
+private:
+  valmatrix<T> l_;
+};
+
+/**
+ * @brief Householder QR decomposition "A = Q R".
+ *
+ * Reflectors are applied in blocks by compact WY form,
+ * and block updates use the matrix product kernel.
+ * solve() returns least squares solution for overdetermined systems.
+ *
+ * @tparam T Floating point type.
+ */
+template<typename T>
+class qr_decomposition
+{
+  static_assert(std::is_floating_point_v<T>, "qr_decomposition requires floating point type.");
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  /**
+   * @brief Factorize matrix.
+   *
+   * The storage of a is reused for the factors.
+   *
+   * @pre a.col_size() >= a.row_size()
+   *
+   * @param[in] a Target matrix that rows are not fewer than columns.
+   */
+  explicit qr_decomposition(valmatrix<T> a);
+
+  /**
+   * @brief Solve "A x = b" in least squares sense.
+   *
+   * @pre b.size() == matrix().col_size()
+   *
+   * @param[in] b Right hand side vector.
+   * @return Solution x that minimizes the norm of "A x - b".
+   * @exception std::domain_error A is rank deficient within rounding error.
+   */
+  std::valarray<T> solve(std::valarray<T> b) const;
+
+  /**
+   * @brief Solve "A X = B" in least squares sense.
+   *
+   * @pre b.col_size() == matrix().col_size()
+   *
+   * @param[in] b Right hand side matrix.
+   * @return Solution X that minimizes the norm of each column of "A X - B".
+   * @exception std::domain_error A is rank deficient within rounding error.
+   */
+  valmatrix<T> solve(valmatrix<T> b) const;
+
+  /**
+   * @brief Get upper triangular factor.
+   *
+   * @return R that is square of A's column count.
+   */
+  valmatrix<T> r() const;
+
+  /**
+   * @brief Get combined factors.
+   *
+   * Upper part is R, and strict lower part is Householder vectors without unit leading element.
+   *
+   * @return Factors.
+   */
+  const valmatrix<T>& matrix() const noexcept;
+
+private:
+  valmatrix<T> qr_;
+  std::vector<T> tau_;
+};
+
+}
+
+#include "detail/decomposition.hpp"
+
+#endif
@@ -0,0 +1,329 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_ALIGNED_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_ALIGNED_MATRIX_H
+
+#include "../aligned_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace xmaho::std_ext::detail
+{
+
+inline void advise_huge_page([[maybe_unused]] void* p, [[maybe_unused]] std::size_t bytes) noexcept
+{
+#if defined(MADV_HUGEPAGE)
+  ::madvise(p, bytes, MADV_HUGEPAGE); // Only advice, so the failure is ignored.
+#endif
+}
+
+}
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+constexpr xmaho::std_ext::aligned_allocator<T, Alignment>::aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+{
+}
+
+template<typename T, std::size_t Alignment>
+T* xmaho::std_ext::aligned_allocator<T, Alignment>::allocate(std::size_t n)
+{
+  if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+    throw std::bad_array_new_length{};
+  const auto bytes {n * sizeof(T)};
+  const auto p {::operator new(bytes, std::align_val_t{Alignment})};
+  if constexpr (Alignment >= huge_page_alignment)
+    detail::advise_huge_page(p, bytes);
+  return static_cast<T*>(p);
+}
+
+template<typename T, std::size_t Alignment>
+void xmaho::std_ext::aligned_allocator<T, Alignment>::deallocate(T* p, std::size_t) noexcept
+{
+  ::operator delete(p, std::align_val_t{Alignment});
+}
+
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool xmaho::std_ext::operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept
+{
+  return true;
+}
+
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool xmaho::std_ext::operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept
+{
+  return false;
+}
+
+template<typename T, std::size_t Alignment>
+xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::aligned_allocator() noexcept
+  : resource_ {std::pmr::get_default_resource()}
+{
+}
+
+template<typename T, std::size_t Alignment>
+xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::aligned_allocator(std::pmr::memory_resource* resource) noexcept
+  : resource_ {resource}
+{
+  assert(resource);
+}
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::aligned_allocator(const aligned_allocator<U, Alignment>& other) noexcept
+  : resource_ {other.resource()}
+{
+}
+
+template<typename T, std::size_t Alignment>
+T* xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::allocate(std::size_t n)
+{
+  if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+    throw std::bad_array_new_length{};
+  return static_cast<T*>(resource_->allocate(n * sizeof(T), Alignment));
+}
+
+template<typename T, std::size_t Alignment>
+void xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::deallocate(T* p, std::size_t n) noexcept
+{
+  resource_->deallocate(p, n * sizeof(T), Alignment);
+}
+
+template<typename T, std::size_t Alignment>
+xmaho::std_ext::pmr::aligned_allocator<T, Alignment> xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::select_on_container_copy_construction() const noexcept
+{
+  return {};
+}
+
+template<typename T, std::size_t Alignment>
+std::pmr::memory_resource* xmaho::std_ext::pmr::aligned_allocator<T, Alignment>::resource() const noexcept
+{
+  return resource_;
+}
+
+template<typename T, typename U, std::size_t Alignment>
+bool xmaho::std_ext::pmr::operator==(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept
+{
+  return *lhs.resource() == *rhs.resource();
+}
+
+template<typename T, typename U, std::size_t Alignment>
+bool xmaho::std_ext::pmr::operator!=(const aligned_allocator<T, Alignment>& lhs, const aligned_allocator<U, Alignment>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::aligned_matrix<T, Allocator>::aligned_matrix(const Allocator& allocator) noexcept
+  : values_(allocator)
+{
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::aligned_matrix<T, Allocator>::aligned_matrix(size_type row_size, size_type col_size, const Allocator& allocator)
+  : values_(row_size * col_size, allocator),
+    size_ {detail::get_init_size(row_size, col_size)}
+{
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::aligned_matrix<T, Allocator>::aligned_matrix(const T& value, size_type row_size, size_type col_size, const Allocator& allocator)
+  : values_(row_size * col_size, value, allocator),
+    size_ {detail::get_init_size(row_size, col_size)}
+{
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::aligned_matrix<T, Allocator>::aligned_matrix(const valmatrix<T>& m, const Allocator& allocator)
+  : values_(m.begin(), m.end(), allocator),
+    size_ {m.row_size(), m.col_size()}
+{
+}
+
+template<typename T, typename Allocator>
+template<typename E>
+xmaho::std_ext::aligned_matrix<T, Allocator>::aligned_matrix(const valmatrix_expression<E>& expression, const Allocator& allocator)
+  : values_(expression.size(), allocator),
+    size_ {detail::get_init_size(expression.row_size(), expression.col_size())}
+{
+  expression.copy_to(data());
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::aligned_matrix<T, Allocator>& xmaho::std_ext::aligned_matrix<T, Allocator>::operator=(const T& rhs) &
+{
+  std::fill(values_.begin(), values_.end(), rhs);
+  return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename E>
+xmaho::std_ext::aligned_matrix<T, Allocator>& xmaho::std_ext::aligned_matrix<T, Allocator>::operator=(const valmatrix_expression<E>& expression) &
+{
+  assert(row_size() == expression.row_size());
+  assert(col_size() == expression.col_size());
+  expression.copy_to(data());
+  return *this;
+}
+
+template<typename T, typename Allocator>
+const T& xmaho::std_ext::aligned_matrix<T, Allocator>::operator[](size_type index) const
+{
+  assert(index < size());
+  return values_[index];
+}
+
+template<typename T, typename Allocator>
+T& xmaho::std_ext::aligned_matrix<T, Allocator>::operator[](size_type index)
+{
+  assert(index < size());
+  return values_[index];
+}
+
+template<typename T, typename Allocator>
+const T& xmaho::std_ext::aligned_matrix<T, Allocator>::operator[](position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return values_[row_major::index(position, size_)];
+}
+
+template<typename T, typename Allocator>
+T& xmaho::std_ext::aligned_matrix<T, Allocator>::operator[](position_type position)
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return values_[row_major::index(position, size_)];
+}
+
+template<typename T, typename Allocator>
+typename xmaho::std_ext::aligned_matrix<T, Allocator>::size_type xmaho::std_ext::aligned_matrix<T, Allocator>::row_size() const noexcept
+{
+  return size_.first;
+}
+
+template<typename T, typename Allocator>
+typename xmaho::std_ext::aligned_matrix<T, Allocator>::size_type xmaho::std_ext::aligned_matrix<T, Allocator>::col_size() const noexcept
+{
+  return size_.second;
+}
+
+template<typename T, typename Allocator>
+typename xmaho::std_ext::aligned_matrix<T, Allocator>::size_type xmaho::std_ext::aligned_matrix<T, Allocator>::size() const noexcept
+{
+  return values_.size();
+}
+
+template<typename T, typename Allocator>
+const T* xmaho::std_ext::aligned_matrix<T, Allocator>::data() const noexcept
+{
+  return size() ? values_.data() : nullptr;
+}
+
+template<typename T, typename Allocator>
+T* xmaho::std_ext::aligned_matrix<T, Allocator>::data() noexcept
+{
+  return size() ? values_.data() : nullptr;
+}
+
+template<typename T, typename Allocator>
+const T* xmaho::std_ext::aligned_matrix<T, Allocator>::begin() const noexcept
+{
+  return values_.data();
+}
+
+template<typename T, typename Allocator>
+T* xmaho::std_ext::aligned_matrix<T, Allocator>::begin() noexcept
+{
+  return values_.data();
+}
+
+template<typename T, typename Allocator>
+const T* xmaho::std_ext::aligned_matrix<T, Allocator>::end() const noexcept
+{
+  return values_.data() + values_.size();
+}
+
+template<typename T, typename Allocator>
+T* xmaho::std_ext::aligned_matrix<T, Allocator>::end() noexcept
+{
+  return values_.data() + values_.size();
+}
+
+template<typename T, typename Allocator>
+typename xmaho::std_ext::aligned_matrix<T, Allocator>::allocator_type xmaho::std_ext::aligned_matrix<T, Allocator>::get_allocator() const noexcept
+{
+  return values_.get_allocator();
+}
+
+template<typename T, typename Allocator>
+void xmaho::std_ext::aligned_matrix<T, Allocator>::swap(aligned_matrix& other) noexcept
+{
+  values_.swap(other.values_);
+  std::swap(size_, other.size_);
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::valmatrix_view<const T> xmaho::std_ext::view(const aligned_matrix<T, Allocator>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::valmatrix_view<T> xmaho::std_ext::view(aligned_matrix<T, Allocator>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T, typename Allocator>
+constexpr auto xmaho::std_ext::lazy(const aligned_matrix<T, Allocator>& m) noexcept
+{
+  return valmatrix_expression<detail::matrix_terminal<T>>{{m.data(), m.row_size(), m.col_size()}};
+}
+
+template<typename T, typename Allocator>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::to_valmatrix(const aligned_matrix<T, Allocator>& m)
+{
+  return {std::valarray<T>(m.data(), m.size()), m.row_size(), m.col_size()};
+}
+
+template<typename T, typename Allocator>
+void xmaho::std_ext::swap(aligned_matrix<T, Allocator>& a, aligned_matrix<T, Allocator>& b) noexcept
+{
+  a.swap(b);
+}
+
+#endif
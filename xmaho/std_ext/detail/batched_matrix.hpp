@@ -0,0 +1,351 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_BATCHED_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_BATCHED_MATRIX_H
+
+#include "../batched_matrix.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace xmaho::std_ext::detail
+{
+
+/**
+ * @brief Solve "a x = b" in place for interleaved matrices.
+ *
+ * a is n x n and b is n x m for each of batch matrices.
+ * Each loop over the batch is independent, so compiler may vectorize it.
+ */
+template<typename T>
+void batched_solve(std::size_t batch, std::size_t n, std::size_t m, T* a, T* b)
+{
+  const auto a_lane = [a, batch, n](std::size_t r, std::size_t c) {return a + (r * n + c) * batch;};
+  const auto b_lane = [b, batch, m](std::size_t r, std::size_t c) {return b + (r * m + c) * batch;};
+  std::vector<std::size_t> pivot(batch);
+  std::vector<T> largest(batch);
+  std::vector<T> factor(batch);
+  for (std::size_t k {0}; k < n; ++k) {
+    const auto diagonal {a_lane(k, k)};
+    for (std::size_t l {0}; l < batch; ++l) {
+      pivot[l] = k;
+      largest[l] = std::abs(diagonal[l]);
+    }
+    for (auto i {k + 1}; i < n; ++i) {
+      const auto column {a_lane(i, k)};
+      for (std::size_t l {0}; l < batch; ++l)
+        if (std::abs(column[l]) > largest[l]) {
+          largest[l] = std::abs(column[l]);
+          pivot[l] = i;
+        }
+    }
+    for (std::size_t l {0}; l < batch; ++l) {
+      if (!(largest[l] > T{0}))
+        throw std::domain_error {"xmaho::std_ext::solve : matrix is singular"};
+      if (pivot[l] != k) {
+        for (auto c {k}; c < n; ++c)
+          std::swap(a_lane(k, c)[l], a_lane(pivot[l], c)[l]);
+        for (std::size_t c {0}; c < m; ++c)
+          std::swap(b_lane(k, c)[l], b_lane(pivot[l], c)[l]);
+      }
+    }
+    for (auto i {k + 1}; i < n; ++i) {
+      const auto column {a_lane(i, k)};
+      for (std::size_t l {0}; l < batch; ++l)
+        factor[l] = column[l] / diagonal[l];
+      for (auto c {k + 1}; c < n; ++c) {
+        const auto dst {a_lane(i, c)};
+        const auto src {a_lane(k, c)};
+        for (std::size_t l {0}; l < batch; ++l)
+          dst[l] -= factor[l] * src[l];
+      }
+      for (std::size_t c {0}; c < m; ++c) {
+        const auto dst {b_lane(i, c)};
+        const auto src {b_lane(k, c)};
+        for (std::size_t l {0}; l < batch; ++l)
+          dst[l] -= factor[l] * src[l];
+      }
+    }
+  }
+  for (auto i {n}; i-- > 0;)
+    for (std::size_t c {0}; c < m; ++c) {
+      const auto x {b_lane(i, c)};
+      for (auto j {i + 1}; j < n; ++j) {
+        const auto coefficient {a_lane(i, j)};
+        const auto solved {b_lane(j, c)};
+        for (std::size_t l {0}; l < batch; ++l)
+          x[l] -= coefficient[l] * solved[l];
+      }
+      const auto diagonal {a_lane(i, i)};
+      for (std::size_t l {0}; l < batch; ++l)
+        x[l] /= diagonal[l];
+    }
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>::batched_matrix(size_type batch_size, size_type row_size, size_type col_size)
+  : values_(batch_size * row_size * col_size),
+    batch_size_ {batch_size},
+    size_ {detail::get_init_size(row_size, col_size)}
+{
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>::batched_matrix(const T& value, size_type batch_size, size_type row_size, size_type col_size)
+  : values_(value, batch_size * row_size * col_size),
+    batch_size_ {batch_size},
+    size_ {detail::get_init_size(row_size, col_size)}
+{
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>::batched_matrix(const std::vector<valmatrix<T>>& matrices)
+  : batched_matrix(matrices.size(),
+                   matrices.empty() ? 0 : matrices.front().row_size(),
+                   matrices.empty() ? 0 : matrices.front().col_size())
+{
+  for (size_type i {0}; i < matrices.size(); ++i)
+    assign(i, matrices[i]);
+}
+
+template<typename T>
+const T& xmaho::std_ext::batched_matrix<T>::operator()(size_type index, position_type position) const
+{
+  assert(index < batch_size());
+  return lane(position)[index];
+}
+
+template<typename T>
+T& xmaho::std_ext::batched_matrix<T>::operator()(size_type index, position_type position)
+{
+  assert(index < batch_size());
+  return lane(position)[index];
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::batched_matrix<T>::extract(size_type index) const
+{
+  assert(index < batch_size());
+  return valmatrix<T>{values_[std::slice{index, size_.first * size_.second, batch_size_}], size_.first, size_.second};
+}
+
+template<typename T>
+void xmaho::std_ext::batched_matrix<T>::assign(size_type index, const valmatrix<T>& m)
+{
+  assert(index < batch_size());
+  assert(m.row_size() == row_size());
+  assert(m.col_size() == col_size());
+  const auto first {data() + index};
+  for (size_type i {0}; i < m.size(); ++i)
+    first[i * batch_size_] = m[i];
+}
+
+template<typename T>
+const T* xmaho::std_ext::batched_matrix<T>::lane(position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return data() + row_major::index(position, size_) * batch_size_;
+}
+
+template<typename T>
+T* xmaho::std_ext::batched_matrix<T>::lane(position_type position)
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return data() + row_major::index(position, size_) * batch_size_;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator+=(const batched_matrix& rhs) &
+{
+  assert(rhs.batch_size_ == batch_size_ && rhs.size_ == size_);
+  detail::elementwise_apply(data(), rhs.data(), size(), std::plus<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator+=(const T& rhs) &
+{
+  detail::elementwise_apply_value(data(), rhs, size(), std::plus<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator-=(const batched_matrix& rhs) &
+{
+  assert(rhs.batch_size_ == batch_size_ && rhs.size_ == size_);
+  detail::elementwise_apply(data(), rhs.data(), size(), std::minus<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator-=(const T& rhs) &
+{
+  detail::elementwise_apply_value(data(), rhs, size(), std::minus<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator*=(const batched_matrix& rhs) &
+{
+  assert(rhs.batch_size_ == batch_size_ && rhs.size_ == size_);
+  detail::elementwise_apply(data(), rhs.data(), size(), std::multiplies<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator*=(const T& rhs) &
+{
+  detail::elementwise_apply_value(data(), rhs, size(), std::multiplies<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator/=(const batched_matrix& rhs) &
+{
+  assert(rhs.batch_size_ == batch_size_ && rhs.size_ == size_);
+  detail::elementwise_apply(data(), rhs.data(), size(), std::divides<>{});
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T>& xmaho::std_ext::batched_matrix<T>::operator/=(const T& rhs) &
+{
+  detail::elementwise_apply_value(data(), rhs, size(), std::divides<>{});
+  return *this;
+}
+
+template<typename T>
+typename xmaho::std_ext::batched_matrix<T>::size_type xmaho::std_ext::batched_matrix<T>::batch_size() const noexcept
+{
+  return batch_size_;
+}
+
+template<typename T>
+typename xmaho::std_ext::batched_matrix<T>::size_type xmaho::std_ext::batched_matrix<T>::row_size() const noexcept
+{
+  return size_.first;
+}
+
+template<typename T>
+typename xmaho::std_ext::batched_matrix<T>::size_type xmaho::std_ext::batched_matrix<T>::col_size() const noexcept
+{
+  return size_.second;
+}
+
+template<typename T>
+typename xmaho::std_ext::batched_matrix<T>::size_type xmaho::std_ext::batched_matrix<T>::size() const noexcept
+{
+  return values_.size();
+}
+
+template<typename T>
+const T* xmaho::std_ext::batched_matrix<T>::data() const noexcept
+{
+  return detail::valarray_data(values_);
+}
+
+template<typename T>
+T* xmaho::std_ext::batched_matrix<T>::data() noexcept
+{
+  return detail::valarray_data(values_);
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::operator+(batched_matrix<T> lhs, const batched_matrix<T>& rhs)
+{
+  return lhs += rhs;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::operator-(batched_matrix<T> lhs, const batched_matrix<T>& rhs)
+{
+  return lhs -= rhs;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::operator*(batched_matrix<T> lhs, const batched_matrix<T>& rhs)
+{
+  return lhs *= rhs;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::operator*(batched_matrix<T> lhs, const T& rhs)
+{
+  return lhs *= rhs;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::operator/(batched_matrix<T> lhs, const batched_matrix<T>& rhs)
+{
+  return lhs /= rhs;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::matmul(const batched_matrix<T>& a, const batched_matrix<T>& b)
+{
+  assert(a.batch_size() == b.batch_size());
+  assert(a.row_size() == b.col_size());
+  const auto batch {a.batch_size()};
+  const auto rows {a.col_size()};
+  const auto inner {a.row_size()};
+  const auto cols {b.row_size()};
+  batched_matrix<T> result {batch, cols, rows};
+  // Walk the batch in blocks so that the lanes of all three operands stay in cache.
+  constexpr std::size_t block {256};
+  for (std::size_t first {0}; first < batch; first += block) {
+    const auto count {std::min(block, batch - first)};
+    for (std::size_t i {0}; i < rows; ++i)
+      for (std::size_t k {0}; k < inner; ++k) {
+        const auto lhs {a.lane({k, i}) + first};
+        for (std::size_t j {0}; j < cols; ++j)
+          detail::multiply_accumulate(result.lane({j, i}) + first, lhs, b.lane({j, k}) + first, count);
+      }
+  }
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::batched_matrix<T> xmaho::std_ext::solve(batched_matrix<T> a, batched_matrix<T> b)
+{
+  assert(a.batch_size() == b.batch_size());
+  assert(a.row_size() == a.col_size());
+  assert(b.col_size() == a.col_size());
+  detail::batched_solve(a.batch_size(), a.col_size(), b.row_size(), a.data(), b.data());
+  return b;
+}
+
+#endif
@@ -0,0 +1,354 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_BITMATRIX_H
+#define XMAHO_STD_EXT_DETAIL_BITMATRIX_H
+
+#include "../bitmatrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace xmaho::std_ext::detail
+{
+
+inline std::size_t popcount(std::uint64_t word) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  word -= (word >> 1) & 0x5555555555555555u;
+  word = (word & 0x3333333333333333u) + ((word >> 2) & 0x3333333333333333u);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fu;
+  return static_cast<std::size_t>((word * 0x0101010101010101u) >> 56);
+#endif
+}
+
+inline std::size_t word_count(std::size_t bits) noexcept
+{
+  return (bits + xmaho::std_ext::bitmatrix::word_bits - 1) / xmaho::std_ext::bitmatrix::word_bits;
+}
+
+inline std::uint64_t bit_mask(std::size_t index) noexcept
+{
+  return std::uint64_t{1} << (index % xmaho::std_ext::bitmatrix::word_bits);
+}
+
+}
+
+inline xmaho::std_ext::bitmatrix::bitmatrix(size_type row_size, size_type col_size)
+  : size_ {detail::get_init_size(row_size, col_size)},
+    row_words_ {detail::word_count(size_.first)}
+{
+  words_.resize(row_words_ * size_.second);
+}
+
+inline xmaho::std_ext::bitmatrix::bitmatrix(bool value, size_type row_size, size_type col_size)
+  : bitmatrix(row_size, col_size)
+{
+  *this = value;
+}
+
+inline xmaho::std_ext::bitmatrix::bitmatrix(const valmatrix<bool>& m)
+  : bitmatrix(m.row_size(), m.col_size())
+{
+  const bool* source {m.data()};
+  for (size_type y {0}; y < size_.second; ++y) {
+    word_type* const line {words_.data() + y * row_words_};
+    for (size_type x {0}; x < size_.first; ++x) {
+      if (source[x])
+        line[x / word_bits] |= detail::bit_mask(x);
+    }
+    source += size_.first;
+  }
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator=(bool rhs) &
+{
+  std::fill(words_.begin(), words_.end(), rhs ? ~word_type{0} : word_type{0});
+  clear_padding();
+  return *this;
+}
+
+inline bool xmaho::std_ext::bitmatrix::operator[](position_type position) const
+{
+  return test(position);
+}
+
+inline bool xmaho::std_ext::bitmatrix::test(position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return (words_[position.second * row_words_ + position.first / word_bits] & detail::bit_mask(position.first)) != 0;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::set(position_type position, bool value)
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  word_type& word {words_[position.second * row_words_ + position.first / word_bits]};
+  if (value)
+    word |= detail::bit_mask(position.first);
+  else
+    word &= ~detail::bit_mask(position.first);
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::reset(position_type position)
+{
+  return set(position, false);
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::flip(position_type position)
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  words_[position.second * row_words_ + position.first / word_bits] ^= detail::bit_mask(position.first);
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::flip() noexcept
+{
+  for (auto& word : words_)
+    word = ~word;
+  clear_padding();
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator&=(const bitmatrix& rhs) &
+{
+  assert(row_size() == rhs.row_size());
+  assert(col_size() == rhs.col_size());
+  const word_type* const source {rhs.words_.data()};
+  for (size_type i {0}; i < words_.size(); ++i)
+    words_[i] &= source[i];
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator|=(const bitmatrix& rhs) &
+{
+  assert(row_size() == rhs.row_size());
+  assert(col_size() == rhs.col_size());
+  const word_type* const source {rhs.words_.data()};
+  for (size_type i {0}; i < words_.size(); ++i)
+    words_[i] |= source[i];
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator^=(const bitmatrix& rhs) &
+{
+  assert(row_size() == rhs.row_size());
+  assert(col_size() == rhs.col_size());
+  const word_type* const source {rhs.words_.data()};
+  for (size_type i {0}; i < words_.size(); ++i)
+    words_[i] ^= source[i];
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator&=(bool rhs) &
+{
+  if (!rhs)
+    *this = false;
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator|=(bool rhs) &
+{
+  if (rhs)
+    *this = true;
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix& xmaho::std_ext::bitmatrix::operator^=(bool rhs) &
+{
+  if (rhs)
+    flip();
+  return *this;
+}
+
+inline xmaho::std_ext::bitmatrix xmaho::std_ext::bitmatrix::operator!() const
+{
+  bitmatrix result {*this};
+  result.flip();
+  return result;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::sum() const noexcept
+{
+  size_type count {0};
+  for (const auto word : words_)
+    count += detail::popcount(word);
+  return count;
+}
+
+inline bool xmaho::std_ext::bitmatrix::any() const noexcept
+{
+  return std::any_of(words_.begin(), words_.end(), [](word_type word) { return word != 0; });
+}
+
+inline bool xmaho::std_ext::bitmatrix::all() const noexcept
+{
+  return sum() == size();
+}
+
+inline std::valarray<bool> xmaho::std_ext::bitmatrix::row(size_type index) const
+{
+  assert(index < col_size());
+  std::valarray<bool> result(size_.first);
+  const word_type* const line {words_.data() + index * row_words_};
+  for (size_type w {0}; w < row_words_; ++w) {
+    const size_type first {w * word_bits};
+    const size_type last {std::min(first + word_bits, size_.first)};
+    word_type word {line[w]};
+    for (size_type x {first}; x < last; ++x) {
+      result[x] = (word & 1u) != 0;
+      word >>= 1;
+    }
+  }
+  return result;
+}
+
+inline std::valarray<bool> xmaho::std_ext::bitmatrix::col(size_type index) const
+{
+  assert(index < row_size());
+  std::valarray<bool> result(size_.second);
+  const word_type* word {words_.data() + index / word_bits};
+  const word_type mask {detail::bit_mask(index)};
+  for (size_type y {0}; y < size_.second; ++y) {
+    result[y] = (*word & mask) != 0;
+    word += row_words_;
+  }
+  return result;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::row_sum(size_type index) const
+{
+  assert(index < col_size());
+  const word_type* const line {words_.data() + index * row_words_};
+  size_type count {0};
+  for (size_type w {0}; w < row_words_; ++w)
+    count += detail::popcount(line[w]);
+  return count;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::row_size() const noexcept
+{
+  return size_.first;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::col_size() const noexcept
+{
+  return size_.second;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::size() const noexcept
+{
+  return size_.first * size_.second;
+}
+
+inline xmaho::std_ext::bitmatrix::size_type xmaho::std_ext::bitmatrix::row_words() const noexcept
+{
+  return row_words_;
+}
+
+inline const xmaho::std_ext::bitmatrix::word_type* xmaho::std_ext::bitmatrix::data() const noexcept
+{
+  return words_.empty() ? nullptr : words_.data();
+}
+
+inline xmaho::std_ext::bitmatrix::word_type* xmaho::std_ext::bitmatrix::data() noexcept
+{
+  return words_.empty() ? nullptr : words_.data();
+}
+
+inline void xmaho::std_ext::bitmatrix::swap(bitmatrix& other) noexcept
+{
+  using std::swap;
+  swap(words_, other.words_);
+  swap(size_, other.size_);
+  swap(row_words_, other.row_words_);
+}
+
+inline void xmaho::std_ext::bitmatrix::clear_padding() noexcept
+{
+  const size_type tail {size_.first % word_bits};
+  if (!tail)
+    return;
+  const word_type mask {(word_type{1} << tail) - 1};
+  for (size_type i {row_words_ - 1}; i < words_.size(); i += row_words_)
+    words_[i] &= mask;
+}
+
+inline xmaho::std_ext::bitmatrix xmaho::std_ext::operator&(bitmatrix lhs, const bitmatrix& rhs)
+{
+  lhs &= rhs;
+  return lhs;
+}
+
+inline xmaho::std_ext::bitmatrix xmaho::std_ext::operator|(bitmatrix lhs, const bitmatrix& rhs)
+{
+  lhs |= rhs;
+  return lhs;
+}
+
+inline xmaho::std_ext::bitmatrix xmaho::std_ext::operator^(bitmatrix lhs, const bitmatrix& rhs)
+{
+  lhs ^= rhs;
+  return lhs;
+}
+
+inline bool xmaho::std_ext::operator==(const bitmatrix& lhs, const bitmatrix& rhs) noexcept
+{
+  if (lhs.row_size() != rhs.row_size() || lhs.col_size() != rhs.col_size())
+    return false;
+  return std::equal(lhs.data(), lhs.data() + lhs.row_words() * lhs.col_size(), rhs.data());
+}
+
+inline bool xmaho::std_ext::operator!=(const bitmatrix& lhs, const bitmatrix& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline xmaho::std_ext::valmatrix<bool> xmaho::std_ext::to_valmatrix(const bitmatrix& m)
+{
+  valmatrix<bool> result(m.row_size(), m.col_size());
+  bool* destination {result.data()};
+  for (bitmatrix::size_type y {0}; y < m.col_size(); ++y) {
+    const std::valarray<bool> line {m.row(y)};
+    std::copy(std::begin(line), std::end(line), destination);
+    destination += m.row_size();
+  }
+  return result;
+}
+
+inline void xmaho::std_ext::swap(bitmatrix& a, bitmatrix& b) noexcept
+{
+  a.swap(b);
+}
+
+#endif
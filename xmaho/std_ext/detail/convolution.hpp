@@ -0,0 +1,265 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_CONVOLUTION_H
+#define XMAHO_STD_EXT_DETAIL_CONVOLUTION_H
+
+#include "../convolution.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Count of output elements per tile. Tile and taps of source rows stay in L1 cache.
+constexpr std::size_t convolution_tile_size {512};
+
+//! @brief Count of output rows per pass of separable convolution.
+constexpr std::size_t convolution_band_size {32};
+
+/**
+ * @brief Map index of extended source to index of source.
+ *
+ * @return n if the element is zero.
+ */
+inline std::size_t border_index(std::ptrdiff_t index, std::size_t n, border_mode border) noexcept
+{
+  const auto size {static_cast<std::ptrdiff_t>(n)};
+  if (0 <= index && index < size)
+    return static_cast<std::size_t>(index);
+  switch (border) {
+  case border_mode::zero:
+    return n;
+  case border_mode::clamp:
+    return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(index, 0, size - 1));
+  case border_mode::wrap:
+    return static_cast<std::size_t>((index % size + size) % size);
+  }
+  return n;
+}
+
+/**
+ * @brief Copy matrix with halo of (x_radius, y_radius) elements.
+ */
+template<typename T>
+valmatrix<T> make_halo(const valmatrix<T>& m, std::size_t x_radius, std::size_t y_radius, border_mode border)
+{
+  const auto cols {m.row_size()};
+  const auto rows {m.col_size()};
+  const auto padded_cols {cols + 2 * x_radius};
+  valmatrix<T> padded(padded_cols, rows + 2 * y_radius);
+  std::vector<std::size_t> x_index(padded_cols);
+  for (std::size_t x {0}; x < padded_cols; ++x)
+    x_index[x] = border_index(static_cast<std::ptrdiff_t>(x) - static_cast<std::ptrdiff_t>(x_radius), cols, border);
+  const auto src {m.data()};
+  const auto dst {padded.data()};
+  for (std::size_t y {0}; y < padded.col_size(); ++y) {
+    const auto row_index {border_index(static_cast<std::ptrdiff_t>(y) - static_cast<std::ptrdiff_t>(y_radius), rows, border)};
+    if (row_index == rows)
+      continue;
+    const auto row {src + row_index * cols};
+    const auto out {dst + y * padded_cols};
+    for (std::size_t x {0}; x < x_radius; ++x) {
+      if (x_index[x] != cols)
+        out[x] = row[x_index[x]];
+      if (x_index[padded_cols - 1 - x] != cols)
+        out[padded_cols - 1 - x] = row[x_index[padded_cols - 1 - x]];
+    }
+    std::copy_n(row, cols, out + x_radius);
+  }
+  return padded;
+}
+
+/**
+ * @brief Call "function(begin, end)" for bands of rows.
+ *
+ * Band i is processed by thread i.
+ * Without context or under grain size, all rows are processed by the calling thread.
+ */
+template<typename F>
+void for_row_bands(parallel_context* context, std::size_t rows, std::size_t cols, F function)
+{
+  const auto count {context
+    ? std::clamp<std::size_t>(rows * cols / std::max<std::size_t>(context->grain_size(), 1), 1, std::min(context->thread_count(), rows))
+    : 1};
+  if (count == 1) {
+    function(std::size_t {0}, rows);
+    return;
+  }
+  context->run([rows, count, &function](std::size_t band) {
+    if (band < count)
+      function(rows * band / count, rows * (band + 1) / count);
+  });
+}
+
+template<typename T>
+std::valarray<T> reversed_kernel(const std::valarray<T>& kernel)
+{
+  std::valarray<T> result(kernel.size());
+  std::reverse_copy(std::begin(kernel), std::end(kernel), std::begin(result));
+  return result;
+}
+
+template<typename T>
+valmatrix<T> convolve(parallel_context* context, const valmatrix<T>& m, const valmatrix<T>& kernel, border_mode border)
+{
+  const auto width {kernel.row_size()};
+  const auto height {kernel.col_size()};
+  assert(width % 2 == 1 && height % 2 == 1);
+  const auto cols {m.row_size()};
+  valmatrix<T> result(cols, m.col_size());
+  if (!m.size())
+    return result;
+  // Convolution is correlation with the kernel rotated by 180 degrees, that is reversed storage.
+  const auto taps {reversed_kernel(std::valarray<T>(kernel.data(), kernel.size()))};
+  const auto padded {make_halo(m, width / 2, height / 2, border)};
+  const auto padded_cols {padded.row_size()};
+  const auto src {padded.data()};
+  const auto dst {result.data()};
+  for_row_bands(context, m.col_size(), cols, [&](std::size_t begin, std::size_t end) {
+    for (auto y {begin}; y < end; ++y)
+      for (std::size_t x {0}; x < cols; x += convolution_tile_size) {
+        const auto n {std::min(convolution_tile_size, cols - x)};
+        const auto out {dst + y * cols + x};
+        for (std::size_t j {0}; j < height; ++j) {
+          const auto row {src + (y + j) * padded_cols + x};
+          for (std::size_t i {0}; i < width; ++i)
+            multiply_accumulate_value(out, row + i, taps[j * width + i], n);
+        }
+      }
+  });
+  return result;
+}
+
+template<typename T>
+valmatrix<T> convolve_separable(parallel_context* context, const valmatrix<T>& m, const std::valarray<T>& row_kernel, const std::valarray<T>& col_kernel, border_mode border)
+{
+  const auto width {row_kernel.size()};
+  const auto height {col_kernel.size()};
+  assert(width % 2 == 1 && height % 2 == 1);
+  const auto cols {m.row_size()};
+  valmatrix<T> result(cols, m.col_size());
+  if (!m.size())
+    return result;
+  const auto row_taps {reversed_kernel(row_kernel)};
+  const auto col_taps {reversed_kernel(col_kernel)};
+  const auto padded {make_halo(m, width / 2, height / 2, border)};
+  const auto padded_cols {padded.row_size()};
+  const auto src {padded.data()};
+  const auto dst {result.data()};
+  for_row_bands(context, m.col_size(), cols, [&](std::size_t begin, std::size_t end) {
+    // Rows convolved along the row are kept only for the current pass with its halo rows.
+    std::vector<T> buffer((convolution_band_size + height - 1) * cols);
+    for (auto first {begin}; first < end; first += convolution_band_size) {
+      const auto last {std::min(first + convolution_band_size, end)};
+      std::fill(buffer.begin(), buffer.end(), T{});
+      for (std::size_t k {0}; k < last - first + height - 1; ++k) {
+        const auto row {src + (first + k) * padded_cols};
+        for (std::size_t i {0}; i < width; ++i)
+          multiply_accumulate_value(buffer.data() + k * cols, row + i, row_taps[i], cols);
+      }
+      for (auto y {first}; y < last; ++y)
+        for (std::size_t j {0}; j < height; ++j)
+          multiply_accumulate_value(dst + y * cols, buffer.data() + (y - first + j) * cols, col_taps[j], cols);
+    }
+  });
+  return result;
+}
+
+template<typename T, typename Op>
+valmatrix<T> stencil(parallel_context* context, const valmatrix<T>& m, typename valmatrix<T>::position_type size, Op op, border_mode border)
+{
+  const auto [width, height] {size};
+  assert(width % 2 == 1 && height % 2 == 1);
+  const auto cols {m.row_size()};
+  valmatrix<T> result(cols, m.col_size());
+  if (!m.size())
+    return result;
+  const auto padded {make_halo(m, width / 2, height / 2, border)};
+  const auto padded_cols {padded.row_size()};
+  const auto src {padded.data()};
+  const auto dst {result.data()};
+  for_row_bands(context, m.col_size(), cols, [&](std::size_t begin, std::size_t end) {
+    for (auto y {begin}; y < end; ++y)
+      for (std::size_t x {0}; x < cols; x += convolution_tile_size) {
+        const auto n {std::min(convolution_tile_size, cols - x)};
+        const auto out {dst + y * cols + x};
+        std::copy_n(src + y * padded_cols + x, n, out);
+        for (std::size_t j {0}; j < height; ++j) {
+          const auto row {src + (y + j) * padded_cols + x};
+          for (std::size_t i {j ? 0u : 1u}; i < width; ++i)
+            elementwise_apply(out, row + i, n, op);
+        }
+      }
+  });
+  return result;
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::convolve(const valmatrix<T>& m, const valmatrix<T>& kernel, border_mode border)
+{
+  return detail::convolve(nullptr, m, kernel, border);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::convolve(parallel_context& context, const valmatrix<T>& m, const valmatrix<T>& kernel, border_mode border)
+{
+  return detail::convolve(&context, m, kernel, border);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::convolve_separable(const valmatrix<T>& m, const std::valarray<T>& row_kernel, const std::valarray<T>& col_kernel, border_mode border)
+{
+  return detail::convolve_separable(nullptr, m, row_kernel, col_kernel, border);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::convolve_separable(parallel_context& context, const valmatrix<T>& m, const std::valarray<T>& row_kernel, const std::valarray<T>& col_kernel, border_mode border)
+{
+  return detail::convolve_separable(&context, m, row_kernel, col_kernel, border);
+}
+
+template<typename T, typename Op>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::stencil(const valmatrix<T>& m, typename valmatrix<T>::position_type size, Op op, border_mode border)
+{
+  return detail::stencil(nullptr, m, size, op, border);
+}
+
+template<typename T, typename Op>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::stencil(parallel_context& context, const valmatrix<T>& m, typename valmatrix<T>::position_type size, Op op, border_mode border)
+{
+  return detail::stencil(&context, m, size, op, border);
+}
+
+#endif
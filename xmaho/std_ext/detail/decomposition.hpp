@@ -0,0 +1,430 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_DECOMPOSITION_H
+#define XMAHO_STD_EXT_DETAIL_DECOMPOSITION_H
+
+#include "../decomposition.hpp"
+#include "../matmul.hpp"
+#include "elementwise.hpp"
+#include "strided_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Count of columns factorized before each trailing update.
+constexpr std::size_t decomposition_block_size {64};
+
+/**
+ * @brief Solve "L X = B" in place.
+ *
+ * Rows of B are updated by contiguous axpy.
+ *
+ * @param[in] l Lower triangular matrix.
+ * @param[in] unit Treat diagonal of l as one.
+ * @param[in,out] b Right hand side, overwritten by X.
+ */
+template<typename T>
+void solve_lower(strided_matrix<const T> l, bool unit, strided_matrix<T> b)
+{
+  for (std::size_t i {0}; i < b.rows; ++i) {
+    for (std::size_t p {0}; p < i; ++p) {
+      const auto factor {l(i, p)};
+      for (std::size_t j {0}; j < b.cols; ++j)
+        b(i, j) -= factor * b(p, j);
+    }
+    if (!unit) {
+      const auto diagonal {l(i, i)};
+      for (std::size_t j {0}; j < b.cols; ++j)
+        b(i, j) /= diagonal;
+    }
+  }
+}
+
+/**
+ * @brief Solve "U X = B" in place.
+ *
+ * @param[in] u Upper triangular matrix.
+ * @param[in,out] b Right hand side, overwritten by X.
+ */
+template<typename T>
+void solve_upper(strided_matrix<const T> u, strided_matrix<T> b)
+{
+  for (auto i {b.rows}; i-- > 0;) {
+    for (auto p {i + 1}; p < b.rows; ++p) {
+      const auto factor {u(i, p)};
+      for (std::size_t j {0}; j < b.cols; ++j)
+        b(i, j) -= factor * b(p, j);
+    }
+    const auto diagonal {u(i, i)};
+    for (std::size_t j {0}; j < b.cols; ++j)
+      b(i, j) /= diagonal;
+  }
+}
+
+/**
+ * @brief Apply Householder reflector "I - tau v v^T" to rows of b from the left.
+ *
+ * v is stored under row j of column j of a with unit leading element.
+ */
+template<typename T>
+void apply_reflector(strided_matrix<const T> a, std::size_t j, const T& tau, strided_matrix<T> b, std::vector<T>& work)
+{
+  work.assign(b.cols, T{});
+  for (std::size_t c {0}; c < b.cols; ++c)
+    work[c] = b(j, c);
+  for (auto i {j + 1}; i < b.rows; ++i) {
+    const auto v {a(i, j)};
+    for (std::size_t c {0}; c < b.cols; ++c)
+      work[c] += v * b(i, c);
+  }
+  for (std::size_t c {0}; c < b.cols; ++c) {
+    work[c] *= tau;
+    b(j, c) -= work[c];
+  }
+  for (auto i {j + 1}; i < b.rows; ++i) {
+    const auto v {a(i, j)};
+    for (std::size_t c {0}; c < b.cols; ++c)
+      b(i, c) -= v * work[c];
+  }
+}
+
+/**
+ * @brief Check diagonal of R against rounding error of the factorization.
+ */
+template<typename T>
+bool is_rank_deficient(strided_matrix<const T> r)
+{
+  T largest {};
+  for (std::size_t j {0}; j < r.cols; ++j)
+    largest = std::max(largest, std::abs(r(j, j)));
+  const auto tolerance {largest * std::numeric_limits<T>::epsilon() * static_cast<T>(r.rows)};
+  for (std::size_t j {0}; j < r.cols; ++j)
+    if (!(std::abs(r(j, j)) > tolerance))
+      return true;
+  return false;
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::lu_decomposition<T>::lu_decomposition(valmatrix<T> a)
+  : lu_ {std::move(a)},
+    pivots_(lu_.col_size())
+{
+  assert(lu_.row_size() == lu_.col_size());
+  const auto n {order()};
+  const auto m {detail::make_strided(lu_)};
+  for (std::size_t k {0}; k < n; k += detail::decomposition_block_size) {
+    const auto kb {std::min(detail::decomposition_block_size, n - k)};
+    for (auto j {k}; j < k + kb; ++j) {
+      auto pivot {j};
+      for (auto i {j + 1}; i < n; ++i)
+        if (std::abs(m(i, j)) > std::abs(m(pivot, j)))
+          pivot = i;
+      if (!(std::abs(m(pivot, j)) > T{0}))
+        throw std::domain_error {"xmaho::std_ext::lu_decomposition::lu_decomposition : matrix is singular"};
+      pivots_[j] = pivot;
+      if (pivot != j) {
+        std::swap_ranges(&m(j, 0), &m(j, 0) + n, &m(pivot, 0));
+        odd_ = !odd_;
+      }
+      const auto diagonal {m(j, j)};
+      for (auto i {j + 1}; i < n; ++i) {
+        const auto factor {m(i, j) /= diagonal};
+        for (auto c {j + 1}; c < k + kb; ++c)
+          m(i, c) -= factor * m(j, c);
+      }
+    }
+    if (k + kb == n)
+      break;
+    const auto rest {n - k - kb};
+    detail::solve_lower(detail::to_const(m.sub(k, k, kb, kb)), true, m.sub(k, k + kb, kb, rest));
+    detail::gemm(T{-1}, detail::to_const(m.sub(k + kb, k, rest, kb)), detail::to_const(m.sub(k, k + kb, kb, rest)), true, m.sub(k + kb, k + kb, rest, rest));
+  }
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::lu_decomposition<T>::solve(std::valarray<T> b) const
+{
+  assert(b.size() == order());
+  for (std::size_t i {0}; i < pivots_.size(); ++i)
+    std::swap(b[i], b[pivots_[i]]);
+  const auto x {detail::make_strided(detail::valarray_data(b), b.size(), 1)};
+  detail::solve_lower(detail::make_strided(lu_), true, x);
+  detail::solve_upper(detail::make_strided(lu_), x);
+  return b;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::lu_decomposition<T>::solve(valmatrix<T> b) const
+{
+  assert(b.col_size() == order());
+  const auto x {detail::make_strided(b)};
+  for (std::size_t i {0}; i < pivots_.size(); ++i)
+    if (pivots_[i] != i)
+      std::swap_ranges(&x(i, 0), &x(i, 0) + x.cols, &x(pivots_[i], 0));
+  detail::solve_lower(detail::make_strided(lu_), true, x);
+  detail::solve_upper(detail::make_strided(lu_), x);
+  return b;
+}
+
+template<typename T>
+T xmaho::std_ext::lu_decomposition<T>::determinant() const noexcept
+{
+  T result {odd_ ? T{-1} : T{1}};
+  for (std::size_t i {0}; i < order(); ++i)
+    result *= lu_[i * order() + i];
+  return result;
+}
+
+template<typename T>
+typename xmaho::std_ext::lu_decomposition<T>::size_type xmaho::std_ext::lu_decomposition<T>::order() const noexcept
+{
+  return lu_.col_size();
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::lu_decomposition<T>::matrix() const noexcept
+{
+  return lu_;
+}
+
+template<typename T>
+const std::vector<typename xmaho::std_ext::lu_decomposition<T>::size_type>& xmaho::std_ext::lu_decomposition<T>::pivots() const noexcept
+{
+  return pivots_;
+}
+
+template<typename T>
+xmaho::std_ext::cholesky_decomposition<T>::cholesky_decomposition(valmatrix<T> a)
+  : l_ {std::move(a)}
+{
+  assert(l_.row_size() == l_.col_size());
+  const auto n {order()};
+  const auto m {detail::make_strided(l_)};
+  for (std::size_t k {0}; k < n; k += detail::decomposition_block_size) {
+    const auto kb {std::min(detail::decomposition_block_size, n - k)};
+    for (auto j {k}; j < k + kb; ++j) {
+      auto diagonal {m(j, j)};
+      for (auto p {k}; p < j; ++p)
+        diagonal -= m(j, p) * m(j, p);
+      if (!(diagonal > T{0}))
+        throw std::domain_error {"xmaho::std_ext::cholesky_decomposition::cholesky_decomposition : matrix is not positive definite"};
+      m(j, j) = std::sqrt(diagonal);
+      for (auto i {j + 1}; i < k + kb; ++i) {
+        auto value {m(i, j)};
+        for (auto p {k}; p < j; ++p)
+          value -= m(i, p) * m(j, p);
+        m(i, j) = value / m(j, j);
+      }
+    }
+    if (k + kb == n)
+      break;
+    const auto rest {n - k - kb};
+    for (auto r {k + kb}; r < n; ++r)
+      for (auto i {k}; i < k + kb; ++i) {
+        auto value {m(r, i)};
+        for (auto p {k}; p < i; ++p)
+          value -= m(r, p) * m(i, p);
+        m(r, i) = value / m(i, i);
+      }
+    const auto l21 {detail::to_const(m.sub(k + kb, k, rest, kb))};
+    detail::gemm(T{-1}, l21, l21.transposed(), true, m.sub(k + kb, k + kb, rest, rest));
+  }
+  for (std::size_t i {0}; i < n; ++i)
+    std::fill(&m(i, 0) + i + 1, &m(i, 0) + n, T{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::cholesky_decomposition<T>::solve(std::valarray<T> b) const
+{
+  assert(b.size() == order());
+  const auto x {detail::make_strided(detail::valarray_data(b), b.size(), 1)};
+  detail::solve_lower(detail::make_strided(l_), false, x);
+  detail::solve_upper(detail::make_strided(l_).transposed(), x);
+  return b;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::cholesky_decomposition<T>::solve(valmatrix<T> b) const
+{
+  assert(b.col_size() == order());
+  const auto x {detail::make_strided(b)};
+  detail::solve_lower(detail::make_strided(l_), false, x);
+  detail::solve_upper(detail::make_strided(l_).transposed(), x);
+  return b;
+}
+
+template<typename T>
+typename xmaho::std_ext::cholesky_decomposition<T>::size_type xmaho::std_ext::cholesky_decomposition<T>::order() const noexcept
+{
+  return l_.col_size();
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::cholesky_decomposition<T>::matrix() const noexcept
+{
+  return l_;
+}
+
+template<typename T>
+xmaho::std_ext::qr_decomposition<T>::qr_decomposition(valmatrix<T> a)
+  : qr_ {std::move(a)},
+    tau_(qr_.row_size())
+{
+  assert(qr_.col_size() >= qr_.row_size());
+  const auto rows {qr_.col_size()};
+  const auto cols {qr_.row_size()};
+  const auto m {detail::make_strided(qr_)};
+  std::vector<T> work {};
+  std::vector<T> v {};
+  std::vector<T> t {};
+  std::vector<T> w {};
+  for (std::size_t k {0}; k < cols; k += detail::decomposition_block_size) {
+    const auto kb {std::min(detail::decomposition_block_size, cols - k)};
+    for (auto j {k}; j < k + kb; ++j) {
+      T norm {};
+      for (auto i {j + 1}; i < rows; ++i)
+        norm += m(i, j) * m(i, j);
+      if (!(norm > T{0})) {
+        tau_[j] = T{};
+        continue;
+      }
+      const auto alpha {m(j, j)};
+      const auto beta {-std::copysign(std::hypot(alpha, std::sqrt(norm)), alpha)};
+      tau_[j] = (beta - alpha) / beta;
+      const auto scale {T{1} / (alpha - beta)};
+      for (auto i {j + 1}; i < rows; ++i)
+        m(i, j) *= scale;
+      m(j, j) = beta;
+      detail::apply_reflector(detail::to_const(m), j, tau_[j], m.sub(0, j + 1, rows, k + kb - j - 1), work);
+    }
+    if (k + kb == cols)
+      break;
+
+    // Compact WY form "H_k ... H_{k+kb-1} = I - V T V^T".
+    const auto panel_rows {rows - k};
+    const auto rest {cols - k - kb};
+    v.assign(panel_rows * kb, T{});
+    const auto vm {detail::make_strided(v.data(), panel_rows, kb)};
+    for (std::size_t i {0}; i < panel_rows; ++i)
+      for (std::size_t j {0}; j < kb && j <= i; ++j)
+        vm(i, j) = i == j ? T{1} : m(k + i, k + j);
+    t.assign(kb * kb, T{});
+    const auto tm {detail::make_strided(t.data(), kb, kb)};
+    for (std::size_t j {0}; j < kb; ++j) {
+      const auto tau {tau_[k + j]};
+      for (std::size_t p {0}; p < j; ++p) {
+        T dot {};
+        for (auto i {j}; i < panel_rows; ++i)
+          dot += vm(i, p) * vm(i, j);
+        tm(p, j) = -tau * dot;
+      }
+      for (std::size_t p {0}; p < j; ++p) {
+        T value {};
+        for (auto q {p}; q < j; ++q)
+          value += tm(p, q) * tm(q, j);
+        tm(p, j) = value;
+      }
+      tm(j, j) = tau;
+    }
+
+    // Apply "I - V T^T V^T" to trailing columns.
+    w.assign(kb * rest, T{});
+    const auto wm {detail::make_strided(w.data(), kb, rest)};
+    const auto trailing {m.sub(k, k + kb, panel_rows, rest)};
+    detail::gemm(T{1}, detail::to_const(vm).transposed(), detail::to_const(trailing), false, wm);
+    for (auto i {kb}; i-- > 0;)
+      for (std::size_t c {0}; c < rest; ++c) {
+        T value {};
+        for (std::size_t p {0}; p <= i; ++p)
+          value += tm(p, i) * wm(p, c);
+        wm(i, c) = value;
+      }
+    detail::gemm(T{-1}, detail::to_const(vm), detail::to_const(wm), true, trailing);
+  }
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::qr_decomposition<T>::solve(std::valarray<T> b) const
+{
+  assert(b.size() == qr_.col_size());
+  const auto cols {qr_.row_size()};
+  const auto m {detail::make_strided(qr_)};
+  std::vector<T> work {};
+  const auto x {detail::make_strided(detail::valarray_data(b), b.size(), 1)};
+  for (std::size_t j {0}; j < cols; ++j)
+    detail::apply_reflector(m, j, tau_[j], x, work);
+  if (detail::is_rank_deficient(m))
+    throw std::domain_error {"xmaho::std_ext::qr_decomposition::solve : matrix is rank deficient"};
+  detail::solve_upper(m.sub(0, 0, cols, cols), x.sub(0, 0, cols, 1));
+  return b[std::slice(0, cols, 1)];
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::qr_decomposition<T>::solve(valmatrix<T> b) const
+{
+  assert(b.col_size() == qr_.col_size());
+  const auto cols {qr_.row_size()};
+  const auto m {detail::make_strided(qr_)};
+  std::vector<T> work {};
+  const auto x {detail::make_strided(b)};
+  for (std::size_t j {0}; j < cols; ++j)
+    detail::apply_reflector(m, j, tau_[j], x, work);
+  if (detail::is_rank_deficient(m))
+    throw std::domain_error {"xmaho::std_ext::qr_decomposition::solve : matrix is rank deficient"};
+  detail::solve_upper(m.sub(0, 0, cols, cols), x.sub(0, 0, cols, x.cols));
+  return valmatrix<T>(std::valarray<T>(b.data(), cols * x.cols), x.cols, cols);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::qr_decomposition<T>::r() const
+{
+  const auto cols {qr_.row_size()};
+  valmatrix<T> result(cols, cols);
+  for (std::size_t i {0}; i < cols; ++i)
+    for (auto j {i}; j < cols; ++j)
+      result[i * cols + j] = qr_[i * cols + j];
+  return result;
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::qr_decomposition<T>::matrix() const noexcept
+{
+  return qr_;
+}
+
+#endif
@@ -0,0 +1,401 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_ELEMENTWISE_H
+#define XMAHO_STD_EXT_DETAIL_ELEMENTWISE_H
+
+#include <cstddef>
+#include <functional>
+#include <valarray>
+
+#if defined(__AVX512F__)
+#  define XMAHO_STD_EXT_SIMD_AVX512 1
+#elif defined(__AVX__)
+#  define XMAHO_STD_EXT_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define XMAHO_STD_EXT_SIMD_SSE2 1
+#endif
+
+#if defined(XMAHO_STD_EXT_SIMD_AVX512) || defined(XMAHO_STD_EXT_SIMD_AVX) || defined(XMAHO_STD_EXT_SIMD_SSE2)
+#  include <immintrin.h>
+#endif
+
+namespace xmaho::std_ext::detail
+{
+
+/**
+ * @brief Vector register of T selected at compile time.
+ *
+ * The widest of AVX-512, AVX and SSE2 enabled by compiler options is used.
+ * Types without specialization use the portable loop.
+ */
+template<typename T>
+struct simd_traits
+{
+  static constexpr bool enabled {false};
+};
+
+#if defined(XMAHO_STD_EXT_SIMD_AVX512)
+
+template<>
+struct simd_traits<float>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {16};
+  using type = __m512;
+  static type load(const float* p) noexcept {return _mm512_loadu_ps(p);}
+  static void store(float* p, type v) noexcept {_mm512_storeu_ps(p, v);}
+  static type broadcast(float v) noexcept {return _mm512_set1_ps(v);}
+  static type add(type a, type b) noexcept {return _mm512_add_ps(a, b);}
+  static type sub(type a, type b) noexcept {return _mm512_sub_ps(a, b);}
+  static type mul(type a, type b) noexcept {return _mm512_mul_ps(a, b);}
+  static type div(type a, type b) noexcept {return _mm512_div_ps(a, b);}
+};
+
+template<>
+struct simd_traits<double>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {8};
+  using type = __m512d;
+  static type load(const double* p) noexcept {return _mm512_loadu_pd(p);}
+  static void store(double* p, type v) noexcept {_mm512_storeu_pd(p, v);}
+  static type broadcast(double v) noexcept {return _mm512_set1_pd(v);}
+  static type add(type a, type b) noexcept {return _mm512_add_pd(a, b);}
+  static type sub(type a, type b) noexcept {return _mm512_sub_pd(a, b);}
+  static type mul(type a, type b) noexcept {return _mm512_mul_pd(a, b);}
+  static type div(type a, type b) noexcept {return _mm512_div_pd(a, b);}
+};
+
+#elif defined(XMAHO_STD_EXT_SIMD_AVX)
+
+template<>
+struct simd_traits<float>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {8};
+  using type = __m256;
+  static type load(const float* p) noexcept {return _mm256_loadu_ps(p);}
+  static void store(float* p, type v) noexcept {_mm256_storeu_ps(p, v);}
+  static type broadcast(float v) noexcept {return _mm256_set1_ps(v);}
+  static type add(type a, type b) noexcept {return _mm256_add_ps(a, b);}
+  static type sub(type a, type b) noexcept {return _mm256_sub_ps(a, b);}
+  static type mul(type a, type b) noexcept {return _mm256_mul_ps(a, b);}
+  static type div(type a, type b) noexcept {return _mm256_div_ps(a, b);}
+};
+
+template<>
+struct simd_traits<double>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {4};
+  using type = __m256d;
+  static type load(const double* p) noexcept {return _mm256_loadu_pd(p);}
+  static void store(double* p, type v) noexcept {_mm256_storeu_pd(p, v);}
+  static type broadcast(double v) noexcept {return _mm256_set1_pd(v);}
+  static type add(type a, type b) noexcept {return _mm256_add_pd(a, b);}
+  static type sub(type a, type b) noexcept {return _mm256_sub_pd(a, b);}
+  static type mul(type a, type b) noexcept {return _mm256_mul_pd(a, b);}
+  static type div(type a, type b) noexcept {return _mm256_div_pd(a, b);}
+};
+
+#elif defined(XMAHO_STD_EXT_SIMD_SSE2)
+
+template<>
+struct simd_traits<float>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {4};
+  using type = __m128;
+  static type load(const float* p) noexcept {return _mm_loadu_ps(p);}
+  static void store(float* p, type v) noexcept {_mm_storeu_ps(p, v);}
+  static type broadcast(float v) noexcept {return _mm_set1_ps(v);}
+  static type add(type a, type b) noexcept {return _mm_add_ps(a, b);}
+  static type sub(type a, type b) noexcept {return _mm_sub_ps(a, b);}
+  static type mul(type a, type b) noexcept {return _mm_mul_ps(a, b);}
+  static type div(type a, type b) noexcept {return _mm_div_ps(a, b);}
+};
+
+template<>
+struct simd_traits<double>
+{
+  static constexpr bool enabled {true};
+  static constexpr std::size_t width {2};
+  using type = __m128d;
+  static type load(const double* p) noexcept {return _mm_loadu_pd(p);}
+  static void store(double* p, type v) noexcept {_mm_storeu_pd(p, v);}
+  static type broadcast(double v) noexcept {return _mm_set1_pd(v);}
+  static type add(type a, type b) noexcept {return _mm_add_pd(a, b);}
+  static type sub(type a, type b) noexcept {return _mm_sub_pd(a, b);}
+  static type mul(type a, type b) noexcept {return _mm_mul_pd(a, b);}
+  static type div(type a, type b) noexcept {return _mm_div_pd(a, b);}
+};
+
+#endif
+
+template<typename Op>
+struct simd_operation
+{
+  static constexpr bool enabled {false};
+};
+
+template<>
+struct simd_operation<std::plus<>>
+{
+  static constexpr bool enabled {true};
+  template<typename Traits, typename V>
+  static V apply(V a, V b) noexcept {return Traits::add(a, b);}
+};
+
+template<>
+struct simd_operation<std::minus<>>
+{
+  static constexpr bool enabled {true};
+  template<typename Traits, typename V>
+  static V apply(V a, V b) noexcept {return Traits::sub(a, b);}
+};
+
+template<>
+struct simd_operation<std::multiplies<>>
+{
+  static constexpr bool enabled {true};
+  template<typename Traits, typename V>
+  static V apply(V a, V b) noexcept {return Traits::mul(a, b);}
+};
+
+template<>
+struct simd_operation<std::divides<>>
+{
+  static constexpr bool enabled {true};
+  template<typename Traits, typename V>
+  static V apply(V a, V b) noexcept {return Traits::div(a, b);}
+};
+
+template<typename T, typename Op>
+constexpr bool is_simd_enabled {simd_traits<T>::enabled && simd_operation<Op>::enabled};
+
+/**
+ * @brief Compute "dst[i] = op(dst[i], src[i])" for i < n.
+ *
+ * Arithmetic of float and double use vector registers,
+ * and others use the portable loop that compiler may vectorize.
+ *
+ * @pre dst and src are same or don't overlap.
+ */
+template<typename T, typename Op>
+void elementwise_apply(T* dst, const T* src, std::size_t n, Op op)
+{
+  std::size_t i {0};
+  if constexpr (is_simd_enabled<T, Op>) {
+    using traits = simd_traits<T>;
+    constexpr auto width {traits::width};
+    for (; i + 2 * width <= n; i += 2 * width) {
+      const auto v0 {simd_operation<Op>::template apply<traits>(traits::load(dst + i), traits::load(src + i))};
+      const auto v1 {simd_operation<Op>::template apply<traits>(traits::load(dst + i + width), traits::load(src + i + width))};
+      traits::store(dst + i, v0);
+      traits::store(dst + i + width, v1);
+    }
+    for (; i + width <= n; i += width)
+      traits::store(dst + i, simd_operation<Op>::template apply<traits>(traits::load(dst + i), traits::load(src + i)));
+  }
+  for (; i < n; ++i)
+    dst[i] = static_cast<T>(op(dst[i], src[i]));
+}
+
+/**
+ * @brief Compute "dst[i] = op(dst[i], value)" for i < n.
+ *
+ * Arithmetic of float and double use vector registers,
+ * and others use the portable loop that compiler may vectorize.
+ */
+template<typename T, typename Op>
+void elementwise_apply_value(T* dst, const T& value, std::size_t n, Op op)
+{
+  std::size_t i {0};
+  if constexpr (is_simd_enabled<T, Op>) {
+    using traits = simd_traits<T>;
+    constexpr auto width {traits::width};
+    const auto v {traits::broadcast(value)};
+    for (; i + 2 * width <= n; i += 2 * width) {
+      const auto v0 {simd_operation<Op>::template apply<traits>(traits::load(dst + i), v)};
+      const auto v1 {simd_operation<Op>::template apply<traits>(traits::load(dst + i + width), v)};
+      traits::store(dst + i, v0);
+      traits::store(dst + i + width, v1);
+    }
+    for (; i + width <= n; i += width)
+      traits::store(dst + i, simd_operation<Op>::template apply<traits>(traits::load(dst + i), v));
+  }
+  const T rhs {value};
+  for (; i < n; ++i)
+    dst[i] = static_cast<T>(op(dst[i], rhs));
+}
+
+/**
+ * @brief Compute "dst[i] += lhs[i] * rhs[i]" for i < n.
+ *
+ * Arithmetic of float and double use vector registers,
+ * and others use the portable loop that compiler may vectorize.
+ *
+ * @pre dst doesn't overlap lhs and rhs.
+ */
+template<typename T>
+void multiply_accumulate(T* dst, const T* lhs, const T* rhs, std::size_t n)
+{
+  std::size_t i {0};
+  if constexpr (simd_traits<T>::enabled) {
+    using traits = simd_traits<T>;
+    constexpr auto width {traits::width};
+    for (; i + 2 * width <= n; i += 2 * width) {
+      const auto v0 {traits::add(traits::load(dst + i), traits::mul(traits::load(lhs + i), traits::load(rhs + i)))};
+      const auto v1 {traits::add(traits::load(dst + i + width), traits::mul(traits::load(lhs + i + width), traits::load(rhs + i + width)))};
+      traits::store(dst + i, v0);
+      traits::store(dst + i + width, v1);
+    }
+    for (; i + width <= n; i += width)
+      traits::store(dst + i, traits::add(traits::load(dst + i), traits::mul(traits::load(lhs + i), traits::load(rhs + i))));
+  }
+  for (; i < n; ++i)
+    dst[i] += lhs[i] * rhs[i];
+}
+
+/**
+ * @brief Compute "dst[i] += src[i] * value" for i < n.
+ *
+ * Arithmetic of float and double use vector registers,
+ * and others use the portable loop that compiler may vectorize.
+ *
+ * @pre dst doesn't overlap src.
+ */
+template<typename T>
+void multiply_accumulate_value(T* dst, const T* src, const T& value, std::size_t n)
+{
+  std::size_t i {0};
+  if constexpr (simd_traits<T>::enabled) {
+    using traits = simd_traits<T>;
+    constexpr auto width {traits::width};
+    const auto v {traits::broadcast(value)};
+    for (; i + 2 * width <= n; i += 2 * width) {
+      const auto v0 {traits::add(traits::load(dst + i), traits::mul(traits::load(src + i), v))};
+      const auto v1 {traits::add(traits::load(dst + i + width), traits::mul(traits::load(src + i + width), v))};
+      traits::store(dst + i, v0);
+      traits::store(dst + i + width, v1);
+    }
+    for (; i + width <= n; i += width)
+      traits::store(dst + i, traits::add(traits::load(dst + i), traits::mul(traits::load(src + i), v)));
+  }
+  const T rhs {value};
+  for (; i < n; ++i)
+    dst[i] += src[i] * rhs;
+}
+
+/**
+ * @brief Compute sum of "lhs[i] * rhs[i]" for i < n.
+ *
+ * Arithmetic of float and double use vector registers,
+ * and others use the portable loop that compiler may vectorize.
+ */
+template<typename T>
+T dot_product(const T* lhs, const T* rhs, std::size_t n)
+{
+  std::size_t i {0};
+  T result {};
+  if constexpr (simd_traits<T>::enabled) {
+    using traits = simd_traits<T>;
+    constexpr auto width {traits::width};
+    if (2 * width <= n) {
+      auto v0 {traits::mul(traits::load(lhs), traits::load(rhs))};
+      auto v1 {traits::mul(traits::load(lhs + width), traits::load(rhs + width))};
+      for (i = 2 * width; i + 2 * width <= n; i += 2 * width) {
+        v0 = traits::add(v0, traits::mul(traits::load(lhs + i), traits::load(rhs + i)));
+        v1 = traits::add(v1, traits::mul(traits::load(lhs + i + width), traits::load(rhs + i + width)));
+      }
+      T lanes[width];
+      traits::store(lanes, traits::add(v0, v1));
+      for (const auto lane : lanes)
+        result += lane;
+    }
+  }
+  for (; i < n; ++i)
+    result += lhs[i] * rhs[i];
+  return result;
+}
+
+template<typename T>
+const T* valarray_data(const std::valarray<T>& v) noexcept
+{
+  return v.size() ? &v[0] : nullptr;
+}
+
+template<typename T>
+T* valarray_data(std::valarray<T>& v) noexcept
+{
+  return v.size() ? &v[0] : nullptr;
+}
+
+struct shift_left
+{
+  template<typename T, typename U>
+  constexpr auto operator()(const T& lhs, const U& rhs) const
+  {
+    return lhs << rhs;
+  }
+};
+
+struct shift_right
+{
+  template<typename T, typename U>
+  constexpr auto operator()(const T& lhs, const U& rhs) const
+  {
+    return lhs >> rhs;
+  }
+};
+
+/**
+ * @brief Swap operands of Op, so "dst[i] = op(src[i], dst[i])" is computed in place.
+ */
+template<typename Op>
+struct reversed
+{
+  template<typename T, typename U>
+  constexpr auto operator()(const T& lhs, const U& rhs) const
+  {
+    return Op{}(rhs, lhs);
+  }
+};
+
+template<typename Op>
+struct simd_operation<reversed<Op>>
+{
+  static constexpr bool enabled {simd_operation<Op>::enabled};
+  template<typename Traits, typename V>
+  static V apply(V a, V b) noexcept {return simd_operation<Op>::template apply<Traits>(b, a);}
+};
+
+}
+
+#endif
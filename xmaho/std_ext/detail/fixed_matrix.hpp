@@ -0,0 +1,656 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_FIXED_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_FIXED_MATRIX_H
+
+#include "../fixed_matrix.hpp"
+#include "elementwise.hpp"
+
+#include <cassert>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename F, std::size_t... I>
+constexpr void unrolled_for(F&& function, std::index_sequence<I...>)
+{
+  (function(I), ...);
+}
+
+template<std::size_t N, typename F>
+constexpr void unrolled_for(F&& function)
+{
+  unrolled_for(std::forward<F>(function), std::make_index_sequence<N>{});
+}
+
+template<typename T, std::size_t N, typename Op>
+constexpr void unrolled_apply(std::array<T, N>& dst, const T* src, Op op) noexcept
+{
+  unrolled_for<N>([&dst, src, op](std::size_t i) {dst[i] = static_cast<T>(op(dst[i], src[i]));});
+}
+
+template<typename T, std::size_t N, typename Op>
+constexpr void unrolled_apply_value(std::array<T, N>& dst, const T& value, Op op) noexcept
+{
+  unrolled_for<N>([&dst, &value, op](std::size_t i) {dst[i] = static_cast<T>(op(dst[i], value));});
+}
+
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::fixed_matrix() noexcept
+  : values_ {}
+{
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::fixed_matrix(const T& value) noexcept
+  : values_ {}
+{
+  detail::unrolled_for<size()>([this, &value](std::size_t i) {values_[i] = value;});
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::fixed_matrix(const std::array<T, RowSize * ColSize>& values) noexcept
+  : values_ {values}
+{
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::fixed_matrix(const valmatrix<T>& matrix)
+  : values_ {}
+{
+  assert(matrix.row_size() == RowSize && matrix.col_size() == ColSize);
+  detail::unrolled_for<size()>([this, &matrix](std::size_t i) {values_[i] = matrix[i];});
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator xmaho::std_ext::valmatrix<T>() const
+{
+  return valmatrix<T>(std::valarray<T>(values_.data(), size()), RowSize, ColSize);
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr const T& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator[](size_type index) const noexcept
+{
+  return values_[index];
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr T& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator[](size_type index) noexcept
+{
+  return values_[index];
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr const T& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator[](position_type position) const noexcept
+{
+  return values_[position.second * RowSize + position.first];
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr T& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator[](position_type position) noexcept
+{
+  return values_[position.second * RowSize + position.first];
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator+() const noexcept
+{
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator-() const noexcept
+{
+  fixed_matrix result {};
+  detail::unrolled_for<size()>([&result, this](std::size_t i) {result.values_[i] = static_cast<T>(-values_[i]);});
+  return result;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator~() const noexcept
+{
+  fixed_matrix result {};
+  detail::unrolled_for<size()>([&result, this](std::size_t i) {result.values_[i] = static_cast<T>(~values_[i]);});
+  return result;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator+=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::plus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator+=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::plus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator+=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::plus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator-=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::minus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator-=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::minus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator-=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::minus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator*=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::multiplies<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator*=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::multiplies<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator*=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::multiplies<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator/=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::divides<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator/=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::divides<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator/=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::divides<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator%=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::modulus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator%=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::modulus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator%=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::modulus<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator&=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::bit_and<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator&=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::bit_and<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator&=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::bit_and<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator|=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::bit_or<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator|=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::bit_or<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator|=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::bit_or<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator^=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), std::bit_xor<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator^=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), std::bit_xor<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator^=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, std::bit_xor<>{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator<<=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), detail::shift_left{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator<<=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), detail::shift_left{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator<<=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, detail::shift_left{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator>>=(const fixed_matrix& rhs) & noexcept
+{
+  detail::unrolled_apply(values_, rhs.values_.data(), detail::shift_right{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator>>=(const valmatrix<T>& rhs) &
+{
+  assert(rhs.row_size() == RowSize && rhs.col_size() == ColSize);
+  detail::unrolled_apply(values_, rhs.data(), detail::shift_right{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>& xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::operator>>=(const T& rhs) & noexcept
+{
+  detail::unrolled_apply_value(values_, rhs, detail::shift_right{});
+  return *this;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::size_type xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::row_size() noexcept
+{
+  return RowSize;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::size_type xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::col_size() noexcept
+{
+  return ColSize;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::size_type xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::size() noexcept
+{
+  return RowSize * ColSize;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr T xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::sum() const noexcept
+{
+  T result {};
+  detail::unrolled_for<size()>([&result, this](std::size_t i) {result = static_cast<T>(result + values_[i]);});
+  return result;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::const_iterator xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::begin() const noexcept
+{
+  return values_.begin();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::iterator xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::begin() noexcept
+{
+  return values_.begin();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::const_iterator xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::end() const noexcept
+{
+  return values_.end();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr typename xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::iterator xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::end() noexcept
+{
+  return values_.end();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr const T* xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::data() const noexcept
+{
+  return values_.data();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr T* xmaho::std_ext::fixed_matrix<T, RowSize, ColSize>::data() noexcept
+{
+  return values_.data();
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr bool xmaho::std_ext::operator==(const fixed_matrix<T, RowSize, ColSize>& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  bool result {true};
+  detail::unrolled_for<RowSize * ColSize>([&result, &lhs, &rhs](std::size_t i) {result = result && lhs[i] == rhs[i];});
+  return result;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr bool xmaho::std_ext::operator!=(const fixed_matrix<T, RowSize, ColSize>& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator+(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs += rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator+(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs += rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator+(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result += rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator-(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs -= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator-(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs -= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator-(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result -= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator*(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs *= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator*(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs *= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator*(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result *= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator/(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs /= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator/(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs /= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator/(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result /= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator%(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs %= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator%(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs %= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator%(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result %= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator&(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs &= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator&(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs &= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator&(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result &= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator|(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs |= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator|(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs |= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator|(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result |= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator^(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs ^= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator^(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs ^= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator^(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result ^= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator<<(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs <<= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator<<(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs <<= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator<<(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result <<= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator>>(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  return lhs >>= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator>>(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept
+{
+  return lhs >>= rhs;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, RowSize, ColSize> xmaho::std_ext::operator>>(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept
+{
+  fixed_matrix<T, RowSize, ColSize> result {lhs};
+  return result >>= rhs;
+}
+
+template<typename T, std::size_t K, std::size_t M, std::size_t N>
+constexpr xmaho::std_ext::fixed_matrix<T, N, M> xmaho::std_ext::matmul(const fixed_matrix<T, K, M>& a, const fixed_matrix<T, N, K>& b) noexcept
+{
+  fixed_matrix<T, N, M> result {};
+  detail::unrolled_for<M * N>([&result, &a, &b](std::size_t index) {
+    const auto i {index / N};
+    const auto j {index % N};
+    T sum {};
+    detail::unrolled_for<K>([&sum, &a, &b, i, j](std::size_t p) {sum = static_cast<T>(sum + a[i * K + p] * b[p * N + j]);});
+    result[index] = sum;
+  });
+  return result;
+}
+
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr xmaho::std_ext::fixed_matrix<T, ColSize, RowSize> xmaho::std_ext::transpose(const fixed_matrix<T, RowSize, ColSize>& m) noexcept
+{
+  fixed_matrix<T, ColSize, RowSize> result {};
+  detail::unrolled_for<RowSize * ColSize>([&result, &m](std::size_t index) {
+    result[index % RowSize * ColSize + index / RowSize] = m[index];
+  });
+  return result;
+}
+
+#endif
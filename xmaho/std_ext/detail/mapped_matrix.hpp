@@ -0,0 +1,297 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_MAPPED_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_MAPPED_MATRIX_H
+
+#include "../mapped_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xmaho::std_ext::detail
+{
+
+class file_descriptor
+{
+public:
+  explicit file_descriptor(int fd) noexcept
+    : fd_ {fd}
+  {
+  }
+
+  file_descriptor(const file_descriptor&) = delete;
+  file_descriptor& operator=(const file_descriptor&) = delete;
+
+  ~file_descriptor()
+  {
+    if (fd_ >= 0)
+      ::close(fd_);
+  }
+
+  int get() const noexcept
+  {
+    return fd_;
+  }
+
+private:
+  int fd_;
+};
+
+[[noreturn]] inline void throw_system_error(const char* what)
+{
+  throw std::system_error{errno, std::generic_category(), what};
+}
+
+inline void* map_file(int fd, std::size_t length, bool writable)
+{
+  const auto protection {writable ? PROT_READ | PROT_WRITE : PROT_READ};
+  const auto address {::mmap(nullptr, length, protection, MAP_SHARED, fd, 0)};
+  if (address == MAP_FAILED)
+    throw_system_error("xmaho::std_ext::mapped_matrix::mapped_matrix : mmap");
+  return address;
+}
+
+inline void* create_matrix_file(const std::filesystem::path& path, const matrix_file_header& header, std::size_t length)
+{
+  const file_descriptor fd {::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+  if (fd.get() < 0)
+    throw_system_error("xmaho::std_ext::mapped_matrix::mapped_matrix : open");
+  if (::ftruncate(fd.get(), static_cast<::off_t>(length)) != 0)
+    throw_system_error("xmaho::std_ext::mapped_matrix::mapped_matrix : ftruncate");
+  const auto address {map_file(fd.get(), length, true)};
+  std::memcpy(address, &header, sizeof(header));
+  return address;
+}
+
+inline bool is_payload_size(const matrix_file_header& header, std::size_t count) noexcept
+{
+  if (!header.row_size || !header.col_size)
+    return !count;
+  return count % header.row_size == 0 && count / header.row_size == header.col_size;
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>::mapped_matrix(const std::filesystem::path& path)
+{
+  constexpr auto writable {!std::is_const_v<T>};
+  const detail::file_descriptor fd {::open(path.c_str(), writable ? O_RDWR : O_RDONLY)};
+  if (fd.get() < 0)
+    detail::throw_system_error("xmaho::std_ext::mapped_matrix::mapped_matrix : open");
+  struct ::stat status {};
+  if (::fstat(fd.get(), &status) != 0)
+    detail::throw_system_error("xmaho::std_ext::mapped_matrix::mapped_matrix : fstat");
+  const auto file_size {static_cast<size_type>(status.st_size)};
+  if (file_size < sizeof(matrix_file_header))
+    throw std::runtime_error{"xmaho::std_ext::mapped_matrix::mapped_matrix : not matrix file"};
+
+  address_ = detail::map_file(fd.get(), file_size, writable);
+  length_ = file_size;
+  try {
+    matrix_file_header header;
+    std::memcpy(&header, address_, sizeof(header));
+    check_matrix_file_header<value_type>(header);
+    const auto payload {file_size - sizeof(matrix_file_header)};
+    if (payload % sizeof(value_type) || !detail::is_payload_size(header, payload / sizeof(value_type)))
+      throw std::runtime_error{"xmaho::std_ext::mapped_matrix::mapped_matrix : size of payload is different"};
+    size_ = detail::get_init_size(header.row_size, header.col_size);
+  }
+  catch (...) {
+    ::munmap(address_, length_);
+    throw;
+  }
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>::mapped_matrix(const std::filesystem::path& path, size_type row_size, size_type col_size)
+  : length_ {sizeof(matrix_file_header) + row_size * col_size * sizeof(T)},
+    size_ {detail::get_init_size(row_size, col_size)}
+{
+  static_assert(!std::is_const_v<T>, "read only mapping can't create file");
+  address_ = detail::create_matrix_file(path, make_matrix_file_header<T>(size_.first, size_.second), length_);
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>::mapped_matrix(const std::filesystem::path& path, const valmatrix<value_type>& m)
+  : mapped_matrix(path, m.row_size(), m.col_size())
+{
+  std::copy(std::begin(m), std::end(m), begin());
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>::mapped_matrix(mapped_matrix&& other) noexcept
+  : address_ {std::exchange(other.address_, nullptr)},
+    length_ {std::exchange(other.length_, 0)},
+    size_ {std::exchange(other.size_, position_type{})}
+{
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>& xmaho::std_ext::mapped_matrix<T>::operator=(mapped_matrix&& other) noexcept
+{
+  std::swap(address_, other.address_);
+  std::swap(length_, other.length_);
+  std::swap(size_, other.size_);
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::mapped_matrix<T>::~mapped_matrix()
+{
+  if (address_)
+    ::munmap(address_, length_);
+}
+
+template<typename T>
+const typename xmaho::std_ext::mapped_matrix<T>::value_type& xmaho::std_ext::mapped_matrix<T>::operator[](size_type index) const
+{
+  assert(index < size());
+  return data()[index];
+}
+
+template<typename T>
+T& xmaho::std_ext::mapped_matrix<T>::operator[](size_type index)
+{
+  assert(index < size());
+  return data()[index];
+}
+
+template<typename T>
+const typename xmaho::std_ext::mapped_matrix<T>::value_type& xmaho::std_ext::mapped_matrix<T>::operator[](position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return data()[row_major::index(position, size_)];
+}
+
+template<typename T>
+T& xmaho::std_ext::mapped_matrix<T>::operator[](position_type position)
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return data()[row_major::index(position, size_)];
+}
+
+template<typename T>
+typename xmaho::std_ext::mapped_matrix<T>::size_type xmaho::std_ext::mapped_matrix<T>::row_size() const noexcept
+{
+  return size_.first;
+}
+
+template<typename T>
+typename xmaho::std_ext::mapped_matrix<T>::size_type xmaho::std_ext::mapped_matrix<T>::col_size() const noexcept
+{
+  return size_.second;
+}
+
+template<typename T>
+typename xmaho::std_ext::mapped_matrix<T>::size_type xmaho::std_ext::mapped_matrix<T>::size() const noexcept
+{
+  return size_.first * size_.second;
+}
+
+template<typename T>
+const typename xmaho::std_ext::mapped_matrix<T>::value_type* xmaho::std_ext::mapped_matrix<T>::data() const noexcept
+{
+  return reinterpret_cast<const value_type*>(static_cast<const char*>(address_) + sizeof(matrix_file_header));
+}
+
+template<typename T>
+T* xmaho::std_ext::mapped_matrix<T>::data() noexcept
+{
+  return reinterpret_cast<T*>(static_cast<char*>(address_) + sizeof(matrix_file_header));
+}
+
+template<typename T>
+const typename xmaho::std_ext::mapped_matrix<T>::value_type* xmaho::std_ext::mapped_matrix<T>::begin() const noexcept
+{
+  return data();
+}
+
+template<typename T>
+T* xmaho::std_ext::mapped_matrix<T>::begin() noexcept
+{
+  return data();
+}
+
+template<typename T>
+const typename xmaho::std_ext::mapped_matrix<T>::value_type* xmaho::std_ext::mapped_matrix<T>::end() const noexcept
+{
+  return data() + size();
+}
+
+template<typename T>
+T* xmaho::std_ext::mapped_matrix<T>::end() noexcept
+{
+  return data() + size();
+}
+
+template<typename T>
+void xmaho::std_ext::mapped_matrix<T>::flush() const
+{
+  if (!std::is_const_v<T> && ::msync(address_, length_, MS_SYNC) != 0)
+    detail::throw_system_error("xmaho::std_ext::mapped_matrix::flush : msync");
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<const std::remove_const_t<T>> xmaho::std_ext::view(const mapped_matrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<T> xmaho::std_ext::view(mapped_matrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::lazy(const mapped_matrix<T>& m) noexcept
+{
+  return valmatrix_expression<detail::matrix_terminal<std::remove_const_t<T>>>{{m.data(), m.row_size(), m.col_size()}};
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<std::remove_const_t<T>> xmaho::std_ext::to_valmatrix(const mapped_matrix<T>& m)
+{
+  return {std::valarray<std::remove_const_t<T>>(m.data(), m.size()), m.row_size(), m.col_size()};
+}
+
+#endif
@@ -0,0 +1,507 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_MATMUL_H
+#define XMAHO_STD_EXT_DETAIL_MATMUL_H
+
+#include "../matmul.hpp"
+#include "elementwise.hpp"
+#include "strided_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace xmaho::std_ext::detail
+{
+
+/**
+ * @brief Blocking parameters of gemm.
+ *
+ * mr x nr is the register tile computed by the micro kernel.
+ * nr is one cache line of T.
+ * kc x nr panel of B stays in L1 and mc x kc block of A stays in L2.
+ */
+template<typename T>
+struct gemm_blocking
+{
+  static constexpr std::size_t mr {4};
+  static constexpr std::size_t nr {std::clamp<std::size_t>(64 / sizeof(T), 1, 16)};
+  static constexpr std::size_t kc {256};
+  static constexpr std::size_t mc {std::max<std::size_t>(mr, 256 * 1024 / (kc * sizeof(T)) / mr * mr)};
+  static constexpr std::size_t nc {4096};
+  //! @brief Under this m * n * k, packing costs more than it saves.
+  static constexpr std::size_t small_volume {16 * 16 * 16};
+};
+
+template<typename T>
+void gemm_fill_zero(strided_matrix<T> c)
+{
+  for (std::size_t i {0}; i < c.rows; ++i)
+    for (std::size_t j {0}; j < c.cols; ++j)
+      c(i, j) = T{};
+}
+
+template<typename T>
+void gemm_small(const T& alpha, strided_matrix<const T> a, strided_matrix<const T> b, strided_matrix<T> c)
+{
+  for (std::size_t i {0}; i < a.rows; ++i)
+    for (std::size_t p {0}; p < a.cols; ++p) {
+      const T aip {alpha * a(i, p)};
+      for (std::size_t j {0}; j < b.cols; ++j)
+        c(i, j) += aip * b(p, j);
+    }
+}
+
+/**
+ * @brief Pack mb x kb block of A into row panels of mr.
+ *
+ * Panel layout is [panel][p][i] and short panel is padded by zero.
+ */
+template<typename T>
+void gemm_pack_a(strided_matrix<const T> a, T* buffer)
+{
+  constexpr auto mr {gemm_blocking<T>::mr};
+  for (std::size_t ir {0}; ir < a.rows; ir += mr) {
+    const auto rows {std::min(mr, a.rows - ir)};
+    for (std::size_t p {0}; p < a.cols; ++p) {
+      std::size_t i {0};
+      for (; i < rows; ++i)
+        *buffer++ = a(ir + i, p);
+      for (; i < mr; ++i)
+        *buffer++ = T{};
+    }
+  }
+}
+
+/**
+ * @brief Pack kb x nb block of B into column panels of nr.
+ *
+ * Panel layout is [panel][p][j] and short panel is padded by zero.
+ */
+template<typename T>
+void gemm_pack_b(strided_matrix<const T> b, T* buffer)
+{
+  constexpr auto nr {gemm_blocking<T>::nr};
+  for (std::size_t jr {0}; jr < b.cols; jr += nr) {
+    const auto cols {std::min(nr, b.cols - jr)};
+    for (std::size_t p {0}; p < b.rows; ++p) {
+      std::size_t j {0};
+      for (; j < cols; ++j)
+        *buffer++ = b(p, jr + j);
+      for (; j < nr; ++j)
+        *buffer++ = T{};
+    }
+  }
+}
+
+/**
+ * @brief Compute mr x nr tile of "C += alpha A B" from packed panels.
+ *
+ * The accumulator is small enough to live in registers,
+ * and the inner loop over nr is contiguous for vectorization.
+ */
+template<typename T>
+void gemm_micro_kernel(std::size_t kb, const T& alpha, const T* a, const T* b, strided_matrix<T> c)
+{
+  constexpr auto mr {gemm_blocking<T>::mr};
+  constexpr auto nr {gemm_blocking<T>::nr};
+  T acc[mr][nr] {};
+  for (std::size_t p {0}; p < kb; ++p, a += mr, b += nr)
+    for (std::size_t i {0}; i < mr; ++i) {
+      const T aip {a[i]};
+      for (std::size_t j {0}; j < nr; ++j)
+        acc[i][j] += aip * b[j];
+    }
+  for (std::size_t i {0}; i < c.rows; ++i)
+    for (std::size_t j {0}; j < c.cols; ++j)
+      c(i, j) += alpha * acc[i][j];
+}
+
+/**
+ * @brief General matrix multiply "C = alpha A B (+ C)".
+ *
+ * @pre a.cols == b.rows
+ * @pre c.rows == a.rows
+ * @pre c.cols == b.cols
+ * @pre c doesn't overlap with a and b.
+ *
+ * @param[in] alpha Scale of product.
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side matrix.
+ * @param[in] accumulate Add to c if true, overwrite c if false.
+ * @param[in,out] c Destination matrix.
+ */
+template<typename T>
+void gemm(const T& alpha, strided_matrix<const T> a, strided_matrix<const T> b, bool accumulate, strided_matrix<T> c)
+{
+  using blocking = gemm_blocking<T>;
+  assert(a.cols == b.rows);
+  assert(c.rows == a.rows);
+  assert(c.cols == b.cols);
+
+  if (!accumulate)
+    gemm_fill_zero(c);
+  if (!c.rows || !c.cols || !a.cols)
+    return;
+  if (a.rows * a.cols * b.cols <= blocking::small_volume) {
+    gemm_small(alpha, a, b, c);
+    return;
+  }
+
+  const auto round_up {[](std::size_t v, std::size_t unit){return (v + unit - 1) / unit * unit;}};
+  const auto kc {std::min(blocking::kc, a.cols)};
+  const auto mc {std::min(blocking::mc, round_up(a.rows, blocking::mr))};
+  const auto nc {std::min(blocking::nc, round_up(b.cols, blocking::nr))};
+  std::vector<T> a_pack(mc * kc);
+  std::vector<T> b_pack(kc * nc);
+
+  for (std::size_t jc {0}; jc < b.cols; jc += nc) {
+    const auto nb {std::min(nc, b.cols - jc)};
+    for (std::size_t pc {0}; pc < a.cols; pc += kc) {
+      const auto kb {std::min(kc, a.cols - pc)};
+      gemm_pack_b(b.sub(pc, jc, kb, nb), b_pack.data());
+      for (std::size_t ic {0}; ic < a.rows; ic += mc) {
+        const auto mb {std::min(mc, a.rows - ic)};
+        gemm_pack_a(a.sub(ic, pc, mb, kb), a_pack.data());
+        for (std::size_t jr {0}; jr < nb; jr += blocking::nr) {
+          const auto nrb {std::min(blocking::nr, nb - jr)};
+          const T* b_panel {b_pack.data() + jr * kb};
+          for (std::size_t ir {0}; ir < mb; ir += blocking::mr) {
+            const auto mrb {std::min(blocking::mr, mb - ir)};
+            gemm_micro_kernel(kb, alpha, a_pack.data() + ir * kb, b_panel, c.sub(ic + ir, jc + jr, mrb, nrb));
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Compute "dst = op(lhs, rhs)" for matrices with contiguous rows.
+ *
+ * dst may be lhs or rhs.
+ */
+template<typename T, typename Op>
+void combine(strided_matrix<T> dst, strided_matrix<const T> lhs, strided_matrix<const T> rhs, Op op)
+{
+  assert(dst.col_stride == 1 && lhs.col_stride == 1 && rhs.col_stride == 1);
+  for (std::size_t i {0}; i < dst.rows; ++i) {
+    const auto out {&dst(i, 0)};
+    const auto left {&lhs(i, 0)};
+    const auto right {&rhs(i, 0)};
+    if (out == right)
+      elementwise_apply(out, left, dst.cols, reversed<Op> {});
+    else {
+      if (out != left)
+        std::copy_n(left, dst.cols, out);
+      elementwise_apply(out, right, dst.cols, op);
+    }
+  }
+}
+
+/**
+ * @brief Get count of elements of temporaries for strassen().
+ *
+ * Children of a level run one after another, so they share one region.
+ */
+inline std::size_t strassen_workspace_size(std::size_t m, std::size_t k, std::size_t n, std::size_t cutoff) noexcept
+{
+  if (std::min({m, k, n}) <= cutoff)
+    return 0;
+  const auto hm {m / 2};
+  const auto hk {k / 2};
+  const auto hn {n / 2};
+  return hm * hk + hk * hn + hm * hn + strassen_workspace_size(hm, hk, hn, cutoff);
+}
+
+/**
+ * @brief Strassen-Winograd product "C = A B".
+ *
+ * The schedule keeps the 7 products in C and three temporaries
+ * X (A's quadrant), Y (B's quadrant) and Z (C's quadrant).
+ *
+ * @param[in] workspace Region of strassen_workspace_size() elements.
+ */
+template<typename T>
+void strassen(strided_matrix<const T> a, strided_matrix<const T> b, strided_matrix<T> c, std::size_t cutoff, T* workspace)
+{
+  const auto m {a.rows};
+  const auto k {a.cols};
+  const auto n {b.cols};
+  if (std::min({m, k, n}) <= cutoff) {
+    gemm(T{1}, a, b, false, c);
+    return;
+  }
+  const auto hm {m / 2};
+  const auto hk {k / 2};
+  const auto hn {n / 2};
+  const auto a11 {a.sub(0, 0, hm, hk)};
+  const auto a12 {a.sub(0, hk, hm, hk)};
+  const auto a21 {a.sub(hm, 0, hm, hk)};
+  const auto a22 {a.sub(hm, hk, hm, hk)};
+  const auto b11 {b.sub(0, 0, hk, hn)};
+  const auto b12 {b.sub(0, hn, hk, hn)};
+  const auto b21 {b.sub(hk, 0, hk, hn)};
+  const auto b22 {b.sub(hk, hn, hk, hn)};
+  const auto c11 {c.sub(0, 0, hm, hn)};
+  const auto c12 {c.sub(0, hn, hm, hn)};
+  const auto c21 {c.sub(hm, 0, hm, hn)};
+  const auto c22 {c.sub(hm, hn, hm, hn)};
+  const auto x {make_strided(workspace, hm, hk)};
+  const auto y {make_strided(workspace + hm * hk, hk, hn)};
+  const auto z {make_strided(workspace + hm * hk + hk * hn, hm, hn)};
+  const auto next {workspace + hm * hk + hk * hn + hm * hn};
+  const auto recurse {[cutoff, next](strided_matrix<const T> lhs, strided_matrix<const T> rhs, strided_matrix<T> dst) {
+    strassen(lhs, rhs, dst, cutoff, next);
+  }};
+
+  combine(x, a11, a21, std::minus<> {});          // S3 = A11 - A21
+  combine(y, b22, b12, std::minus<> {});          // T3 = B22 - B12
+  recurse(to_const(x), to_const(y), c21);         // P7 = S3 T3
+  combine(x, a21, a22, std::plus<> {});           // S1 = A21 + A22
+  combine(y, b12, b11, std::minus<> {});          // T1 = B12 - B11
+  recurse(to_const(x), to_const(y), c22);         // P5 = S1 T1
+  combine(x, to_const(x), a11, std::minus<> {});  // S2 = S1 - A11
+  combine(y, b22, to_const(y), std::minus<> {});  // T2 = B22 - T1
+  recurse(to_const(x), to_const(y), c12);         // P6 = S2 T2
+  combine(x, a12, to_const(x), std::minus<> {});  // S4 = A12 - S2
+  recurse(to_const(x), b22, c11);                 // P3 = S4 B22
+  recurse(a11, b11, z);                           // P1 = A11 B11
+  combine(c12, to_const(z), to_const(c12), std::plus<> {});    // U2 = P1 + P6
+  combine(c21, to_const(c12), to_const(c21), std::plus<> {});  // U3 = U2 + P7
+  combine(c12, to_const(c12), to_const(c22), std::plus<> {});  // U4 = U2 + P5
+  combine(c22, to_const(c21), to_const(c22), std::plus<> {});  // C22 = U3 + P5
+  combine(c12, to_const(c12), to_const(c11), std::plus<> {});  // C12 = U4 + P3
+  combine(y, to_const(y), b21, std::minus<> {});  // T4 = T2 - B21
+  recurse(a22, to_const(y), c11);                 // P4 = A22 T4
+  combine(c21, to_const(c21), to_const(c11), std::minus<> {}); // C21 = U3 - P4
+  recurse(a12, b21, c11);                         // P2 = A12 B21
+  combine(c11, to_const(c11), to_const(z), std::plus<> {});    // C11 = P1 + P2
+
+  // Peel the odd row, column and inner dimention.
+  const auto m2 {hm * 2};
+  const auto k2 {hk * 2};
+  const auto n2 {hn * 2};
+  if (k2 < k)
+    gemm(T{1}, a.sub(0, k2, m2, 1), b.sub(k2, 0, 1, n2), true, c.sub(0, 0, m2, n2));
+  if (n2 < n)
+    gemm(T{1}, a.sub(0, 0, m2, k), b.sub(0, n2, k, 1), false, c.sub(0, n2, m2, 1));
+  if (m2 < m)
+    gemm(T{1}, a.sub(m2, 0, 1, k), b, false, c.sub(m2, 0, 1, n));
+}
+
+/**
+ * @brief Find the cheapest parenthesization of matrix chain.
+ *
+ * Operand i has dims[i] rows and dims[i + 1] columns.
+ *
+ * @return split[i * n + j] is the last operand of the left factor of product i..j.
+ */
+inline std::vector<std::size_t> plan_chain(const std::vector<std::size_t>& dims)
+{
+  const auto n {dims.size() - 1};
+  std::vector<std::size_t> cost(n * n);
+  std::vector<std::size_t> split(n * n);
+  for (std::size_t length {1}; length < n; ++length)
+    for (std::size_t i {0}; i + length < n; ++i) {
+      const auto j {i + length};
+      cost[i * n + j] = static_cast<std::size_t>(-1);
+      for (auto k {i}; k < j; ++k) {
+        const auto candidate {cost[i * n + k] + cost[(k + 1) * n + j] + dims[i] * dims[k + 1] * dims[j + 1]};
+        if (candidate < cost[i * n + j]) {
+          cost[i * n + j] = candidate;
+          split[i * n + j] = k;
+        }
+      }
+    }
+  return split;
+}
+
+/**
+ * @brief Evaluate matrix chain by the plan.
+ *
+ * Each intermediate product takes a free scratch buffer,
+ * and the buffers of its operands are freed after the product.
+ */
+template<typename T>
+class chain_evaluator
+{
+public:
+  chain_evaluator(const std::vector<const valmatrix<T>*>& matrices, std::vector<std::size_t> dims)
+    : matrices_ {matrices},
+      dims_ {std::move(dims)},
+      split_ {plan_chain(dims_)}
+  {
+  }
+
+  void evaluate(strided_matrix<T> result)
+  {
+    const auto n {matrices_.size()};
+    if (n == 1) {
+      const auto src {make_strided(matrices_.front()->data(), dims_[0], dims_[1])};
+      for (std::size_t i {0}; i < result.rows; ++i)
+        std::copy_n(&src(i, 0), result.cols, &result(i, 0));
+      return;
+    }
+    const auto k {split_[n - 1]};
+    const auto left {evaluate(0, k)};
+    const auto right {evaluate(k + 1, n - 1)};
+    gemm(T{1}, left.view, right.view, false, result);
+  }
+
+private:
+  static constexpr std::size_t no_buffer {static_cast<std::size_t>(-1)};
+
+  struct operand
+  {
+    strided_matrix<const T> view;
+    std::size_t buffer;
+  };
+
+  operand evaluate(std::size_t i, std::size_t j)
+  {
+    if (i == j)
+      return {make_strided(matrices_[i]->data(), dims_[i], dims_[i + 1]), no_buffer};
+    const auto k {split_[i * matrices_.size() + j]};
+    const auto left {evaluate(i, k)};
+    const auto right {evaluate(k + 1, j)};
+    const auto buffer {acquire(dims_[i] * dims_[j + 1])};
+    const auto product {make_strided(buffers_[buffer].data(), dims_[i], dims_[j + 1])};
+    gemm(T{1}, left.view, right.view, false, product);
+    release(left.buffer);
+    release(right.buffer);
+    return {to_const(product), buffer};
+  }
+
+  std::size_t acquire(std::size_t size)
+  {
+    std::size_t buffer {buffers_.size()};
+    if (free_.empty())
+      buffers_.emplace_back();
+    else {
+      buffer = free_.back();
+      free_.pop_back();
+    }
+    buffers_[buffer].resize(size);
+    return buffer;
+  }
+
+  void release(std::size_t buffer)
+  {
+    if (buffer != no_buffer)
+      free_.push_back(buffer);
+  }
+
+  const std::vector<const valmatrix<T>*>& matrices_;
+  std::vector<std::size_t> dims_;
+  std::vector<std::size_t> split_;
+  std::vector<std::vector<T>> buffers_;
+  std::vector<std::size_t> free_;
+};
+
+template<typename T>
+strided_matrix<const T> make_strided(const valmatrix<T>& m) noexcept
+{
+  return make_strided(m.data(), m.col_size(), m.row_size());
+}
+
+template<typename T>
+strided_matrix<T> make_strided(valmatrix<T>& m) noexcept
+{
+  return make_strided(m.data(), m.col_size(), m.row_size());
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const valmatrix<T>& a, const valmatrix<T>& b)
+{
+  valmatrix<T> result(b.row_size(), a.col_size());
+  matmul(a, b, result);
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::matmul(const valmatrix<T>& a, const valmatrix<T>& b, valmatrix<T>& result)
+{
+  assert(a.row_size() == b.col_size());
+  assert(result.row_size() == b.row_size());
+  assert(result.col_size() == a.col_size());
+  assert(&result != &a && &result != &b);
+  detail::gemm(T{1}, detail::make_strided(a), detail::make_strided(b), false, detail::make_strided(result));
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::strassen_matmul(const valmatrix<T>& a, const valmatrix<T>& b, std::size_t cutoff)
+{
+  valmatrix<T> result(b.row_size(), a.col_size());
+  strassen_matmul(a, b, result, cutoff);
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::strassen_matmul(const valmatrix<T>& a, const valmatrix<T>& b, valmatrix<T>& result, std::size_t cutoff)
+{
+  assert(a.row_size() == b.col_size());
+  assert(result.row_size() == b.row_size());
+  assert(result.col_size() == a.col_size());
+  assert(&result != &a && &result != &b);
+  // Recursion needs a nonempty half size product.
+  cutoff = std::max<std::size_t>(cutoff, 1);
+  std::vector<T> workspace(detail::strassen_workspace_size(a.col_size(), a.row_size(), b.row_size(), cutoff));
+  detail::strassen(detail::make_strided(a), detail::make_strided(b), detail::make_strided(result), cutoff, workspace.data());
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::multiply_chain(const std::vector<const valmatrix<T>*>& matrices)
+{
+  assert(!matrices.empty());
+  std::vector<std::size_t> dims {matrices.front()->col_size()};
+  for (const auto m : matrices) {
+    assert(m->col_size() == dims.back());
+    dims.push_back(m->row_size());
+  }
+  valmatrix<T> result(dims.back(), dims.front());
+  if (result.size())
+    detail::chain_evaluator<T> {matrices, std::move(dims)}.evaluate(detail::make_strided(result));
+  return result;
+}
+
+template<typename T, typename... Matrices>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::multiply_chain(const valmatrix<T>& first, const Matrices&... rest)
+{
+  return multiply_chain(std::vector<const valmatrix<T>*> {&first, &rest...});
+}
+
+#endif
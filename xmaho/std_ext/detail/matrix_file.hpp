@@ -0,0 +1,104 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_MATRIX_FILE_H
+#define XMAHO_STD_EXT_DETAIL_MATRIX_FILE_H
+
+#include "../matrix_file.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename T>
+constexpr matrix_value_kind value_kind_of() noexcept
+{
+  static_assert(std::is_arithmetic_v<T>, "matrix file requires arithmetic element");
+  if constexpr (std::is_floating_point_v<T>)
+    return matrix_value_kind::floating_point;
+  else if constexpr (std::is_signed_v<T>)
+    return matrix_value_kind::signed_integer;
+  else
+    return matrix_value_kind::unsigned_integer;
+}
+
+}
+
+template<typename T>
+constexpr xmaho::std_ext::matrix_file_header xmaho::std_ext::make_matrix_file_header(std::size_t row_size, std::size_t col_size) noexcept
+{
+  return {matrix_file_magic, matrix_file_version, matrix_file_endian_tag,
+          sizeof(T), detail::value_kind_of<T>(), row_size, col_size, 0, 0, {}};
+}
+
+inline void xmaho::std_ext::matrix_file_checksum::update(const void* data, std::size_t size) noexcept
+{
+  const auto bytes {static_cast<const unsigned char*>(data)};
+  auto sum {sum_};
+  auto sum_of_sum {sum_of_sum_};
+  std::size_t i {0};
+  for (; i + 4 <= size; i += 4) {
+    sum += static_cast<std::uint32_t>(bytes[i]) | static_cast<std::uint32_t>(bytes[i + 1]) << 8 |
+           static_cast<std::uint32_t>(bytes[i + 2]) << 16 | static_cast<std::uint32_t>(bytes[i + 3]) << 24;
+    sum_of_sum += sum;
+  }
+  if (i < size) {
+    std::uint32_t word {0};
+    for (std::size_t j {0}; i + j < size; ++j)
+      word |= static_cast<std::uint32_t>(bytes[i + j]) << (8 * j);
+    sum += word;
+    sum_of_sum += sum;
+  }
+  sum_ = sum;
+  sum_of_sum_ = sum_of_sum;
+}
+
+inline std::uint64_t xmaho::std_ext::matrix_file_checksum::value() const noexcept
+{
+  return static_cast<std::uint64_t>(sum_of_sum_) << 32 | sum_;
+}
+
+template<typename T>
+void xmaho::std_ext::check_matrix_file_header(const matrix_file_header& header)
+{
+  if (header.magic != matrix_file_magic)
+    throw std::runtime_error{"xmaho::std_ext::check_matrix_file_header : not matrix file"};
+  if (header.version != matrix_file_version)
+    throw std::runtime_error{"xmaho::std_ext::check_matrix_file_header : unsupported version"};
+  if (header.endian_tag != matrix_file_endian_tag)
+    throw std::runtime_error{"xmaho::std_ext::check_matrix_file_header : different byte order"};
+  if (header.value_size != sizeof(T) || header.value_kind != detail::value_kind_of<T>())
+    throw std::runtime_error{"xmaho::std_ext::check_matrix_file_header : different element type"};
+  if (std::any_of(header.reserved.begin(), header.reserved.end(), [](std::uint32_t e) { return e != 0; }))
+    throw std::runtime_error{"xmaho::std_ext::check_matrix_file_header : reserved field is not zero"};
+}
+
+#endif
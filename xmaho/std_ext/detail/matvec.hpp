@@ -0,0 +1,173 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_MATVEC_H
+#define XMAHO_STD_EXT_DETAIL_MATVEC_H
+
+#include "../matvec.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename T>
+constexpr bool is_equal_value(const T& lhs, const T& rhs)
+{
+  return !(lhs < rhs) && !(rhs < lhs);
+}
+
+/**
+ * @brief Compute "y = beta y" without reading y if beta is zero.
+ */
+template<typename T>
+void scale_vector(T* y, const T& beta, std::size_t n)
+{
+  if (is_equal_value(beta, T{}))
+    std::fill_n(y, n, T{});
+  else if (!is_equal_value(beta, T{1}))
+    elementwise_apply_value(y, beta, n, std::multiplies<>{});
+}
+
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::gemv(const valmatrix<T>& a, const std::valarray<T>& x)
+{
+  std::valarray<T> y(a.col_size());
+  gemv(T{1}, a, x, T{}, y);
+  return y;
+}
+
+template<typename T>
+std::valarray<T>& xmaho::std_ext::gemv(const T& alpha, const valmatrix<T>& a, const std::valarray<T>& x, const T& beta, std::valarray<T>& y, transpose_mode trans)
+{
+  const auto rows {a.col_size()};
+  const auto cols {a.row_size()};
+  const auto data {a.data()};
+  const auto src {detail::valarray_data(x)};
+  const auto dst {detail::valarray_data(y)};
+  if (trans == transpose_mode::none) {
+    assert(cols == x.size() && rows == y.size());
+    detail::scale_vector(dst, beta, rows);
+    for (std::size_t i {0}; i < rows; ++i)
+      dst[i] += alpha * detail::dot_product(data + i * cols, src, cols);
+  }
+  else {
+    assert(rows == x.size() && cols == y.size());
+    detail::scale_vector(dst, beta, cols);
+    for (std::size_t i {0}; i < rows; ++i)
+      detail::multiply_accumulate_value(dst, data + i * cols, static_cast<T>(alpha * src[i]), cols);
+  }
+  return y;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::ger(const T& alpha, const std::valarray<T>& x, const std::valarray<T>& y, valmatrix<T>& a)
+{
+  const auto rows {a.col_size()};
+  const auto cols {a.row_size()};
+  assert(rows == x.size() && cols == y.size());
+  const auto data {a.data()};
+  const auto src {detail::valarray_data(y)};
+  for (std::size_t i {0}; i < rows; ++i)
+    detail::multiply_accumulate_value(data + i * cols, src, static_cast<T>(alpha * x[i]), cols);
+  return a;
+}
+
+template<typename T>
+std::valarray<T>& xmaho::std_ext::trsv(const valmatrix<T>& a, std::valarray<T>& x, triangle uplo, transpose_mode trans, diagonal diag)
+{
+  const auto n {a.row_size()};
+  assert(n == a.col_size() && n == x.size());
+  const auto data {a.data()};
+  const auto v {detail::valarray_data(x)};
+  const auto unit {diag == diagonal::unit};
+  // Solving with A reads the solved part of each row as inner product,
+  // and solving with A^T eliminates the solved element from the rest with the row.
+  if (trans == transpose_mode::none) {
+    if (uplo == triangle::lower)
+      for (std::size_t i {0}; i < n; ++i) {
+        const auto row {data + i * n};
+        v[i] -= detail::dot_product(row, v, i);
+        if (!unit)
+          v[i] /= row[i];
+      }
+    else
+      for (auto i {n}; i-- > 0;) {
+        const auto row {data + i * n};
+        v[i] -= detail::dot_product(row + i + 1, v + i + 1, n - i - 1);
+        if (!unit)
+          v[i] /= row[i];
+      }
+  }
+  else {
+    if (uplo == triangle::lower)
+      for (auto i {n}; i-- > 0;) {
+        const auto row {data + i * n};
+        if (!unit)
+          v[i] /= row[i];
+        detail::multiply_accumulate_value(v, row, static_cast<T>(-v[i]), i);
+      }
+    else
+      for (std::size_t i {0}; i < n; ++i) {
+        const auto row {data + i * n};
+        if (!unit)
+          v[i] /= row[i];
+        detail::multiply_accumulate_value(v + i + 1, row + i + 1, static_cast<T>(-v[i]), n - i - 1);
+      }
+  }
+  return x;
+}
+
+template<typename T>
+std::valarray<T>& xmaho::std_ext::symv(const T& alpha, const valmatrix<T>& a, const std::valarray<T>& x, const T& beta, std::valarray<T>& y, triangle uplo)
+{
+  const auto n {a.row_size()};
+  assert(n == a.col_size() && n == x.size() && n == y.size());
+  const auto data {a.data()};
+  const auto src {detail::valarray_data(x)};
+  const auto dst {detail::valarray_data(y)};
+  detail::scale_vector(dst, beta, n);
+  // The stored part of row i is used twice: as row i of A, and as column i of A.
+  for (std::size_t i {0}; i < n; ++i) {
+    const auto row {data + i * n};
+    const auto first {uplo == triangle::lower ? std::size_t {0} : i + 1};
+    const auto count {uplo == triangle::lower ? i : n - i - 1};
+    const T scaled {static_cast<T>(alpha * src[i])};
+    dst[i] += alpha * (row[i] * src[i] + detail::dot_product(row + first, src + first, count));
+    detail::multiply_accumulate_value(dst + first, row + first, scaled, count);
+  }
+  return y;
+}
+
+#endif
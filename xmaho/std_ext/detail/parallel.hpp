@@ -0,0 +1,368 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_PARALLEL_H
+#define XMAHO_STD_EXT_DETAIL_PARALLEL_H
+
+#include "../parallel.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Assumed size of cache line. Chunk boundaries are aligned to it to avoid false sharing.
+constexpr std::size_t cache_line_size {64};
+
+/**
+ * @brief Partition of the storage into chunks.
+ *
+ * Boundaries except both ends are placed at cache line boundaries of the address.
+ */
+template<typename T>
+class chunk_partition
+{
+public:
+  chunk_partition(const T* data, std::size_t size, std::size_t thread_count, std::size_t grain_size) noexcept
+    : size_ {size},
+      count_ {std::clamp<std::size_t>(size / std::max(grain_size, line), 1, thread_count)},
+      offset_ {get_offset(data)}
+  {
+  }
+
+  std::size_t count() const noexcept
+  {
+    return count_;
+  }
+
+  std::pair<std::size_t, std::size_t> range(std::size_t chunk) const noexcept
+  {
+    return {boundary(chunk), boundary(chunk + 1)};
+  }
+
+private:
+  static constexpr std::size_t line {std::max<std::size_t>(cache_line_size / sizeof(T), 1)};
+
+  static std::size_t get_offset(const T* data) noexcept
+  {
+    const auto address {reinterpret_cast<std::uintptr_t>(data)};
+    return (cache_line_size - address % cache_line_size) % cache_line_size / sizeof(T) % line;
+  }
+
+  std::size_t boundary(std::size_t chunk) const noexcept
+  {
+    if (chunk == 0)
+      return 0;
+    if (chunk >= count_)
+      return size_;
+    const auto even {size_ / count_ * chunk + size_ % count_ * chunk / count_};
+    if (even <= offset_)
+      return std::min(offset_, size_);
+    return std::min((even - offset_ + line - 1) / line * line + offset_, size_);
+  }
+
+  std::size_t size_;
+  std::size_t count_;
+  std::size_t offset_;
+};
+
+/**
+ * @brief Call "function(chunk, begin, end)" for each chunk of partition.
+ *
+ * Chunk i is always assigned to thread i modulo thread count.
+ * Single chunk is processed by the calling thread without waking workers.
+ */
+template<typename T, typename F>
+void parallel_for_chunks(parallel_context& context, const chunk_partition<T>& partition, F function)
+{
+  if (partition.count() == 1) {
+    const auto [begin, end] {partition.range(0)};
+    function(std::size_t {0}, begin, end);
+    return;
+  }
+  context.run([&](std::size_t thread) {
+    for (auto chunk {thread}; chunk < partition.count(); chunk += context.thread_count()) {
+      const auto [begin, end] {partition.range(chunk)};
+      function(chunk, begin, end);
+    }
+  });
+}
+
+template<typename T, typename U, typename Op>
+void parallel_apply(parallel_context& context, valmatrix<T>& m, const U& rhs, Op op)
+{
+  const auto dst {m.data()};
+  const chunk_partition<T> partition {dst, m.size(), context.thread_count(), context.grain_size()};
+  if constexpr (std::is_same_v<U, valmatrix<T>>) {
+    assert(rhs.row_size() == m.row_size() && rhs.col_size() == m.col_size());
+    const auto src {rhs.data()};
+    parallel_for_chunks(context, partition, [dst, src, op](std::size_t, std::size_t begin, std::size_t end) {
+      elementwise_apply(dst + begin, src + begin, end - begin, op);
+    });
+  }
+  else if constexpr (std::is_same_v<U, std::valarray<T>>) {
+    assert(rhs.size() == m.size());
+    const auto src {valarray_data(rhs)};
+    parallel_for_chunks(context, partition, [dst, src, op](std::size_t, std::size_t begin, std::size_t end) {
+      elementwise_apply(dst + begin, src + begin, end - begin, op);
+    });
+  }
+  else {
+    const T value {static_cast<T>(rhs)};
+    parallel_for_chunks(context, partition, [dst, &value, op](std::size_t, std::size_t begin, std::size_t end) {
+      elementwise_apply_value(dst + begin, value, end - begin, op);
+    });
+  }
+}
+
+template<typename T, typename Reduce>
+T parallel_reduce(parallel_context& context, const valmatrix<T>& m, Reduce reduce)
+{
+  assert(m.size());
+  const auto src {m.data()};
+  const chunk_partition<T> partition {src, m.size(), context.thread_count(), context.grain_size()};
+  std::vector<T> partials(partition.count());
+  parallel_for_chunks(context, partition, [src, &partials, reduce](std::size_t chunk, std::size_t begin, std::size_t end) {
+    T result {src[begin]};
+    for (auto i {begin + 1}; i < end; ++i)
+      result = static_cast<T>(reduce(result, src[i]));
+    partials[chunk] = result;
+  });
+  T result {partials.front()};
+  for (std::size_t chunk {1}; chunk < partials.size(); ++chunk)
+    result = static_cast<T>(reduce(result, partials[chunk]));
+  return result;
+}
+
+template<typename T, typename Op>
+xmaho::std_ext::valmatrix<T> parallel_transform(parallel_context& context, const valmatrix<T>& m, Op op)
+{
+  valmatrix<T> result(m.row_size(), m.col_size());
+  const auto src {m.data()};
+  const auto dst {result.data()};
+  const chunk_partition<T> partition {src, m.size(), context.thread_count(), context.grain_size()};
+  parallel_for_chunks(context, partition, [src, dst, op](std::size_t, std::size_t begin, std::size_t end) {
+    for (auto i {begin}; i < end; ++i)
+      dst[i] = static_cast<T>(op(src[i]));
+  });
+  return result;
+}
+
+}
+
+inline xmaho::std_ext::parallel_context::parallel_context(size_type thread_count, size_type grain_size)
+  : grain_size_ {grain_size}
+{
+  if (!thread_count)
+    thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  workers_.reserve(thread_count - 1);
+  for (size_type i {1}; i < thread_count; ++i)
+    workers_.emplace_back(&parallel_context::work, this, i);
+}
+
+inline xmaho::std_ext::parallel_context::~parallel_context()
+{
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+inline xmaho::std_ext::parallel_context::size_type xmaho::std_ext::parallel_context::thread_count() const noexcept
+{
+  return workers_.size() + 1;
+}
+
+inline xmaho::std_ext::parallel_context::size_type xmaho::std_ext::parallel_context::grain_size() const noexcept
+{
+  return grain_size_;
+}
+
+inline void xmaho::std_ext::parallel_context::run(const std::function<void(size_type)>& function)
+{
+  std::lock_guard<std::mutex> run_lock {run_mutex_};
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    task_ = &function;
+    exception_ = nullptr;
+    pending_ = workers_.size();
+    ++generation_;
+  }
+  wake_.notify_all();
+  std::exception_ptr exception {};
+  try {
+    function(0);
+  }
+  catch (...) {
+    exception = std::current_exception();
+  }
+  std::unique_lock<std::mutex> lock {mutex_};
+  done_.wait(lock, [this] {return pending_ == 0;});
+  task_ = nullptr;
+  if (!exception)
+    exception = exception_;
+  lock.unlock();
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+inline void xmaho::std_ext::parallel_context::work(size_type index)
+{
+  size_type generation {0};
+  while (true) {
+    std::unique_lock<std::mutex> lock {mutex_};
+    wake_.wait(lock, [this, generation] {return stop_ || generation_ != generation;});
+    if (stop_)
+      return;
+    generation = generation_;
+    const auto task {task_};
+    lock.unlock();
+    std::exception_ptr exception {};
+    try {
+      (*task)(index);
+    }
+    catch (...) {
+      exception = std::current_exception();
+    }
+    lock.lock();
+    if (exception && !exception_)
+      exception_ = exception;
+    if (--pending_ == 0)
+      done_.notify_one();
+  }
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::plus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::plus<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::minus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::minus<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::multiplies_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::multiplies<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::divides_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::divides<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::modulus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::modulus<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::bit_and_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::bit_and<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::bit_or_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::bit_or<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::bit_xor_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, std::bit_xor<>{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::shift_left_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, detail::shift_left{});
+  return m;
+}
+
+template<typename T, typename U>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::shift_right_assign(parallel_context& context, valmatrix<T>& m, const U& rhs)
+{
+  detail::parallel_apply(context, m, rhs, detail::shift_right{});
+  return m;
+}
+
+template<typename T>
+T xmaho::std_ext::sum(parallel_context& context, const valmatrix<T>& m)
+{
+  return detail::parallel_reduce(context, m, std::plus<>{});
+}
+
+template<typename T>
+T xmaho::std_ext::min(parallel_context& context, const valmatrix<T>& m)
+{
+  return detail::parallel_reduce(context, m, [](const T& lhs, const T& rhs) {return std::min(lhs, rhs);});
+}
+
+template<typename T>
+T xmaho::std_ext::max(parallel_context& context, const valmatrix<T>& m)
+{
+  return detail::parallel_reduce(context, m, [](const T& lhs, const T& rhs) {return std::max(lhs, rhs);});
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::negate(parallel_context& context, const valmatrix<T>& m)
+{
+  return detail::parallel_transform(context, m, std::negate<>{});
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::bit_not(parallel_context& context, const valmatrix<T>& m)
+{
+  return detail::parallel_transform(context, m, std::bit_not<>{});
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_REDUCTION_H
+#define XMAHO_STD_EXT_DETAIL_REDUCTION_H
+
+#include "../reduction.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+struct minimum
+{
+  template<typename T>
+  constexpr const T& operator()(const T& lhs, const T& rhs) const
+  {
+    return std::min(lhs, rhs);
+  }
+};
+
+struct maximum
+{
+  template<typename T>
+  constexpr const T& operator()(const T& lhs, const T& rhs) const
+  {
+    return std::max(lhs, rhs);
+  }
+};
+
+template<typename T, typename Op>
+std::valarray<T> reduce_rows(const valmatrix<T>& m, Op op)
+{
+  std::valarray<T> result(m.col_size());
+  const auto cols {m.row_size()};
+  const auto data {m.data()};
+  for (std::size_t i {0}; i < m.col_size(); ++i) {
+    const auto row {data + i * cols};
+    T value {row[0]};
+    for (std::size_t j {1}; j < cols; ++j)
+      value = static_cast<T>(op(value, row[j]));
+    result[i] = value;
+  }
+  return result;
+}
+
+template<typename T, typename Op>
+std::valarray<T> reduce_cols(const valmatrix<T>& m, Op op)
+{
+  if (!m.size())
+    return {};
+  const auto cols {m.row_size()};
+  const auto data {m.data()};
+  std::valarray<T> result(data, cols);
+  const auto dst {valarray_data(result)};
+  for (std::size_t i {1}; i < m.col_size(); ++i)
+    elementwise_apply(dst, data + i * cols, cols, op);
+  return result;
+}
+
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::row_sum(const valmatrix<T>& m)
+{
+  return detail::reduce_rows(m, std::plus<>{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::row_min(const valmatrix<T>& m)
+{
+  assert(m.size());
+  return detail::reduce_rows(m, detail::minimum{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::row_max(const valmatrix<T>& m)
+{
+  assert(m.size());
+  return detail::reduce_rows(m, detail::maximum{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::row_mean(const valmatrix<T>& m)
+{
+  auto result {row_sum(m)};
+  if (m.size())
+    result /= static_cast<T>(m.row_size());
+  return result;
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::col_sum(const valmatrix<T>& m)
+{
+  return detail::reduce_cols(m, std::plus<>{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::col_min(const valmatrix<T>& m)
+{
+  assert(m.size());
+  return detail::reduce_cols(m, detail::minimum{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::col_max(const valmatrix<T>& m)
+{
+  assert(m.size());
+  return detail::reduce_cols(m, detail::maximum{});
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::col_mean(const valmatrix<T>& m)
+{
+  auto result {col_sum(m)};
+  if (m.size())
+    result /= static_cast<T>(m.col_size());
+  return result;
+}
+
+#endif
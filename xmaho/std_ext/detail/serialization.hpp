@@ -0,0 +1,190 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_SERIALIZATION_H
+#define XMAHO_STD_EXT_DETAIL_SERIALIZATION_H
+
+#include "../serialization.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xmaho::std_ext::detail
+{
+
+constexpr std::size_t serialization_chunk_size {std::size_t{1} << 20};
+
+template<typename U>
+U byteswap(U value) noexcept
+{
+  unsigned char bytes[sizeof(U)];
+  std::memcpy(bytes, &value, sizeof(U));
+  std::reverse(std::begin(bytes), std::end(bytes));
+  std::memcpy(&value, bytes, sizeof(U));
+  return value;
+}
+
+inline void byteswap(matrix_file_header& header) noexcept
+{
+  header.version = byteswap(header.version);
+  header.endian_tag = byteswap(header.endian_tag);
+  header.value_size = byteswap(header.value_size);
+  header.value_kind = static_cast<matrix_value_kind>(byteswap(static_cast<std::uint32_t>(header.value_kind)));
+  header.row_size = byteswap(header.row_size);
+  header.col_size = byteswap(header.col_size);
+  header.checksum = byteswap(header.checksum);
+  header.flags = byteswap(header.flags);
+}
+
+template<typename T>
+void write_matrix_file(std::ostream& os, const T* data, std::size_t row_size, std::size_t col_size, bool checksum)
+{
+  auto header {make_matrix_file_header<T>(row_size, col_size)};
+  const auto bytes {reinterpret_cast<const char*>(data)};
+  const auto byte_size {row_size * col_size * sizeof(T)};
+  if (checksum) {
+    matrix_file_checksum sum;
+    sum.update(bytes, byte_size);
+    header.checksum = sum.value();
+    header.flags |= matrix_file_checksum_flag;
+  }
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (std::size_t offset {0}; offset < byte_size && os; offset += serialization_chunk_size)
+    os.write(bytes + offset, static_cast<std::streamsize>(std::min(serialization_chunk_size, byte_size - offset)));
+}
+
+inline std::optional<std::size_t> remaining_size(std::istream& is)
+{
+  const auto position {is.tellg()};
+  if (position == std::istream::pos_type(-1))
+    return std::nullopt;
+  is.seekg(0, std::ios_base::end);
+  const auto end {is.tellg()};
+  is.clear();
+  is.seekg(position);
+  if (end == std::istream::pos_type(-1) || !is)
+    return std::nullopt;
+  return static_cast<std::size_t>(end - position);
+}
+
+template<typename T>
+std::pair<matrix_file_header, std::valarray<T>> read_matrix_file(std::istream& is, const char* function)
+{
+  const auto fail = [function](const char* message) {
+    throw std::runtime_error{std::string{function} + " : " + message};
+  };
+
+  matrix_file_header header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    fail("failed to read header");
+  const auto swapped {header.endian_tag == byteswap(matrix_file_endian_tag)};
+  if (swapped)
+    byteswap(header);
+  try {
+    check_matrix_file_header<T>(header);
+  }
+  catch (const std::runtime_error& e) {
+    fail(e.what());
+  }
+  if (header.row_size && header.col_size > std::numeric_limits<std::size_t>::max() / sizeof(T) / header.row_size)
+    fail("matrix is too large");
+
+  const std::size_t count = header.row_size * header.col_size;
+  const auto byte_size {count * sizeof(T)};
+  matrix_file_checksum sum;
+  const auto read_chunk = [&](char* bytes, std::size_t size) {
+    if (!is.read(bytes, static_cast<std::streamsize>(size)))
+      fail("failed to read payload");
+    sum.update(bytes, size);
+  };
+
+  std::valarray<T> values;
+  const auto remaining {remaining_size(is)};
+  if (remaining) {
+    if (*remaining < byte_size)
+      fail("failed to read payload");
+    values.resize(count);
+    const auto bytes {reinterpret_cast<char*>(valarray_data(values))};
+    for (std::size_t offset {0}; offset < byte_size; offset += serialization_chunk_size)
+      read_chunk(bytes + offset, std::min(serialization_chunk_size, byte_size - offset));
+  }
+  else {
+    // The size is unknown, so the buffer grows only as the payload arrives.
+    std::vector<T> buffer;
+    for (std::size_t offset {0}; offset < byte_size; offset += serialization_chunk_size) {
+      const auto chunk {std::min(serialization_chunk_size, byte_size - offset)};
+      buffer.resize((offset + chunk) / sizeof(T));
+      read_chunk(reinterpret_cast<char*>(buffer.data()) + offset, chunk);
+    }
+    values = std::valarray<T>(buffer.data(), buffer.size());
+  }
+  if (header.flags & matrix_file_checksum_flag && header.checksum != sum.value())
+    fail("checksum mismatch");
+  if (swapped)
+    for (auto& e : values)
+      e = byteswap(e);
+  return {header, std::move(values)};
+}
+
+}
+
+template<typename T>
+std::ostream& xmaho::std_ext::serialize(std::ostream& os, const valmatrix<T>& m, bool checksum)
+{
+  detail::write_matrix_file(os, m.data(), m.row_size(), m.col_size(), checksum);
+  return os;
+}
+
+template<typename T>
+std::ostream& xmaho::std_ext::serialize(std::ostream& os, const std::valarray<T>& v, bool checksum)
+{
+  detail::write_matrix_file(os, detail::valarray_data(v), v.size(), v.size() ? 1 : 0, checksum);
+  return os;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::deserialize_valmatrix(std::istream& is)
+{
+  auto [header, values] {detail::read_matrix_file<T>(is, "xmaho::std_ext::deserialize_valmatrix")};
+  return {std::move(values), header.row_size, header.col_size};
+}
+
+template<typename T>
+std::valarray<T> xmaho::std_ext::deserialize_valarray(std::istream& is)
+{
+  return detail::read_matrix_file<T>(is, "xmaho::std_ext::deserialize_valarray").second;
+}
+
+#endif
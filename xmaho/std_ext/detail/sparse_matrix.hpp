@@ -0,0 +1,468 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_SPARSE_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_SPARSE_MATRIX_H
+
+#include "../sparse_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename T>
+bool is_zero(const T& value)
+{
+  return std::equal_to<>{}(value, T{});
+}
+
+/**
+ * @brief Merge sorted rows (CSR) or columns (CSC) of two sparse matrices.
+ *
+ * Zero results are not stored.
+ *
+ * @param[in] keep_union Keep elements that only one side has if true, otherwise intersection.
+ */
+template<typename T, sparse_major Major, typename Op>
+sparse_matrix<T, Major> sparse_merge(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs, Op op, bool keep_union)
+{
+  assert(lhs.row_size() == rhs.row_size());
+  assert(lhs.col_size() == rhs.col_size());
+  const auto& lo {lhs.outer_index()};
+  const auto& li {lhs.inner_index()};
+  const auto& lv {lhs.values()};
+  const auto& ro {rhs.outer_index()};
+  const auto& ri {rhs.inner_index()};
+  const auto& rv {rhs.values()};
+  std::vector<std::size_t> outer(lo.size());
+  std::vector<std::size_t> inner {};
+  std::vector<T> values {};
+  const auto store {[&inner, &values](std::size_t index, T value) {
+    if (is_zero(value))
+      return;
+    inner.push_back(index);
+    values.push_back(std::move(value));
+  }};
+  for (std::size_t o {0}; o + 1 < lo.size(); ++o) {
+    auto l {lo[o]};
+    auto r {ro[o]};
+    while (l < lo[o + 1] || r < ro[o + 1]) {
+      if (r == ro[o + 1] || (l < lo[o + 1] && li[l] < ri[r])) {
+        if (keep_union)
+          store(li[l], static_cast<T>(op(lv[l], T{})));
+        ++l;
+      }
+      else if (l == lo[o + 1] || ri[r] < li[l]) {
+        if (keep_union)
+          store(ri[r], static_cast<T>(op(T{}, rv[r])));
+        ++r;
+      }
+      else {
+        store(li[l], static_cast<T>(op(lv[l], rv[r])));
+        ++l;
+        ++r;
+      }
+    }
+    outer[o + 1] = values.size();
+  }
+  return {std::move(outer), std::move(inner), std::move(values), lhs.row_size(), lhs.col_size()};
+}
+
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix()
+  : size_ {0, 0},
+    outer_(1)
+{
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix(size_type row_size, size_type col_size)
+  : size_ {detail::get_init_size(row_size, col_size)},
+    outer_(outer_size() + 1)
+{
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix(std::vector<entry_type> entries, size_type row_size, size_type col_size)
+  : sparse_matrix(row_size, col_size)
+{
+  for (auto& entry : entries) {
+    assert(entry.first.first < this->row_size());
+    assert(entry.first.second < this->col_size());
+    entry.first = to_outer_inner(entry.first);
+  }
+  std::sort(entries.begin(), entries.end(), [](const entry_type& lhs, const entry_type& rhs) {return lhs.first < rhs.first;});
+  for (auto first {entries.begin()}; first != entries.end();) {
+    auto value {first->second};
+    auto last {std::next(first)};
+    for (; last != entries.end() && last->first == first->first; ++last)
+      value += last->second;
+    if (!detail::is_zero(value)) {
+      ++outer_[first->first.first + 1];
+      inner_.push_back(first->first.second);
+      values_.push_back(std::move(value));
+    }
+    first = last;
+  }
+  std::partial_sum(outer_.begin(), outer_.end(), outer_.begin());
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix(std::vector<size_type> outer_index, std::vector<size_type> inner_index, std::vector<T> values,
+                                                       size_type row_size, size_type col_size)
+  : size_ {detail::get_init_size(row_size, col_size)},
+    outer_ {std::move(outer_index)},
+    inner_ {std::move(inner_index)},
+    values_ {std::move(values)}
+{
+  assert(outer_.size() == outer_size() + 1);
+  assert(outer_.front() == 0 && outer_.back() == values_.size());
+  assert(inner_.size() == values_.size());
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix(const valmatrix<T>& m)
+  : sparse_matrix(m.row_size(), m.col_size())
+{
+  const auto data {m.data()};
+  const auto inner_size {Major == sparse_major::row ? row_size() : col_size()};
+  for (size_type o {0}; o < outer_size(); ++o) {
+    for (size_type i {0}; i < inner_size; ++i) {
+      const auto& value {Major == sparse_major::row ? data[o * row_size() + i] : data[i * row_size() + o]};
+      if (detail::is_zero(value))
+        continue;
+      inner_.push_back(i);
+      values_.push_back(value);
+    }
+    outer_[o + 1] = values_.size();
+  }
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+template<xmaho::std_ext::sparse_major Other, typename>
+xmaho::std_ext::sparse_matrix<T, Major>::sparse_matrix(const sparse_matrix<T, Other>& other)
+  : sparse_matrix(other.row_size(), other.col_size())
+{
+  // Counting sort by inner index of other, that is outer index of this.
+  const auto& other_outer {other.outer_index()};
+  const auto& other_inner {other.inner_index()};
+  const auto& other_values {other.values()};
+  for (const auto i : other_inner)
+    ++outer_[i + 1];
+  std::partial_sum(outer_.begin(), outer_.end(), outer_.begin());
+  inner_.resize(other_inner.size());
+  values_.resize(other_values.size());
+  std::vector<size_type> next(outer_.begin(), std::prev(outer_.end()));
+  for (size_type o {0}; o + 1 < other_outer.size(); ++o)
+    for (auto k {other_outer[o]}; k < other_outer[o + 1]; ++k) {
+      const auto position {next[other_inner[k]]++};
+      inner_[position] = o;
+      values_[position] = other_values[k];
+    }
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+T xmaho::std_ext::sparse_matrix<T, Major>::operator[](position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  const auto [outer, inner] {to_outer_inner(position)};
+  const auto first {inner_.begin() + static_cast<std::ptrdiff_t>(outer_[outer])};
+  const auto last {inner_.begin() + static_cast<std::ptrdiff_t>(outer_[outer + 1])};
+  const auto found {std::lower_bound(first, last, inner)};
+  if (found == last || *found != inner)
+    return T{};
+  return values_[static_cast<size_type>(found - inner_.begin())];
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::sparse_matrix<T, Major>::operator-() const
+{
+  auto result {*this};
+  for (auto& value : result.values_)
+    value = static_cast<T>(-value);
+  return result;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>& xmaho::std_ext::sparse_matrix<T, Major>::operator*=(const T& rhs) &
+{
+  for (auto& value : values_)
+    value *= rhs;
+  erase_zeros();
+  return *this;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major>& xmaho::std_ext::sparse_matrix<T, Major>::operator/=(const T& rhs) &
+{
+  for (auto& value : values_)
+    value /= rhs;
+  erase_zeros();
+  return *this;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+typename xmaho::std_ext::sparse_matrix<T, Major>::size_type xmaho::std_ext::sparse_matrix<T, Major>::row_size() const noexcept
+{
+  return size_.first;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+typename xmaho::std_ext::sparse_matrix<T, Major>::size_type xmaho::std_ext::sparse_matrix<T, Major>::col_size() const noexcept
+{
+  return size_.second;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+typename xmaho::std_ext::sparse_matrix<T, Major>::size_type xmaho::std_ext::sparse_matrix<T, Major>::nonzero_size() const noexcept
+{
+  return values_.size();
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+const std::vector<typename xmaho::std_ext::sparse_matrix<T, Major>::size_type>&
+xmaho::std_ext::sparse_matrix<T, Major>::outer_index() const noexcept
+{
+  return outer_;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+const std::vector<typename xmaho::std_ext::sparse_matrix<T, Major>::size_type>&
+xmaho::std_ext::sparse_matrix<T, Major>::inner_index() const noexcept
+{
+  return inner_;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+const std::vector<T>& xmaho::std_ext::sparse_matrix<T, Major>::values() const noexcept
+{
+  return values_;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+template<typename F>
+void xmaho::std_ext::sparse_matrix<T, Major>::for_each(F function) const
+{
+  for (size_type o {0}; o < outer_size(); ++o)
+    for (auto k {outer_[o]}; k < outer_[o + 1]; ++k) {
+      if constexpr (Major == sparse_major::row)
+        function(o, inner_[k], values_[k]);
+      else
+        function(inner_[k], o, values_[k]);
+    }
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+typename xmaho::std_ext::sparse_matrix<T, Major>::position_type
+xmaho::std_ext::sparse_matrix<T, Major>::to_outer_inner(position_type position) noexcept
+{
+  if constexpr (Major == sparse_major::row)
+    return {position.second, position.first};
+  else
+    return position;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+typename xmaho::std_ext::sparse_matrix<T, Major>::size_type xmaho::std_ext::sparse_matrix<T, Major>::outer_size() const noexcept
+{
+  return Major == sparse_major::row ? col_size() : row_size();
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+void xmaho::std_ext::sparse_matrix<T, Major>::erase_zeros()
+{
+  size_type stored {0};
+  size_type first {0};
+  for (size_type o {0}; o + 1 < outer_.size(); ++o) {
+    const auto last {outer_[o + 1]};
+    for (auto k {first}; k < last; ++k) {
+      if (detail::is_zero(values_[k]))
+        continue;
+      inner_[stored] = inner_[k];
+      values_[stored] = std::move(values_[k]);
+      ++stored;
+    }
+    outer_[o + 1] = stored;
+    first = last;
+  }
+  inner_.resize(stored);
+  values_.resize(stored);
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::to_valmatrix(const sparse_matrix<T, Major>& m)
+{
+  valmatrix<T> result(m.row_size(), m.col_size());
+  const auto data {result.data()};
+  const auto row_size {m.row_size()};
+  m.for_each([data, row_size](std::size_t row, std::size_t col, const T& value) {data[row * row_size + col] = value;});
+  return result;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+std::valarray<T> xmaho::std_ext::matmul(const sparse_matrix<T, Major>& a, const std::valarray<T>& x)
+{
+  assert(a.row_size() == x.size());
+  std::valarray<T> result(a.col_size());
+  a.for_each([&result, &x](std::size_t row, std::size_t col, const T& value) {result[row] += value * x[col];});
+  return result;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const sparse_matrix<T, Major>& a, const valmatrix<T>& b)
+{
+  assert(a.row_size() == b.col_size());
+  valmatrix<T> result(b.row_size(), a.col_size());
+  const auto n {b.row_size()};
+  const auto src {b.data()};
+  const auto dst {result.data()};
+  a.for_each([n, src, dst](std::size_t row, std::size_t col, const T& value) {
+    for (std::size_t j {0}; j < n; ++j)
+      dst[row * n + j] += value * src[col * n + j];
+  });
+  return result;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const valmatrix<T>& a, const sparse_matrix<T, Major>& b)
+{
+  assert(a.row_size() == b.col_size());
+  if constexpr (Major == sparse_major::column) {
+    return matmul(a, csr_matrix<T>{b});
+  }
+  else {
+    valmatrix<T> result(b.row_size(), a.col_size());
+    const auto k {a.row_size()};
+    const auto n {b.row_size()};
+    const auto& outer {b.outer_index()};
+    const auto& inner {b.inner_index()};
+    const auto& values {b.values()};
+    const auto src {a.data()};
+    const auto dst {result.data()};
+    for (std::size_t i {0}; i < a.col_size(); ++i)
+      for (std::size_t p {0}; p < k; ++p) {
+        const auto factor {src[i * k + p]};
+        if (detail::is_zero(factor))
+          continue;
+        for (auto e {outer[p]}; e < outer[p + 1]; ++e)
+          dst[i * n + inner[e]] += factor * values[e];
+      }
+    return result;
+  }
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator+(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs)
+{
+  return detail::sparse_merge(lhs, rhs, std::plus<>{}, true);
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator-(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs)
+{
+  return detail::sparse_merge(lhs, rhs, std::minus<>{}, true);
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator*(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs)
+{
+  return detail::sparse_merge(lhs, rhs, std::multiplies<>{}, false);
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator*(const sparse_matrix<T, Major>& lhs, const valmatrix<T>& rhs)
+{
+  assert(lhs.row_size() == rhs.row_size());
+  assert(lhs.col_size() == rhs.col_size());
+  std::vector<std::size_t> outer(lhs.outer_index().size());
+  std::vector<std::size_t> inner {};
+  std::vector<T> values {};
+  const auto data {rhs.data()};
+  const auto row_size {rhs.row_size()};
+  lhs.for_each([&outer, &inner, &values, data, row_size](std::size_t row, std::size_t col, const T& value) {
+    const auto product {static_cast<T>(value * data[row * row_size + col])};
+    if (detail::is_zero(product))
+      return;
+    ++outer[(Major == sparse_major::row ? row : col) + 1];
+    inner.push_back(Major == sparse_major::row ? col : row);
+    values.push_back(product);
+  });
+  std::partial_sum(outer.begin(), outer.end(), outer.begin());
+  return {std::move(outer), std::move(inner), std::move(values), lhs.row_size(), lhs.col_size()};
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator*(sparse_matrix<T, Major> lhs, const T& rhs)
+{
+  return lhs *= rhs;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator*(const T& lhs, sparse_matrix<T, Major> rhs)
+{
+  return rhs *= lhs;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::sparse_matrix<T, Major> xmaho::std_ext::operator/(sparse_matrix<T, Major> lhs, const T& rhs)
+{
+  return lhs /= rhs;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator+=(valmatrix<T>& lhs, const sparse_matrix<T, Major>& rhs)
+{
+  assert(lhs.row_size() == rhs.row_size());
+  assert(lhs.col_size() == rhs.col_size());
+  const auto data {lhs.data()};
+  const auto row_size {lhs.row_size()};
+  rhs.for_each([data, row_size](std::size_t row, std::size_t col, const T& value) {data[row * row_size + col] += value;});
+  return lhs;
+}
+
+template<typename T, xmaho::std_ext::sparse_major Major>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator-=(valmatrix<T>& lhs, const sparse_matrix<T, Major>& rhs)
+{
+  assert(lhs.row_size() == rhs.row_size());
+  assert(lhs.col_size() == rhs.col_size());
+  const auto data {lhs.data()};
+  const auto row_size {lhs.row_size()};
+  rhs.for_each([data, row_size](std::size_t row, std::size_t col, const T& value) {data[row * row_size + col] -= value;});
+  return lhs;
+}
+
+#endif
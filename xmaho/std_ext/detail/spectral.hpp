@@ -0,0 +1,411 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_SPECTRAL_H
+#define XMAHO_STD_EXT_DETAIL_SPECTRAL_H
+
+#include "../spectral.hpp"
+#include "elementwise.hpp"
+#include "transpose.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Count of QL iterations per eigenvalue before giving up.
+constexpr std::size_t eigen_max_iterations {30};
+
+//! @brief Count of Jacobi sweeps before giving up.
+constexpr std::size_t svd_max_sweeps {60};
+
+/**
+ * @brief Compute "(x, y) = (c x - s y, s x + c y)" for n elements.
+ */
+template<typename T>
+void rotate_rows(T* x, T* y, const T& c, const T& s, std::size_t n) noexcept
+{
+  for (std::size_t i {0}; i < n; ++i) {
+    const auto first {x[i]};
+    const auto second {y[i]};
+    x[i] = c * first - s * second;
+    y[i] = s * first + c * second;
+  }
+}
+
+template<typename T>
+void reshape(valmatrix<T>& m, std::size_t row_size, std::size_t col_size)
+{
+  if (m.row_size() != row_size || m.col_size() != col_size)
+    m = valmatrix<T>(row_size, col_size);
+}
+
+template<typename T>
+void resize(std::valarray<T>& v, std::size_t size)
+{
+  if (v.size() != size)
+    v.resize(size);
+}
+
+/**
+ * @brief Reduce symmetric matrix to tridiagonal form "Q^T A Q".
+ *
+ * This is tred2 of EISPACK.
+ *
+ * @param[in,out] v A, overwritten by Q.
+ * @param[out] d Diagonal.
+ * @param[out] e Subdiagonal in e[1], ..., e[n - 1].
+ */
+template<typename T>
+void tridiagonalize(T* v, T* d, T* e, std::size_t n)
+{
+  const auto at {[v, n](std::size_t i, std::size_t j) -> T& {return v[i * n + j];}};
+  for (std::size_t j {0}; j < n; ++j)
+    d[j] = at(n - 1, j);
+  for (auto i {n - 1}; i > 0; --i) {
+    T scale {};
+    T h {};
+    for (std::size_t k {0}; k < i; ++k)
+      scale += std::abs(d[k]);
+    if (!(scale > T{})) {
+      e[i] = d[i - 1];
+      for (std::size_t j {0}; j < i; ++j) {
+        d[j] = at(i - 1, j);
+        at(i, j) = T{};
+        at(j, i) = T{};
+      }
+    }
+    else {
+      for (std::size_t k {0}; k < i; ++k) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      auto f {d[i - 1]};
+      auto g {std::sqrt(h)};
+      if (f > T{})
+        g = -g;
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      std::fill_n(e, i, T{});
+      for (std::size_t j {0}; j < i; ++j) {
+        f = d[j];
+        at(j, i) = f;
+        g = e[j] + at(j, j) * f;
+        for (auto k {j + 1}; k < i; ++k) {
+          g += at(k, j) * d[k];
+          e[k] += at(k, j) * f;
+        }
+        e[j] = g;
+      }
+      f = T{};
+      for (std::size_t j {0}; j < i; ++j) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      const auto hh {f / (h + h)};
+      for (std::size_t j {0}; j < i; ++j)
+        e[j] -= hh * d[j];
+      for (std::size_t j {0}; j < i; ++j) {
+        f = d[j];
+        g = e[j];
+        for (auto k {j}; k < i; ++k)
+          at(k, j) -= (f * e[k] + g * d[k]);
+        d[j] = at(i - 1, j);
+        at(i, j) = T{};
+      }
+    }
+    d[i] = h;
+  }
+  // Accumulate transformations.
+  for (std::size_t i {0}; i + 1 < n; ++i) {
+    at(n - 1, i) = at(i, i);
+    at(i, i) = T{1};
+    const auto h {d[i + 1]};
+    if (h < T{} || h > T{}) {
+      for (std::size_t k {0}; k <= i; ++k)
+        d[k] = at(k, i + 1) / h;
+      for (std::size_t j {0}; j <= i; ++j) {
+        T g {};
+        for (std::size_t k {0}; k <= i; ++k)
+          g += at(k, i + 1) * at(k, j);
+        for (std::size_t k {0}; k <= i; ++k)
+          at(k, j) -= g * d[k];
+      }
+    }
+    for (std::size_t k {0}; k <= i; ++k)
+      at(k, i + 1) = T{};
+  }
+  for (std::size_t j {0}; j < n; ++j) {
+    d[j] = at(n - 1, j);
+    at(n - 1, j) = T{};
+  }
+  at(n - 1, n - 1) = T{1};
+  e[0] = T{};
+}
+
+/**
+ * @brief Diagonalize symmetric tridiagonal matrix by implicit QL iteration.
+ *
+ * This is tql2 of EISPACK, but the transformation is stored transposed,
+ * so each rotation updates two contiguous rows.
+ *
+ * @param[in,out] z Q^T of tridiagonalize(), overwritten by eigenvectors in rows.
+ * @param[in,out] d Diagonal, overwritten by eigenvalues in ascending order.
+ * @param[in,out] e Subdiagonal in e[1], ..., e[n - 1], destroyed.
+ * @exception std::domain_error The iteration doesn't converge.
+ */
+template<typename T>
+void diagonalize_tridiagonal(T* z, T* d, T* e, std::size_t n)
+{
+  for (std::size_t i {1}; i < n; ++i)
+    e[i - 1] = e[i];
+  e[n - 1] = T{};
+  const auto epsilon {std::numeric_limits<T>::epsilon()};
+  T f {};
+  T largest {};
+  for (std::size_t l {0}; l < n; ++l) {
+    largest = std::max(largest, std::abs(d[l]) + std::abs(e[l]));
+    auto m {l};
+    while (m + 1 < n && !(std::abs(e[m]) <= epsilon * largest))
+      ++m;
+    if (m > l) {
+      std::size_t iteration {0};
+      do {
+        if (++iteration > eigen_max_iterations)
+          throw std::domain_error {"xmaho::std_ext::symmetric_eigen_decomposition::compute : iteration doesn't converge"};
+        auto g {d[l]};
+        auto p {(d[l + 1] - g) / (2 * e[l])};
+        auto r {std::hypot(p, T{1})};
+        if (p < T{})
+          r = -r;
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        const auto dl1 {d[l + 1]};
+        auto h {g - d[l]};
+        for (auto i {l + 2}; i < n; ++i)
+          d[i] -= h;
+        f += h;
+        p = d[m];
+        T c {1};
+        auto c2 {c};
+        auto c3 {c};
+        const auto el1 {e[l + 1]};
+        T s {};
+        T s2 {};
+        for (auto i {m}; i-- > l;) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = std::hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          rotate_rows(z + (i + 1) * n, z + i * n, c, -s, n);
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (std::abs(e[l]) > epsilon * largest);
+    }
+    d[l] += f;
+    e[l] = T{};
+  }
+  for (std::size_t i {0}; i + 1 < n; ++i) {
+    const auto k {static_cast<std::size_t>(std::min_element(d + i, d + n) - d)};
+    if (k != i) {
+      std::swap(d[i], d[k]);
+      std::swap_ranges(z + i * n, z + i * n + n, z + k * n);
+    }
+  }
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::symmetric_eigen_decomposition<T>::symmetric_eigen_decomposition(const valmatrix<T>& a)
+{
+  compute(a);
+}
+
+template<typename T>
+void xmaho::std_ext::symmetric_eigen_decomposition<T>::compute(const valmatrix<T>& a)
+{
+  const auto n {a.row_size()};
+  assert(n == a.col_size());
+  detail::resize(values_, n);
+  detail::reshape(vectors_, n, n);
+  off_diagonal_.resize(n);
+  if (!n)
+    return;
+  std::copy_n(a.data(), a.size(), vectors_.data());
+  const auto z {vectors_.data()};
+  const auto d {&values_[0]};
+  detail::tridiagonalize(z, d, off_diagonal_.data(), n);
+  detail::transpose_square(detail::make_strided(z, n, n));
+  detail::diagonalize_tridiagonal(z, d, off_diagonal_.data(), n);
+  detail::transpose_square(detail::make_strided(z, n, n));
+}
+
+template<typename T>
+const std::valarray<T>& xmaho::std_ext::symmetric_eigen_decomposition<T>::eigenvalues() const noexcept
+{
+  return values_;
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::symmetric_eigen_decomposition<T>::eigenvectors() const noexcept
+{
+  return vectors_;
+}
+
+template<typename T>
+typename xmaho::std_ext::symmetric_eigen_decomposition<T>::size_type xmaho::std_ext::symmetric_eigen_decomposition<T>::order() const noexcept
+{
+  return values_.size();
+}
+
+template<typename T>
+xmaho::std_ext::singular_value_decomposition<T>::singular_value_decomposition(const valmatrix<T>& a)
+{
+  compute(a);
+}
+
+template<typename T>
+void xmaho::std_ext::singular_value_decomposition<T>::compute(const valmatrix<T>& a)
+{
+  const auto rows {a.col_size()};
+  const auto cols {a.row_size()};
+  const auto k {std::min(rows, cols)};
+  const auto length {std::max(rows, cols)};
+  const auto tall {rows >= cols};
+  detail::resize(values_, k);
+  detail::reshape(u_, k, rows);
+  detail::reshape(v_, k, cols);
+  work_.resize(k * length);
+  rotation_.assign(k * k, T{});
+  order_.resize(k);
+  if (!k)
+    return;
+
+  // The k vectors to orthogonalize are the columns of a if it is tall, otherwise the rows.
+  const auto src {a.data()};
+  const auto w {work_.data()};
+  if (tall)
+    for (std::size_t r {0}; r < rows; ++r)
+      for (std::size_t c {0}; c < cols; ++c)
+        w[c * length + r] = src[r * cols + c];
+  else
+    std::copy_n(src, a.size(), w);
+  const auto j_matrix {rotation_.data()};
+  for (std::size_t i {0}; i < k; ++i)
+    j_matrix[i * k + i] = T{1};
+
+  const auto epsilon {std::numeric_limits<T>::epsilon()};
+  auto rotated {true};
+  for (std::size_t sweep {0}; rotated && sweep < detail::svd_max_sweeps; ++sweep) {
+    rotated = false;
+    for (std::size_t i {0}; i < k; ++i)
+      for (auto j {i + 1}; j < k; ++j) {
+        const auto wi {w + i * length};
+        const auto wj {w + j * length};
+        const auto alpha {detail::dot_product(wi, wi, length)};
+        const auto beta {detail::dot_product(wj, wj, length)};
+        const auto gamma {detail::dot_product(wi, wj, length)};
+        if (!(std::abs(gamma) > epsilon * std::sqrt(alpha) * std::sqrt(beta)))
+          continue;
+        rotated = true;
+        const auto zeta {(beta - alpha) / (2 * gamma)};
+        const auto t {std::copysign(T{1}, zeta) / (std::abs(zeta) + std::hypot(T{1}, zeta))};
+        const auto c {1 / std::hypot(T{1}, t)};
+        const auto s {c * t};
+        detail::rotate_rows(wi, wj, c, s, length);
+        detail::rotate_rows(j_matrix + i * k, j_matrix + j * k, c, s, k);
+      }
+  }
+  if (rotated)
+    throw std::domain_error {"xmaho::std_ext::singular_value_decomposition::compute : iteration doesn't converge"};
+
+  for (std::size_t i {0}; i < k; ++i) {
+    values_[i] = std::sqrt(detail::dot_product(w + i * length, w + i * length, length));
+    order_[i] = i;
+  }
+  std::sort(order_.begin(), order_.end(), [this](size_type lhs, size_type rhs) {return values_[lhs] > values_[rhs];});
+
+  // Normalized rows of w are singular vectors of the longer side, and rows of J are of the shorter side.
+  auto& normalized {tall ? u_ : v_};
+  auto& rotation {tall ? v_ : u_};
+  const auto longer {normalized.data()};
+  const auto shorter {rotation.data()};
+  for (std::size_t i {0}; i < k; ++i) {
+    const auto index {order_[i]};
+    const auto sigma {values_[index]};
+    const auto row {w + index * length};
+    for (std::size_t r {0}; r < length; ++r)
+      longer[r * k + i] = sigma > T{} ? row[r] / sigma : T{};
+    for (std::size_t r {0}; r < k; ++r)
+      shorter[r * k + i] = j_matrix[index * k + r];
+  }
+  std::sort(std::begin(values_), std::end(values_), std::greater<T>{});
+}
+
+template<typename T>
+const std::valarray<T>& xmaho::std_ext::singular_value_decomposition<T>::singular_values() const noexcept
+{
+  return values_;
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::singular_value_decomposition<T>::u() const noexcept
+{
+  return u_;
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::singular_value_decomposition<T>::v() const noexcept
+{
+  return v_;
+}
+
+template<typename T>
+typename xmaho::std_ext::singular_value_decomposition<T>::size_type xmaho::std_ext::singular_value_decomposition<T>::rank_size() const noexcept
+{
+  return values_.size();
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_STRIDED_MATRIX_H
+#define XMAHO_STD_EXT_DETAIL_STRIDED_MATRIX_H
+
+#include <cstddef>
+
+namespace xmaho::std_ext::detail
+{
+
+/**
+ * @brief Non-owning strided reference to two dimension data.
+ *
+ * The element of row i and column j is `data[i * row_stride + j * col_stride]`.
+ * Use `const U` as T for read only access.
+ *
+ * @tparam T Element type.
+ */
+template<typename T>
+struct strided_matrix
+{
+  T* data;
+  std::size_t rows;
+  std::size_t cols;
+  std::size_t row_stride;
+  std::size_t col_stride;
+
+  constexpr T& operator()(std::size_t i, std::size_t j) const noexcept
+  {
+    return data[i * row_stride + j * col_stride];
+  }
+
+  constexpr strided_matrix sub(std::size_t i, std::size_t j, std::size_t sub_rows, std::size_t sub_cols) const noexcept
+  {
+    return {data + i * row_stride + j * col_stride, sub_rows, sub_cols, row_stride, col_stride};
+  }
+
+  constexpr strided_matrix transposed() const noexcept
+  {
+    return {data, cols, rows, col_stride, row_stride};
+  }
+};
+
+template<typename T>
+constexpr strided_matrix<const T> to_const(strided_matrix<T> m) noexcept
+{
+  return {m.data, m.rows, m.cols, m.row_stride, m.col_stride};
+}
+
+template<typename T>
+constexpr strided_matrix<T> make_strided(T* data, std::size_t rows, std::size_t cols) noexcept
+{
+  return {data, rows, cols, cols, 1};
+}
+
+}
+
+#endif
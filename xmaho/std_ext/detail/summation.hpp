@@ -0,0 +1,205 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_SUMMATION_H
+#define XMAHO_STD_EXT_DETAIL_SUMMATION_H
+
+#include "../summation.hpp"
+#include "elementwise.hpp"
+#include "parallel.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Count of elements summed in order at the leaves of pairwise summation.
+constexpr std::size_t pairwise_block_size {128};
+
+template<typename T>
+struct compensated_sum
+{
+  void add(T value) noexcept
+  {
+    const T corrected {value - compensation};
+    const T total {sum + corrected};
+    compensation = (total - sum) - corrected;
+    sum = total;
+  }
+
+  T value() const noexcept
+  {
+    return sum - compensation;
+  }
+
+  T sum {};
+  T compensation {};
+};
+
+template<typename T, typename Term>
+T naive_sum(Term term, std::size_t begin, std::size_t end)
+{
+  T result {};
+  for (auto i {begin}; i < end; ++i)
+    result += term(i);
+  return result;
+}
+
+template<typename T, typename Term>
+T pairwise_sum(Term term, std::size_t begin, std::size_t end)
+{
+  if (end - begin > pairwise_block_size) {
+    const auto middle {begin + (end - begin) / 2};
+    return pairwise_sum<T>(term, begin, middle) + pairwise_sum<T>(term, middle, end);
+  }
+  // Independent accumulators let the additions overlap in the pipeline.
+  T partial[4] {};
+  auto i {begin};
+  for (; i + 4 <= end; i += 4) {
+    partial[0] += term(i);
+    partial[1] += term(i + 1);
+    partial[2] += term(i + 2);
+    partial[3] += term(i + 3);
+  }
+  T result {(partial[0] + partial[1]) + (partial[2] + partial[3])};
+  for (; i < end; ++i)
+    result += term(i);
+  return result;
+}
+
+template<typename T, typename Term>
+compensated_sum<T> kahan_sum(Term term, std::size_t begin, std::size_t end)
+{
+  compensated_sum<T> result {};
+  for (auto i {begin}; i < end; ++i)
+    result.add(term(i));
+  return result;
+}
+
+template<typename T, typename Term>
+compensated_sum<T> sum_range(Term term, std::size_t begin, std::size_t end, summation_method method)
+{
+  switch (method) {
+  case summation_method::pairwise:
+    return {pairwise_sum<T>(term, begin, end), T{}};
+  case summation_method::kahan:
+    return kahan_sum<T>(term, begin, end);
+  case summation_method::naive:
+    break;
+  }
+  return {naive_sum<T>(term, begin, end), T{}};
+}
+
+/**
+ * @brief Sum "term(i)" for i < size.
+ *
+ * The range is split into chunks by the partition of data,
+ * and the partial sums are combined by the method.
+ */
+template<typename T, typename Term>
+T sum_terms(parallel_context* context, const T* data, std::size_t size, Term term, summation_method method)
+{
+  if constexpr (!std::is_floating_point_v<T>)
+    method = summation_method::naive;
+  if (!size)
+    return T{};
+  const chunk_partition<T> partition {data, size, context ? context->thread_count() : 1, context ? context->grain_size() : 1};
+  if (partition.count() == 1)
+    return sum_range<T>(term, 0, size, method).value();
+  std::vector<compensated_sum<T>> partials(partition.count());
+  parallel_for_chunks(*context, partition, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    partials[chunk] = sum_range<T>(term, begin, end, method);
+  });
+  if (method == summation_method::kahan) {
+    compensated_sum<T> result {};
+    for (const auto& partial : partials) {
+      result.add(partial.sum);
+      result.add(-partial.compensation);
+    }
+    return result.value();
+  }
+  return sum_range<T>([&partials](std::size_t i) {return partials[i].sum;}, 0, partials.size(), method).value();
+}
+
+template<typename T>
+T sum(parallel_context* context, const T* data, std::size_t size, summation_method method)
+{
+  return sum_terms(context, data, size, [data](std::size_t i) {return data[i];}, method);
+}
+
+template<typename T>
+T inner_product(parallel_context* context, const std::valarray<T>& a, const std::valarray<T>& b, summation_method method)
+{
+  assert(a.size() == b.size());
+  const auto lhs {valarray_data(a)};
+  const auto rhs {valarray_data(b)};
+  return sum_terms(context, lhs, a.size(), [lhs, rhs](std::size_t i) {return static_cast<T>(lhs[i] * rhs[i]);}, method);
+}
+
+}
+
+template<typename T>
+T xmaho::std_ext::sum(const std::valarray<T>& v, summation_method method)
+{
+  return detail::sum<T>(nullptr, detail::valarray_data(v), v.size(), method);
+}
+
+template<typename T>
+T xmaho::std_ext::sum(const valmatrix<T>& m, summation_method method)
+{
+  return detail::sum<T>(nullptr, m.data(), m.size(), method);
+}
+
+template<typename T>
+T xmaho::std_ext::sum(parallel_context& context, const std::valarray<T>& v, summation_method method)
+{
+  return detail::sum<T>(&context, detail::valarray_data(v), v.size(), method);
+}
+
+template<typename T>
+T xmaho::std_ext::sum(parallel_context& context, const valmatrix<T>& m, summation_method method)
+{
+  return detail::sum<T>(&context, m.data(), m.size(), method);
+}
+
+template<typename T>
+T xmaho::std_ext::inner_product(const std::valarray<T>& a, const std::valarray<T>& b, summation_method method)
+{
+  return detail::inner_product(nullptr, a, b, method);
+}
+
+template<typename T>
+T xmaho::std_ext::inner_product(parallel_context& context, const std::valarray<T>& a, const std::valarray<T>& b, summation_method method)
+{
+  return detail::inner_product(&context, a, b, method);
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_SUMMED_AREA_TABLE_H
+#define XMAHO_STD_EXT_DETAIL_SUMMED_AREA_TABLE_H
+
+#include "../summed_area_table.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename T>
+void accumulate_rows(valmatrix<T>& table, const valmatrix<T>& m, std::size_t first)
+{
+  const auto cols {m.row_size()};
+  const auto stride {cols + 1};
+  const auto src {m.data()};
+  const auto dst {table.data()};
+  for (std::size_t i {first}; i < m.col_size(); ++i) {
+    const auto row {src + i * cols};
+    const auto above {dst + i * stride};
+    const auto current {above + stride};
+    T running {};
+    for (std::size_t j {0}; j < cols; ++j) {
+      running += row[j];
+      current[j + 1] = above[j + 1] + running;
+    }
+  }
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::summed_area_table<T>::summed_area_table(const valmatrix<T>& m)
+  : table_ {m.row_size() + 1, m.col_size() + 1}
+{
+  detail::accumulate_rows(table_, m, 0);
+}
+
+template<typename T>
+T xmaho::std_ext::summed_area_table<T>::sum(position_type pos, position_type size) const
+{
+  assert(pos.first + size.first <= row_size());
+  assert(pos.second + size.second <= col_size());
+  const position_type last {pos.first + size.first, pos.second + size.second};
+  return table_[last] - table_[position_type{pos.first, last.second}]
+       - table_[position_type{last.first, pos.second}] + table_[pos];
+}
+
+template<typename T>
+T xmaho::std_ext::summed_area_table<T>::sum() const
+{
+  return table_[position_type{row_size(), col_size()}];
+}
+
+template<typename T>
+void xmaho::std_ext::summed_area_table<T>::update(const valmatrix<T>& m, size_type first)
+{
+  assert(m.row_size() == row_size() && m.col_size() == col_size());
+  assert(first <= col_size());
+  detail::accumulate_rows(table_, m, first);
+}
+
+template<typename T>
+typename xmaho::std_ext::summed_area_table<T>::size_type xmaho::std_ext::summed_area_table<T>::row_size() const noexcept
+{
+  return table_.row_size() - 1;
+}
+
+template<typename T>
+typename xmaho::std_ext::summed_area_table<T>::size_type xmaho::std_ext::summed_area_table<T>::col_size() const noexcept
+{
+  return table_.col_size() - 1;
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::summed_area_table<T>::table() const noexcept
+{
+  return table_;
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_TRANSPOSE_H
+#define XMAHO_STD_EXT_DETAIL_TRANSPOSE_H
+
+#include "../transpose.hpp"
+#include "strided_matrix.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace xmaho::std_ext::detail
+{
+
+//! @brief Tile edge under which loops are used instead of recursion.
+constexpr std::size_t transpose_tile_size {32};
+
+/**
+ * @brief Call "function(dst(j, i), src(i, j))" for all elements tile by tile.
+ *
+ * @pre dst.rows == src.cols
+ * @pre dst.cols == src.rows
+ */
+template<typename T, typename U, typename F>
+void transpose_for_each(strided_matrix<const T> src, strided_matrix<U> dst, F function)
+{
+  if (src.rows <= transpose_tile_size && src.cols <= transpose_tile_size) {
+    for (std::size_t i {0}; i < src.rows; ++i)
+      for (std::size_t j {0}; j < src.cols; ++j)
+        function(dst(j, i), src(i, j));
+    return;
+  }
+  if (src.rows >= src.cols) {
+    const auto half {src.rows / 2};
+    transpose_for_each(src.sub(0, 0, half, src.cols), dst.sub(0, 0, src.cols, half), function);
+    transpose_for_each(src.sub(half, 0, src.rows - half, src.cols), dst.sub(0, half, src.cols, src.rows - half), function);
+  }
+  else {
+    const auto half {src.cols / 2};
+    transpose_for_each(src.sub(0, 0, src.rows, half), dst.sub(0, 0, half, src.rows), function);
+    transpose_for_each(src.sub(0, half, src.rows, src.cols - half), dst.sub(half, 0, src.cols - half, src.rows), function);
+  }
+}
+
+/**
+ * @brief Swap a with transpose of b.
+ *
+ * @pre a.rows == b.cols
+ * @pre a.cols == b.rows
+ * @pre a and b don't overlap.
+ */
+template<typename T>
+void transpose_swap(strided_matrix<T> a, strided_matrix<T> b)
+{
+  using std::swap;
+  if (a.rows <= transpose_tile_size && a.cols <= transpose_tile_size) {
+    for (std::size_t i {0}; i < a.rows; ++i)
+      for (std::size_t j {0}; j < a.cols; ++j)
+        swap(a(i, j), b(j, i));
+    return;
+  }
+  if (a.rows >= a.cols) {
+    const auto half {a.rows / 2};
+    transpose_swap(a.sub(0, 0, half, a.cols), b.sub(0, 0, a.cols, half));
+    transpose_swap(a.sub(half, 0, a.rows - half, a.cols), b.sub(0, half, a.cols, a.rows - half));
+  }
+  else {
+    const auto half {a.cols / 2};
+    transpose_swap(a.sub(0, 0, a.rows, half), b.sub(0, 0, half, a.rows));
+    transpose_swap(a.sub(0, half, a.rows, a.cols - half), b.sub(half, 0, a.cols - half, a.rows));
+  }
+}
+
+/**
+ * @brief Transpose square matrix in place.
+ *
+ * @pre a.rows == a.cols
+ */
+template<typename T>
+void transpose_square(strided_matrix<T> a)
+{
+  using std::swap;
+  if (a.rows <= transpose_tile_size) {
+    for (std::size_t i {0}; i < a.rows; ++i)
+      for (auto j {i + 1}; j < a.cols; ++j)
+        swap(a(i, j), a(j, i));
+    return;
+  }
+  const auto half {a.rows / 2};
+  const auto rest {a.rows - half};
+  transpose_square(a.sub(0, 0, half, half));
+  transpose_square(a.sub(half, half, rest, rest));
+  transpose_swap(a.sub(0, half, half, rest), a.sub(half, 0, rest, half));
+}
+
+/**
+ * @brief Transpose rows x cols matrix stored in data by following permutation cycles.
+ *
+ * Element at index k moves to "k rows mod (size - 1)".
+ */
+template<typename T>
+void transpose_cycles(T* data, std::size_t rows, std::size_t cols)
+{
+  const auto size {rows * cols};
+  if (size < 3)
+    return;
+  const auto modulus {size - 1};
+  std::vector<bool> visited(size);
+  for (std::size_t start {1}; start < modulus; ++start) {
+    if (visited[start])
+      continue;
+    auto carried {std::move(data[start])};
+    auto index {start};
+    do {
+      const auto next {index * rows % modulus};
+      std::swap(data[next], carried);
+      visited[next] = true;
+      index = next;
+    } while (index != start);
+  }
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::transpose(const valmatrix<T>& m)
+{
+  valmatrix<T> result(m.col_size(), m.row_size());
+  if (m.size())
+    detail::transpose_for_each(detail::make_strided(m.data(), m.col_size(), m.row_size()),
+                               detail::make_strided(result.data(), m.row_size(), m.col_size()),
+                               [](T& dst, const T& src) {dst = src;});
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::transpose_in_place(valmatrix<T>& m)
+{
+  const auto rows {m.col_size()};
+  const auto cols {m.row_size()};
+  if (rows == cols)
+    detail::transpose_square(detail::make_strided(m.data(), rows, cols));
+  else
+    detail::transpose_cycles(m.data(), rows, cols);
+  m.reshape(rows, cols);
+  return m;
+}
+
+#endif
@@ -0,0 +1,244 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_TRANSPOSED_H
+#define XMAHO_STD_EXT_DETAIL_TRANSPOSED_H
+
+#include "../transposed.hpp"
+#include "elementwise.hpp"
+#include "strided_matrix.hpp"
+#include "../transpose.hpp"
+
+#include <cassert>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+template<typename T>
+strided_matrix<const T> make_strided(const transposed_view<T>& m) noexcept
+{
+  return make_strided(m.base()).transposed();
+}
+
+template<typename T, typename Op>
+void transposed_apply(valmatrix<T>& lhs, const transposed_view<T>& rhs, Op op)
+{
+  assert(lhs.row_size() == rhs.row_size());
+  assert(lhs.col_size() == rhs.col_size());
+  if (&lhs == &rhs.base()) {
+    const auto copy {to_valmatrix(rhs)};
+    elementwise_apply(lhs.data(), copy.data(), lhs.size(), op);
+    return;
+  }
+  transpose_for_each(make_strided(rhs.base()), make_strided(lhs), [op](T& dst, const T& src) {
+    dst = static_cast<T>(op(dst, src));
+  });
+}
+
+}
+
+template<typename T>
+xmaho::std_ext::transposed_view<T>::transposed_view(const valmatrix<T>& base) noexcept
+  : base_ {&base}
+{
+}
+
+template<typename T>
+const T& xmaho::std_ext::transposed_view<T>::operator[](size_type index) const
+{
+  assert(index < size());
+  return (*this)[{index % row_size(), index / row_size()}];
+}
+
+template<typename T>
+const T& xmaho::std_ext::transposed_view<T>::operator[](position_type position) const
+{
+  assert(position.first < row_size());
+  assert(position.second < col_size());
+  return base_->data()[position.first * base_->row_size() + position.second];
+}
+
+template<typename T>
+typename xmaho::std_ext::transposed_view<T>::size_type xmaho::std_ext::transposed_view<T>::row_size() const noexcept
+{
+  return base_->col_size();
+}
+
+template<typename T>
+typename xmaho::std_ext::transposed_view<T>::size_type xmaho::std_ext::transposed_view<T>::col_size() const noexcept
+{
+  return base_->row_size();
+}
+
+template<typename T>
+typename xmaho::std_ext::transposed_view<T>::size_type xmaho::std_ext::transposed_view<T>::size() const noexcept
+{
+  return base_->size();
+}
+
+template<typename T>
+T xmaho::std_ext::transposed_view<T>::sum() const
+{
+  return base_->sum();
+}
+
+template<typename T>
+T xmaho::std_ext::transposed_view<T>::min() const
+{
+  return base_->min();
+}
+
+template<typename T>
+T xmaho::std_ext::transposed_view<T>::max() const
+{
+  return base_->max();
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::transposed_view<T>::base() const noexcept
+{
+  return *base_;
+}
+
+template<typename T>
+xmaho::std_ext::transposed_view<T> xmaho::std_ext::transposed(const valmatrix<T>& m) noexcept
+{
+  return transposed_view<T>{m};
+}
+
+template<typename T>
+const xmaho::std_ext::valmatrix<T>& xmaho::std_ext::transposed(const transposed_view<T>& m) noexcept
+{
+  return m.base();
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::to_valmatrix(const transposed_view<T>& m)
+{
+  return transpose(m.base());
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const transposed_view<T>& a, const valmatrix<T>& b)
+{
+  assert(a.row_size() == b.col_size());
+  valmatrix<T> result(b.row_size(), a.col_size());
+  detail::gemm(T{1}, detail::make_strided(a), detail::make_strided(b), false, detail::make_strided(result));
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const valmatrix<T>& a, const transposed_view<T>& b)
+{
+  assert(a.row_size() == b.col_size());
+  valmatrix<T> result(b.row_size(), a.col_size());
+  detail::gemm(T{1}, detail::make_strided(a), detail::make_strided(b), false, detail::make_strided(result));
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T> xmaho::std_ext::matmul(const transposed_view<T>& a, const transposed_view<T>& b)
+{
+  assert(a.row_size() == b.col_size());
+  valmatrix<T> result(b.row_size(), a.col_size());
+  detail::gemm(T{1}, detail::make_strided(a), detail::make_strided(b), false, detail::make_strided(result));
+  return result;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator+=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::plus<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator-=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::minus<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator*=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::multiplies<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator/=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::divides<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator%=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::modulus<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator&=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::bit_and<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator|=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::bit_or<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator^=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, std::bit_xor<>{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator<<=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, detail::shift_left{});
+  return lhs;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<T>& xmaho::std_ext::operator>>=(valmatrix<T>& lhs, const transposed_view<T>& rhs)
+{
+  detail::transposed_apply(lhs, rhs, detail::shift_right{});
+  return lhs;
+}
+
+#endif
@@ -30,758 +30,1025 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define XMAHO_STD_EXT_DETAIL_VALMATRIX_H
 
 #include "../valmatrix.hpp"
+#include "elementwise.hpp"
 
 #include <cassert>
+#include <functional>
+#include <type_traits>
 
 namespace xmaho::std_ext::detail
 {
 
-constexpr std::size_t get_serial_index(
-  std::pair<std::size_t, std::size_t> pos,
-  std::size_t col_size)
+constexpr std::pair<std::size_t, std::size_t> get_init_size(std::size_t row_size, std::size_t col_size)
 {
-  return col_size * pos.second + pos.first;
+  return {col_size ? row_size : 0 , row_size ? col_size : 0};
 }
 
-constexpr std::pair<std::size_t, std::size_t> get_init_size(std::size_t row_size, std::size_t col_size)
+template<typename E, typename T, typename Layout>
+void copy_expression(const valmatrix_expression<E>& expression, valmatrix<T, Layout>& m)
 {
-  return {col_size ? row_size : 0 , row_size ? col_size : 0};
+  using position_type = typename valmatrix<T, Layout>::position_type;
+  if (refers_transposed(expression.node(), m.data())) {
+    valmatrix<T, Layout> result(m.row_size(), m.col_size());
+    copy_expression(expression, result);
+    m.swap(result);
+    return;
+  }
+  if constexpr (std::is_same_v<Layout, row_major>)
+    expression.copy_to(m.data());
+  else
+    for (std::size_t c {0}; c < m.row_size(); ++c)
+      for (std::size_t r {0}; r < m.col_size(); ++r)
+        m[position_type{c, r}] = expression[r * m.row_size() + c];
+}
+
+}
+
+constexpr xmaho::std_ext::row_major::size_type xmaho::std_ext::row_major::index(position_type position, position_type size) noexcept
+{
+  return size.first * position.second + position.first;
+}
+
+inline std::slice xmaho::std_ext::row_major::row(size_type index, position_type size) noexcept
+{
+  return std::slice{index * size.first, size.first, 1};
+}
+
+inline std::slice xmaho::std_ext::row_major::col(size_type index, position_type size) noexcept
+{
+  return std::slice{index, size.second, size.first};
 }
 
+inline std::gslice xmaho::std_ext::row_major::block(position_type pos, position_type sub_size, position_type size)
+{
+  return std::gslice{index(pos, size), {sub_size.second, sub_size.first}, {size.first, 1}};
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>::valmatrix(size_type row_size, size_type col_size)
+constexpr xmaho::std_ext::column_major::size_type xmaho::std_ext::column_major::index(position_type position, position_type size) noexcept
+{
+  return size.second * position.first + position.second;
+}
+
+inline std::slice xmaho::std_ext::column_major::row(size_type index, position_type size) noexcept
+{
+  return std::slice{index, size.first, size.second};
+}
+
+inline std::slice xmaho::std_ext::column_major::col(size_type index, position_type size) noexcept
+{
+  return std::slice{index * size.second, size.second, 1};
+}
+
+inline std::gslice xmaho::std_ext::column_major::block(position_type pos, position_type sub_size, position_type size)
+{
+  return std::gslice{index(pos, size), {sub_size.first, sub_size.second}, {size.second, 1}};
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(size_type row_size, size_type col_size)
   : std::valarray<T>(row_size * col_size),
     size_ {detail::get_init_size(row_size, col_size)}
 {
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>::valmatrix(const T& value, size_type row_size, size_type col_size)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(const T& value, size_type row_size, size_type col_size)
   : std::valarray<T>(value, row_size * col_size),
     size_ {detail::get_init_size(row_size, col_size)}
 {
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>::valmatrix(const std::valarray<T>& values, size_type row_size, size_type col_size)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(const std::valarray<T>& values, size_type row_size, size_type col_size)
   : std::valarray<T>(values.size() == row_size * col_size ? values : std::valarray<T>(row_size * col_size)),
     size_ {detail::get_init_size(row_size, col_size)}
 {
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>::valmatrix(std::valarray<T>&& values, size_type row_size, size_type col_size)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(std::valarray<T>&& values, size_type row_size, size_type col_size)
   : std::valarray<T>(values.size() == row_size * col_size ? std::move(values) : std::valarray<T>(row_size * col_size)),
     size_ {detail::get_init_size(row_size, col_size)}
 {
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+template<typename E>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(const valmatrix_expression<E>& expression)
+  : std::valarray<T>(expression.size()),
+    size_ {detail::get_init_size(expression.row_size(), expression.col_size())}
+{
+  detail::copy_expression(expression, *this);
+}
+
+template<typename T, typename Layout>
+template<typename OtherLayout>
+xmaho::std_ext::valmatrix<T, Layout>::valmatrix(const valmatrix<T, OtherLayout>& other)
+  : std::valarray<T>(other.size()),
+    size_ {detail::get_init_size(other.row_size(), other.col_size())}
+{
+  for (size_type r {0}; r < col_size(); ++r)
+    for (size_type c {0}; c < row_size(); ++c)
+      (*this)[position_type{c, r}] = other[position_type{c, r}];
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator=(const std::valarray<T>& rhs) &
 {
   assert(size() == rhs.size());
   std::valarray<T>::operator=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator=(std::valarray<T>&& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator=(std::valarray<T>&& rhs) &
 {
   assert(size() == rhs.size());
   std::valarray<T>::operator=(std::move(rhs));
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator=(const T& rhs) &
 {
   std::valarray<T>::operator=(rhs);
   return *this;
 }
 
-template<typename T>
-const T& xmaho::std_ext::valmatrix<T>::operator[](position_type position) const
+template<typename T, typename Layout>
+template<typename E>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator=(const valmatrix_expression<E>& expression) &
+{
+  assert(row_size() == expression.row_size());
+  assert(col_size() == expression.col_size());
+  detail::copy_expression(expression, *this);
+  return *this;
+}
+
+template<typename T, typename Layout>
+const T& xmaho::std_ext::valmatrix<T, Layout>::operator[](position_type position) const
 {
   assert(position.first < row_size());
   assert(position.second < col_size());
-  return std::valarray<T>::operator[](detail::get_serial_index(position, col_size()));
+  return std::valarray<T>::operator[](Layout::index(position, size_));
 }
 
-template<typename T>
-T& xmaho::std_ext::valmatrix<T>::operator[](position_type position)
+template<typename T, typename Layout>
+T& xmaho::std_ext::valmatrix<T, Layout>::operator[](position_type position)
 {
   assert(position.first < row_size());
   assert(position.second < col_size());
-  return std::valarray<T>::operator[](detail::get_serial_index(position, col_size()));
+  return std::valarray<T>::operator[](Layout::index(position, size_));
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::valmatrix<T>::operator+() const noexcept
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::valmatrix<T, Layout>::operator+() const noexcept
 {
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::valmatrix<T>::operator-() const noexcept
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::valmatrix<T, Layout>::operator-() const noexcept
 {
   return valmatrix{std::valarray<T>::operator-(), row_size(), col_size()};
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::valmatrix<T>::operator~() const noexcept
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::valmatrix<T, Layout>::operator~() const noexcept
 {
   return valmatrix{std::valarray<T>::operator~(), row_size(), col_size()};
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator+=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator+=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator+=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::plus<>{});
+  else
+    std::valarray<T>::operator+=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator+=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator+=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator+=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::plus<>{});
+  else
+    std::valarray<T>::operator+=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator+=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator+=(const T& rhs) &
 {
-  std::valarray<T>::operator+=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::plus<>{});
+  else
+    std::valarray<T>::operator+=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator-=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator-=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator-=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::minus<>{});
+  else
+    std::valarray<T>::operator-=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator-=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator-=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator-=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::minus<>{});
+  else
+    std::valarray<T>::operator-=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator-=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator-=(const T& rhs) &
 {
-  std::valarray<T>::operator-=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::minus<>{});
+  else
+    std::valarray<T>::operator-=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator*=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator*=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator*=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::multiplies<>{});
+  else
+    std::valarray<T>::operator*=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator*=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator*=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator*=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::multiplies<>{});
+  else
+    std::valarray<T>::operator*=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator*=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator*=(const T& rhs) &
 {
-  std::valarray<T>::operator*=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::multiplies<>{});
+  else
+    std::valarray<T>::operator*=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator/=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator/=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator/=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::divides<>{});
+  else
+    std::valarray<T>::operator/=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator/=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator/=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator/=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::divides<>{});
+  else
+    std::valarray<T>::operator/=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator/=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator/=(const T& rhs) &
 {
-  std::valarray<T>::operator/=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::divides<>{});
+  else
+    std::valarray<T>::operator/=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator%=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator%=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator%=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::modulus<>{});
+  else
+    std::valarray<T>::operator%=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator%=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator%=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator%=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::modulus<>{});
+  else
+    std::valarray<T>::operator%=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator%=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator%=(const T& rhs) &
 {
-  std::valarray<T>::operator%=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::modulus<>{});
+  else
+    std::valarray<T>::operator%=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator&=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator&=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator&=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::bit_and<>{});
+  else
+    std::valarray<T>::operator&=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator&=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator&=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator&=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::bit_and<>{});
+  else
+    std::valarray<T>::operator&=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator&=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator&=(const T& rhs) &
 {
-  std::valarray<T>::operator&=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::bit_and<>{});
+  else
+    std::valarray<T>::operator&=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator|=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator|=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator|=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::bit_or<>{});
+  else
+    std::valarray<T>::operator|=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator|=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator|=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator|=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::bit_or<>{});
+  else
+    std::valarray<T>::operator|=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator|=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator|=(const T& rhs) &
 {
-  std::valarray<T>::operator|=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::bit_or<>{});
+  else
+    std::valarray<T>::operator|=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator^=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator^=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator^=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), std::bit_xor<>{});
+  else
+    std::valarray<T>::operator^=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator^=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator^=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator^=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), std::bit_xor<>{});
+  else
+    std::valarray<T>::operator^=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator^=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator^=(const T& rhs) &
 {
-  std::valarray<T>::operator^=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), std::bit_xor<>{});
+  else
+    std::valarray<T>::operator^=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator<<=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator<<=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator<<=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), detail::shift_left{});
+  else
+    std::valarray<T>::operator<<=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator<<=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator<<=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator<<=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), detail::shift_left{});
+  else
+    std::valarray<T>::operator<<=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator<<=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator<<=(const T& rhs) &
 {
-  std::valarray<T>::operator<<=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), detail::shift_left{});
+  else
+    std::valarray<T>::operator<<=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator>>=(const valmatrix& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator>>=(const valmatrix& rhs) &
 {
   assert(rhs.size_ == size_);
-  std::valarray<T>::operator>>=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), rhs.data(), size(), detail::shift_right{});
+  else
+    std::valarray<T>::operator>>=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator>>=(const std::valarray<T>& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator>>=(const std::valarray<T>& rhs) &
 {
   assert(rhs.size() == size());
-  std::valarray<T>::operator>>=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply(data(), detail::valarray_data(rhs), size(), detail::shift_right{});
+  else
+    std::valarray<T>::operator>>=(rhs);
   return *this;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T>& xmaho::std_ext::valmatrix<T>::operator>>=(const T& rhs) &
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout>& xmaho::std_ext::valmatrix<T, Layout>::operator>>=(const T& rhs) &
 {
-  std::valarray<T>::operator>>=(rhs);
+  if constexpr (std::is_arithmetic_v<T>)
+    detail::elementwise_apply_value(data(), rhs, size(), detail::shift_right{});
+  else
+    std::valarray<T>::operator>>=(rhs);
   return *this;
 }
 
-template<typename T>
-typename xmaho::std_ext::valmatrix<T>::size_type xmaho::std_ext::valmatrix<T>::row_size() const noexcept
+template<typename T, typename Layout>
+typename xmaho::std_ext::valmatrix<T, Layout>::size_type xmaho::std_ext::valmatrix<T, Layout>::row_size() const noexcept
 {
   return size_.first;
 }
 
-template<typename T>
-typename xmaho::std_ext::valmatrix<T>::size_type xmaho::std_ext::valmatrix<T>::col_size() const noexcept
+template<typename T, typename Layout>
+typename xmaho::std_ext::valmatrix<T, Layout>::size_type xmaho::std_ext::valmatrix<T, Layout>::col_size() const noexcept
 {
   return size_.second;
 }
 
-template<typename T>
-std::valarray<T> xmaho::std_ext::valmatrix<T>::row(size_type index) const
+template<typename T, typename Layout>
+std::valarray<T> xmaho::std_ext::valmatrix<T, Layout>::row(size_type index) const
 {
   assert(index < col_size());
-  return std::valarray<T>::operator[](std::slice{index * row_size(), row_size(), 1});
+  return std::valarray<T>::operator[](Layout::row(index, size_));
 }
 
-template<typename T>
-std::slice_array<T> xmaho::std_ext::valmatrix<T>::row(size_type index)
+template<typename T, typename Layout>
+std::slice_array<T> xmaho::std_ext::valmatrix<T, Layout>::row(size_type index)
 {
   assert(index < col_size());
-  return std::valarray<T>::operator[](std::slice{index * row_size(), row_size(), 1});
+  return std::valarray<T>::operator[](Layout::row(index, size_));
 }
 
-template<typename T>
-std::valarray<T> xmaho::std_ext::valmatrix<T>::col(size_type index) const
+template<typename T, typename Layout>
+std::valarray<T> xmaho::std_ext::valmatrix<T, Layout>::col(size_type index) const
 {
   assert(index < row_size());
-  return std::valarray<T>::operator[](std::slice{index, col_size(), row_size()});
+  return std::valarray<T>::operator[](Layout::col(index, size_));
 }
 
-template<typename T>
-std::slice_array<T> xmaho::std_ext::valmatrix<T>::col(size_type index)
+template<typename T, typename Layout>
+std::slice_array<T> xmaho::std_ext::valmatrix<T, Layout>::col(size_type index)
 {
   assert(index < row_size());
-  return std::valarray<T>::operator[](std::slice{index, col_size(), row_size()});
+  return std::valarray<T>::operator[](Layout::col(index, size_));
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::valmatrix<T>::block(position_type pos, position_type sub_size) const
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::valmatrix<T, Layout>::block(position_type pos, position_type sub_size) const
 {
   assert(pos.first + (sub_size.first - 1) < row_size());
   assert(pos.second + (sub_size.second - 1) < col_size());
-  const std::gslice block_gslice {detail::get_serial_index(pos, col_size()), {sub_size.second, sub_size.first}, {row_size(), 1}};
-  return valmatrix{std::valarray<T>::operator[](block_gslice), sub_size.first, sub_size.second};
+  return valmatrix{std::valarray<T>::operator[](Layout::block(pos, sub_size, size_)), sub_size.first, sub_size.second};
 }
 
-template<typename T>
-auto xmaho::std_ext::valmatrix<T>::begin() const noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::valmatrix<T, Layout>::begin() const noexcept
 {
   return std::begin(static_cast<const std::valarray<T>&>(*this));
 }
 
-template<typename T>
-auto xmaho::std_ext::valmatrix<T>::begin() noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::valmatrix<T, Layout>::begin() noexcept
 {
   return std::begin(static_cast<std::valarray<T>&>(*this));
 }
 
-template<typename T>
-auto xmaho::std_ext::valmatrix<T>::end() const noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::valmatrix<T, Layout>::end() const noexcept
 {
   return std::end(static_cast<const std::valarray<T>&>(*this));
 }
 
-template<typename T>
-auto xmaho::std_ext::valmatrix<T>::end() noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::valmatrix<T, Layout>::end() noexcept
 {
   return std::end(static_cast<std::valarray<T>&>(*this));
 }
 
-template<typename T>
-void xmaho::std_ext::valmatrix<T>::swap(valmatrix& other) noexcept
+template<typename T, typename Layout>
+const T* xmaho::std_ext::valmatrix<T, Layout>::data() const noexcept
+{
+  return size() ? &std::valarray<T>::operator[](0) : nullptr;
+}
+
+template<typename T, typename Layout>
+T* xmaho::std_ext::valmatrix<T, Layout>::data() noexcept
+{
+  return size() ? &std::valarray<T>::operator[](0) : nullptr;
+}
+
+template<typename T, typename Layout>
+void xmaho::std_ext::valmatrix<T, Layout>::reshape(size_type row_size, size_type col_size) noexcept
+{
+  assert(row_size * col_size == size());
+  size_ = detail::get_init_size(row_size, col_size);
+}
+
+template<typename T, typename Layout>
+void xmaho::std_ext::valmatrix<T, Layout>::swap(valmatrix& other) noexcept
 {
   valmatrix temp {std::move(other)};
   other = std::move(*this);
   *this = std::move(temp);
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator+(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator+(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs += rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator+(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator+(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs += rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator+(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator+(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs += rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator+(const std::valarray<T>& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator+(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs += lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator+(const T& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator+(const T& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs += lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator-(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs -= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator-(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs -= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator-(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs -= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator-(const std::valarray<T>& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp -= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator-(const T& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(const T& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp -= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator*(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs)
+{
+  assert(lhs.size() == rhs.size());
+  detail::elementwise_apply(rhs.data(), detail::valarray_data(lhs), rhs.size(), detail::reversed<std::minus<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator-(const T& lhs, valmatrix<T, Layout>&& rhs)
+{
+  detail::elementwise_apply_value(rhs.data(), lhs, rhs.size(), detail::reversed<std::minus<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator*(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs *= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator*(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator*(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs *= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator*(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator*(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs *= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator*(const std::valarray<T>& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator*(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs *= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator*(const T& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator*(const T& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs *= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator/(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs /= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator/(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs /= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator/(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs /= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator/(const std::valarray<T>& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp /= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator/(const T& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(const T& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp /= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator%(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs)
+{
+  assert(lhs.size() == rhs.size());
+  detail::elementwise_apply(rhs.data(), detail::valarray_data(lhs), rhs.size(), detail::reversed<std::divides<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator/(const T& lhs, valmatrix<T, Layout>&& rhs)
+{
+  detail::elementwise_apply_value(rhs.data(), lhs, rhs.size(), detail::reversed<std::divides<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs %= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator%(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs %= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator%(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs %= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator%(const std::valarray<T>& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp %= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator%(const T& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(const T& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp %= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator&(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs)
+{
+  assert(lhs.size() == rhs.size());
+  detail::elementwise_apply(rhs.data(), detail::valarray_data(lhs), rhs.size(), detail::reversed<std::modulus<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator%(const T& lhs, valmatrix<T, Layout>&& rhs)
+{
+  detail::elementwise_apply_value(rhs.data(), lhs, rhs.size(), detail::reversed<std::modulus<>>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator&(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs &= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator&(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator&(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs &= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator&(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator&(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs &= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator&(const std::valarray<T>& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator&(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs &= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator&(const T& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator&(const T& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs &= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator|(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator|(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs |= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator|(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator|(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs |= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator|(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator|(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs |= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator|(const std::valarray<T>& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator|(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs |= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator|(const T& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator|(const T& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs |= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator^(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator^(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs ^= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator^(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator^(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs ^= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator^(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator^(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs ^= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator^(const std::valarray<T>& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator^(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs ^= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator^(const T& lhs, valmatrix<T> rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator^(const T& lhs, valmatrix<T, Layout> rhs)
 {
   return rhs ^= lhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator<<(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs <<= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator<<(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs <<= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator<<(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs <<= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator<<(const std::valarray<T>& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp <<= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator<<(const T& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(const T& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp <<= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator>>(valmatrix<T> lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs)
+{
+  assert(lhs.size() == rhs.size());
+  detail::elementwise_apply(rhs.data(), detail::valarray_data(lhs), rhs.size(), detail::reversed<detail::shift_left>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator<<(const T& lhs, valmatrix<T, Layout>&& rhs)
+{
+  detail::elementwise_apply_value(rhs.data(), lhs, rhs.size(), detail::reversed<detail::shift_left>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs)
 {
   return lhs >>= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator>>(valmatrix<T> lhs, const std::valarray<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs)
 {
   return lhs >>= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator>>(valmatrix<T> lhs, const T& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(valmatrix<T, Layout> lhs, const T& rhs)
 {
   return lhs >>= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator>>(const std::valarray<T>& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp >>= rhs;
 }
 
-template<typename T>
-xmaho::std_ext::valmatrix<T> xmaho::std_ext::operator>>(const T& lhs, const valmatrix<T>& rhs)
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(const T& lhs, const valmatrix<T, Layout>& rhs)
 {
-  valmatrix<T> tmp {lhs, rhs.row_size(), rhs.col_size()};
+  valmatrix<T, Layout> tmp {lhs, rhs.row_size(), rhs.col_size()};
   return tmp >>= rhs;
 }
 
-template<typename T>
-auto xmaho::std_ext::begin(const valmatrix<T>& v) noexcept
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs)
+{
+  assert(lhs.size() == rhs.size());
+  detail::elementwise_apply(rhs.data(), detail::valarray_data(lhs), rhs.size(), detail::reversed<detail::shift_right>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+xmaho::std_ext::valmatrix<T, Layout> xmaho::std_ext::operator>>(const T& lhs, valmatrix<T, Layout>&& rhs)
+{
+  detail::elementwise_apply_value(rhs.data(), lhs, rhs.size(), detail::reversed<detail::shift_right>{});
+  return std::move(rhs);
+}
+
+template<typename T, typename Layout>
+auto xmaho::std_ext::begin(const valmatrix<T, Layout>& v) noexcept
 {
   return v.begin();
 }
 
-template<typename T>
-auto xmaho::std_ext::begin(valmatrix<T>& v) noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::begin(valmatrix<T, Layout>& v) noexcept
 {
   return v.begin();
 }
 
-template<typename T>
-auto xmaho::std_ext::end(const valmatrix<T>& v) noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::end(const valmatrix<T, Layout>& v) noexcept
 {
   return v.end();
 }
 
-template<typename T>
-auto xmaho::std_ext::end(valmatrix<T>& v) noexcept
+template<typename T, typename Layout>
+auto xmaho::std_ext::end(valmatrix<T, Layout>& v) noexcept
 {
   return v.end();
 }
 
-template<typename T>
-void xmaho::std_ext::swap(valmatrix<T>& a, valmatrix<T>& b) noexcept
+template<typename T, typename Layout>
+void xmaho::std_ext::swap(valmatrix<T, Layout>& a, valmatrix<T, Layout>& b) noexcept
 {
   a.swap(b);
 }
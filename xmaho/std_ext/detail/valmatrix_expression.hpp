@@ -0,0 +1,567 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_VALMATRIX_EXPRESSION_H
+#define XMAHO_STD_EXT_DETAIL_VALMATRIX_EXPRESSION_H
+
+#include "../valmatrix_expression.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+/**
+ * @brief Leaf node of valmatrix.
+ *
+ * rank is 2 for matrix, 1 for array and 0 for value.
+ */
+template<typename T>
+struct matrix_terminal
+{
+  using value_type = T;
+  static constexpr int rank {2};
+
+  const T* data;
+  std::size_t rows;
+  std::size_t cols;
+
+  constexpr const T& operator[](std::size_t index) const noexcept
+  {
+    return data[index];
+  }
+
+  constexpr const T& at(std::size_t index, std::size_t, std::size_t) const noexcept
+  {
+    return data[index];
+  }
+
+  constexpr std::size_t row_size() const noexcept
+  {
+    return rows;
+  }
+
+  constexpr std::size_t col_size() const noexcept
+  {
+    return cols;
+  }
+
+  constexpr std::size_t size() const noexcept
+  {
+    return rows * cols;
+  }
+};
+
+template<typename T>
+struct array_terminal
+{
+  using value_type = T;
+  static constexpr int rank {1};
+
+  const T* data;
+  std::size_t length;
+
+  constexpr const T& operator[](std::size_t index) const noexcept
+  {
+    return data[index];
+  }
+
+  constexpr const T& at(std::size_t index, std::size_t, std::size_t) const noexcept
+  {
+    return data[index];
+  }
+
+  constexpr std::size_t size() const noexcept
+  {
+    return length;
+  }
+};
+
+/**
+ * @brief Leaf node of transposed_view.
+ *
+ * Element of row i and column j is element of row j and column i in data.
+ */
+template<typename T>
+struct transposed_terminal
+{
+  using value_type = T;
+  static constexpr int rank {2};
+
+  const T* data;
+  std::size_t rows;
+  std::size_t cols;
+
+  constexpr const T& operator[](std::size_t index) const noexcept
+  {
+    return at(index, index / rows, index % rows);
+  }
+
+  constexpr const T& at(std::size_t, std::size_t i, std::size_t j) const noexcept
+  {
+    return data[j * cols + i];
+  }
+
+  constexpr std::size_t row_size() const noexcept
+  {
+    return rows;
+  }
+
+  constexpr std::size_t col_size() const noexcept
+  {
+    return cols;
+  }
+
+  constexpr std::size_t size() const noexcept
+  {
+    return rows * cols;
+  }
+};
+
+template<typename T>
+struct scalar_terminal
+{
+  using value_type = T;
+  static constexpr int rank {0};
+
+  T value;
+
+  constexpr const T& operator[](std::size_t) const noexcept
+  {
+    return value;
+  }
+
+  constexpr const T& at(std::size_t, std::size_t, std::size_t) const noexcept
+  {
+    return value;
+  }
+};
+
+template<typename Op, typename E>
+struct unary_node
+{
+  using value_type = typename E::value_type;
+  static constexpr int rank {2};
+
+  E operand;
+
+  constexpr value_type operator[](std::size_t index) const
+  {
+    return static_cast<value_type>(Op{}(operand[index]));
+  }
+
+  constexpr value_type at(std::size_t index, std::size_t i, std::size_t j) const
+  {
+    return static_cast<value_type>(Op{}(operand.at(index, i, j)));
+  }
+
+  constexpr std::size_t row_size() const noexcept
+  {
+    return operand.row_size();
+  }
+
+  constexpr std::size_t col_size() const noexcept
+  {
+    return operand.col_size();
+  }
+
+  constexpr std::size_t size() const noexcept
+  {
+    return operand.size();
+  }
+};
+
+template<typename Op, typename L, typename R>
+struct binary_node
+{
+  static_assert(L::rank == 2 || R::rank == 2, "Either operand has dimension");
+
+  using value_type = typename L::value_type;
+  static constexpr int rank {2};
+
+  L lhs;
+  R rhs;
+
+  constexpr binary_node(L l, R r)
+    : lhs {std::move(l)},
+      rhs {std::move(r)}
+  {
+    if constexpr (L::rank == 2 && R::rank == 2) {
+      assert(lhs.row_size() == rhs.row_size());
+      assert(lhs.col_size() == rhs.col_size());
+    } else if constexpr (L::rank == 1 || R::rank == 1) {
+      assert(lhs.size() == rhs.size());
+    }
+  }
+
+  constexpr value_type operator[](std::size_t index) const
+  {
+    return static_cast<value_type>(Op{}(lhs[index], rhs[index]));
+  }
+
+  constexpr value_type at(std::size_t index, std::size_t i, std::size_t j) const
+  {
+    return static_cast<value_type>(Op{}(lhs.at(index, i, j), rhs.at(index, i, j)));
+  }
+
+  constexpr std::size_t row_size() const noexcept
+  {
+    if constexpr (L::rank == 2)
+      return lhs.row_size();
+    else
+      return rhs.row_size();
+  }
+
+  constexpr std::size_t col_size() const noexcept
+  {
+    if constexpr (L::rank == 2)
+      return lhs.col_size();
+    else
+      return rhs.col_size();
+  }
+
+  constexpr std::size_t size() const noexcept
+  {
+    return row_size() * col_size();
+  }
+};
+
+struct unary_plus
+{
+  template<typename T>
+  constexpr auto operator()(const T& v) const
+  {
+    return +v;
+  }
+};
+
+//! @brief Tile edge of evaluation for expressions that refer transposed_view.
+constexpr std::size_t expression_tile_size {32};
+
+template<typename E>
+struct has_transposed_terminal
+  : std::false_type
+{
+};
+
+template<typename T>
+struct has_transposed_terminal<transposed_terminal<T>>
+  : std::true_type
+{
+};
+
+template<typename Op, typename E>
+struct has_transposed_terminal<unary_node<Op, E>>
+  : has_transposed_terminal<E>
+{
+};
+
+template<typename Op, typename L, typename R>
+struct has_transposed_terminal<binary_node<Op, L, R>>
+  : std::bool_constant<has_transposed_terminal<L>::value || has_transposed_terminal<R>::value>
+{
+};
+
+template<typename E>
+constexpr bool refers_transposed(const E&, const void*) noexcept
+{
+  return false;
+}
+
+template<typename T>
+constexpr bool refers_transposed(const transposed_terminal<T>& node, const void* data) noexcept
+{
+  return node.data == data;
+}
+
+template<typename Op, typename E>
+constexpr bool refers_transposed(const unary_node<Op, E>& node, const void* data) noexcept
+{
+  return refers_transposed(node.operand, data);
+}
+
+template<typename Op, typename L, typename R>
+constexpr bool refers_transposed(const binary_node<Op, L, R>& node, const void* data) noexcept
+{
+  return refers_transposed(node.lhs, data) || refers_transposed(node.rhs, data);
+}
+
+template<typename T>
+struct is_valmatrix_expression
+  : std::false_type
+{
+};
+
+template<typename E>
+struct is_valmatrix_expression<valmatrix_expression<E>>
+  : std::true_type
+{
+};
+
+template<typename X, typename T>
+struct is_expression_operand
+  : std::bool_constant<std::is_same_v<X, valmatrix<T>> || std::is_same_v<X, std::valarray<T>> || std::is_same_v<X, T>>
+{
+};
+
+template<typename E, typename T>
+struct is_expression_operand<valmatrix_expression<E>, T>
+  : std::is_same<typename E::value_type, T>
+{
+};
+
+template<typename T>
+struct is_expression_operand<transposed_view<T>, T>
+  : std::true_type
+{
+};
+
+template<typename L, typename R>
+struct is_expression_operands
+  : std::false_type
+{
+};
+
+template<typename E, typename R>
+struct is_expression_operands<valmatrix_expression<E>, R>
+  : is_expression_operand<R, typename E::value_type>
+{
+};
+
+template<typename L, typename E>
+struct is_expression_operands<L, valmatrix_expression<E>>
+  : is_expression_operand<L, typename E::value_type>
+{
+};
+
+template<typename E1, typename E2>
+struct is_expression_operands<valmatrix_expression<E1>, valmatrix_expression<E2>>
+  : std::is_same<typename E1::value_type, typename E2::value_type>
+{
+};
+
+template<typename E>
+constexpr const E& to_node(const valmatrix_expression<E>& e) noexcept
+{
+  return e.node();
+}
+
+template<typename T>
+constexpr matrix_terminal<T> to_node(const valmatrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size()};
+}
+
+template<typename T>
+transposed_terminal<T> to_node(const transposed_view<T>& m) noexcept
+{
+  return {m.base().data(), m.row_size(), m.col_size()};
+}
+
+template<typename T>
+array_terminal<T> to_node(const std::valarray<T>& v) noexcept
+{
+  return {valarray_data(v), v.size()};
+}
+
+template<typename T, typename = std::enable_if_t<!is_valmatrix_expression<T>::value>>
+constexpr scalar_terminal<T> to_node(const T& value)
+{
+  return {value};
+}
+
+template<typename Op, typename L, typename R>
+constexpr auto make_binary_expression(const L& lhs, const R& rhs)
+{
+  using node_type = binary_node<Op, std::decay_t<decltype(to_node(lhs))>, std::decay_t<decltype(to_node(rhs))>>;
+  return valmatrix_expression<node_type>{node_type{to_node(lhs), to_node(rhs)}};
+}
+
+template<typename Op, typename E>
+constexpr auto make_unary_expression(const valmatrix_expression<E>& e)
+{
+  using node_type = unary_node<Op, E>;
+  return valmatrix_expression<node_type>{node_type{e.node()}};
+}
+
+}
+
+template<typename E>
+constexpr xmaho::std_ext::valmatrix_expression<E>::valmatrix_expression(E node)
+  : node_ {std::move(node)}
+{
+}
+
+template<typename E>
+constexpr typename xmaho::std_ext::valmatrix_expression<E>::value_type
+xmaho::std_ext::valmatrix_expression<E>::operator[](size_type index) const
+{
+  assert(index < size());
+  return node_[index];
+}
+
+template<typename E>
+constexpr typename xmaho::std_ext::valmatrix_expression<E>::size_type
+xmaho::std_ext::valmatrix_expression<E>::row_size() const noexcept
+{
+  return node_.row_size();
+}
+
+template<typename E>
+constexpr typename xmaho::std_ext::valmatrix_expression<E>::size_type
+xmaho::std_ext::valmatrix_expression<E>::col_size() const noexcept
+{
+  return node_.col_size();
+}
+
+template<typename E>
+constexpr typename xmaho::std_ext::valmatrix_expression<E>::size_type
+xmaho::std_ext::valmatrix_expression<E>::size() const noexcept
+{
+  return node_.size();
+}
+
+template<typename E>
+void xmaho::std_ext::valmatrix_expression<E>::copy_to(value_type* first) const
+{
+  const auto rows {node_.col_size()};
+  const auto cols {node_.row_size()};
+  if constexpr (detail::has_transposed_terminal<E>::value) {
+    constexpr auto tile {detail::expression_tile_size};
+    for (size_type ib {0}; ib < rows; ib += tile)
+      for (size_type jb {0}; jb < cols; jb += tile)
+        for (auto i {ib}; i < std::min(ib + tile, rows); ++i)
+          for (auto j {jb}; j < std::min(jb + tile, cols); ++j)
+            first[i * cols + j] = node_.at(i * cols + j, i, j);
+  }
+  else {
+    for (size_type i {0}; i < rows * cols; ++i)
+      first[i] = node_[i];
+  }
+}
+
+template<typename E>
+constexpr const E& xmaho::std_ext::valmatrix_expression<E>::node() const noexcept
+{
+  return node_;
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::lazy(const valmatrix<T>& m) noexcept
+{
+  return valmatrix_expression<detail::matrix_terminal<T>>{detail::to_node(m)};
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::lazy(const transposed_view<T>& m) noexcept
+{
+  return valmatrix_expression<detail::transposed_terminal<T>>{detail::to_node(m)};
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator+(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::plus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator-(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::minus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator*(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::multiplies<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator/(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::divides<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator%(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::modulus<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator&(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::bit_and<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator|(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::bit_or<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator^(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<std::bit_xor<>>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator<<(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<detail::shift_left>(lhs, rhs);
+}
+
+template<typename L, typename R, typename>
+constexpr auto xmaho::std_ext::operator>>(const L& lhs, const R& rhs)
+{
+  return detail::make_binary_expression<detail::shift_right>(lhs, rhs);
+}
+
+template<typename E>
+constexpr auto xmaho::std_ext::operator+(const valmatrix_expression<E>& e)
+{
+  return detail::make_unary_expression<detail::unary_plus>(e);
+}
+
+template<typename E>
+constexpr auto xmaho::std_ext::operator-(const valmatrix_expression<E>& e)
+{
+  return detail::make_unary_expression<std::negate<>>(e);
+}
+
+template<typename E>
+constexpr auto xmaho::std_ext::operator~(const valmatrix_expression<E>& e)
+{
+  return detail::make_unary_expression<std::bit_not<>>(e);
+}
+
+#endif
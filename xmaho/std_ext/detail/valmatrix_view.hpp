@@ -0,0 +1,637 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_DETAIL_VALMATRIX_VIEW_H
+#define XMAHO_STD_EXT_DETAIL_VALMATRIX_VIEW_H
+
+#include "../valmatrix_view.hpp"
+#include "elementwise.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace xmaho::std_ext::detail
+{
+
+struct assign_rhs
+{
+  template<typename T, typename U>
+  constexpr const U& operator()(const T&, const U& rhs) const noexcept
+  {
+    return rhs;
+  }
+};
+
+template<typename T>
+constexpr std::pair<const T*, std::size_t> matrix_storage(const valmatrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size()};
+}
+
+template<typename T>
+constexpr std::pair<const T*, std::size_t> matrix_storage(const valmatrix_view<T>& v) noexcept
+{
+  return {v.data(), v.stride()};
+}
+
+template<typename T>
+struct is_valarray_view
+  : std::false_type
+{
+};
+
+template<typename T>
+struct is_valarray_view<valarray_view<T>>
+  : std::true_type
+{
+};
+
+template<typename T>
+struct is_view_operand
+  : std::false_type
+{
+};
+
+template<typename T, typename Layout>
+struct is_view_operand<valmatrix<T, Layout>>
+  : std::true_type
+{
+};
+
+template<typename T>
+struct is_view_operand<valmatrix_view<T>>
+  : std::true_type
+{
+};
+
+template<typename T>
+struct is_view_operand<std::valarray<T>>
+  : std::true_type
+{
+};
+
+template<typename T>
+struct is_view_operand<valarray_view<T>>
+  : std::true_type
+{
+};
+
+template<typename U, typename T>
+constexpr bool is_view_scalar_v {std::is_convertible_v<U, T> && !is_view_operand<U>::value};
+
+constexpr std::size_t storage_extent(std::size_t size, std::size_t count, std::size_t stride) noexcept
+{
+  return size && count ? (count - 1) * stride + size : 0;
+}
+
+template<typename T, typename U>
+bool is_partial_overlap(const T* lhs, std::size_t lhs_extent, std::size_t lhs_stride,
+                        const U* rhs, std::size_t rhs_extent, std::size_t rhs_stride) noexcept
+{
+  if (static_cast<const void*>(lhs) == static_cast<const void*>(rhs) && lhs_stride == rhs_stride)
+    return false; // Each element reads only itself.
+  const std::less<const void*> less;
+  return less(lhs, rhs + rhs_extent) && less(rhs, lhs + lhs_extent);
+}
+
+}
+
+template<typename T>
+constexpr xmaho::std_ext::valarray_view<T>::valarray_view(T* data, size_type size, size_type stride) noexcept
+  : data_ {data},
+    size_ {size},
+    stride_ {stride}
+{
+}
+
+template<typename T>
+template<typename U, typename>
+constexpr xmaho::std_ext::valarray_view<T>::valarray_view(const valarray_view<U>& other) noexcept
+  : data_ {other.data()},
+    size_ {other.size()},
+    stride_ {other.stride()}
+{
+}
+
+template<typename T>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator=(const valarray_view& rhs)
+{
+  return apply(rhs, detail::assign_rhs{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator=(const U& rhs)
+{
+  return apply(rhs, detail::assign_rhs{});
+}
+
+template<typename T>
+constexpr T& xmaho::std_ext::valarray_view<T>::operator[](size_type index) const
+{
+  assert(index < size_);
+  return data_[index * stride_];
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator+=(const U& rhs)
+{
+  return apply(rhs, std::plus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator-=(const U& rhs)
+{
+  return apply(rhs, std::minus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator*=(const U& rhs)
+{
+  return apply(rhs, std::multiplies<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator/=(const U& rhs)
+{
+  return apply(rhs, std::divides<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator%=(const U& rhs)
+{
+  return apply(rhs, std::modulus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator&=(const U& rhs)
+{
+  return apply(rhs, std::bit_and<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator|=(const U& rhs)
+{
+  return apply(rhs, std::bit_or<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator^=(const U& rhs)
+{
+  return apply(rhs, std::bit_xor<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator<<=(const U& rhs)
+{
+  return apply(rhs, detail::shift_left{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::operator>>=(const U& rhs)
+{
+  return apply(rhs, detail::shift_right{});
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valarray_view<T>::size_type xmaho::std_ext::valarray_view<T>::size() const noexcept
+{
+  return size_;
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valarray_view<T>::size_type xmaho::std_ext::valarray_view<T>::stride() const noexcept
+{
+  return stride_;
+}
+
+template<typename T>
+constexpr T* xmaho::std_ext::valarray_view<T>::data() const noexcept
+{
+  return data_;
+}
+
+template<typename T>
+typename xmaho::std_ext::valarray_view<T>::value_type xmaho::std_ext::valarray_view<T>::sum() const
+{
+  assert(size_);
+  value_type result {data_[0]};
+  for (size_type i {1}; i < size_; ++i)
+    result += data_[i * stride_];
+  return result;
+}
+
+template<typename T>
+typename xmaho::std_ext::valarray_view<T>::value_type xmaho::std_ext::valarray_view<T>::min() const
+{
+  assert(size_);
+  return *std::min_element(begin(), end());
+}
+
+template<typename T>
+typename xmaho::std_ext::valarray_view<T>::value_type xmaho::std_ext::valarray_view<T>::max() const
+{
+  assert(size_);
+  return *std::max_element(begin(), end());
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valarray_view<T>::iterator xmaho::std_ext::valarray_view<T>::begin() const noexcept
+{
+  return {data_, static_cast<typename iterator::difference_type>(stride_)};
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valarray_view<T>::iterator xmaho::std_ext::valarray_view<T>::end() const noexcept
+{
+  return begin() + static_cast<typename iterator::difference_type>(size_);
+}
+
+template<typename T>
+template<typename U, typename Op>
+xmaho::std_ext::valarray_view<T>& xmaho::std_ext::valarray_view<T>::apply(const U& rhs, Op op)
+{
+  static_assert(!std::is_const_v<T>, "Read only view can't be modified");
+  if constexpr (detail::is_view_scalar_v<U, value_type>) {
+    const auto value {static_cast<value_type>(rhs)};
+    for (size_type i {0}; i < size_; ++i) {
+      auto& e {data_[i * stride_]};
+      e = static_cast<value_type>(op(e, value));
+    }
+  } else {
+    assert(size_ == rhs.size());
+    if constexpr (detail::is_valarray_view<U>::value) {
+      if (detail::is_partial_overlap(data_, detail::storage_extent(1, size_, stride_), stride_,
+                                     rhs.data(), detail::storage_extent(1, rhs.size(), rhs.stride()), rhs.stride())) {
+        std::valarray<value_type> copy(size_);
+        std::copy(rhs.begin(), rhs.end(), std::begin(copy));
+        return apply(copy, op);
+      }
+    }
+    auto it {std::begin(rhs)};
+    for (size_type i {0}; i < size_; ++i, ++it) {
+      auto& e {data_[i * stride_]};
+      e = static_cast<value_type>(op(e, *it));
+    }
+  }
+  return *this;
+}
+
+template<typename T>
+constexpr xmaho::std_ext::valmatrix_view<T>::valmatrix_view(T* data, size_type row_size, size_type col_size, size_type stride) noexcept
+  : data_ {data},
+    row_size_ {row_size},
+    col_size_ {col_size},
+    stride_ {stride}
+{
+}
+
+template<typename T>
+template<typename U, typename>
+constexpr xmaho::std_ext::valmatrix_view<T>::valmatrix_view(const valmatrix_view<U>& other) noexcept
+  : data_ {other.data()},
+    row_size_ {other.row_size()},
+    col_size_ {other.col_size()},
+    stride_ {other.stride()}
+{
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator=(const valmatrix_view& rhs)
+{
+  return apply(rhs, detail::assign_rhs{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator=(const U& rhs)
+{
+  return apply(rhs, detail::assign_rhs{});
+}
+
+template<typename T>
+constexpr T& xmaho::std_ext::valmatrix_view<T>::operator[](position_type position) const
+{
+  assert(position.first < row_size_);
+  assert(position.second < col_size_);
+  return data_[position.second * stride_ + position.first];
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator+=(const U& rhs)
+{
+  return apply(rhs, std::plus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator-=(const U& rhs)
+{
+  return apply(rhs, std::minus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator*=(const U& rhs)
+{
+  return apply(rhs, std::multiplies<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator/=(const U& rhs)
+{
+  return apply(rhs, std::divides<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator%=(const U& rhs)
+{
+  return apply(rhs, std::modulus<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator&=(const U& rhs)
+{
+  return apply(rhs, std::bit_and<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator|=(const U& rhs)
+{
+  return apply(rhs, std::bit_or<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator^=(const U& rhs)
+{
+  return apply(rhs, std::bit_xor<>{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator<<=(const U& rhs)
+{
+  return apply(rhs, detail::shift_left{});
+}
+
+template<typename T>
+template<typename U>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::operator>>=(const U& rhs)
+{
+  return apply(rhs, detail::shift_right{});
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::size_type xmaho::std_ext::valmatrix_view<T>::row_size() const noexcept
+{
+  return row_size_;
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::size_type xmaho::std_ext::valmatrix_view<T>::col_size() const noexcept
+{
+  return col_size_;
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::size_type xmaho::std_ext::valmatrix_view<T>::size() const noexcept
+{
+  return row_size_ * col_size_;
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::size_type xmaho::std_ext::valmatrix_view<T>::stride() const noexcept
+{
+  return stride_;
+}
+
+template<typename T>
+constexpr T* xmaho::std_ext::valmatrix_view<T>::data() const noexcept
+{
+  return data_;
+}
+
+template<typename T>
+constexpr xmaho::std_ext::valarray_view<T> xmaho::std_ext::valmatrix_view<T>::row(size_type index) const
+{
+  assert(index < col_size_);
+  return {data_ + index * stride_, row_size_, 1};
+}
+
+template<typename T>
+constexpr xmaho::std_ext::valarray_view<T> xmaho::std_ext::valmatrix_view<T>::col(size_type index) const
+{
+  assert(index < row_size_);
+  return {data_ + index, col_size_, stride_};
+}
+
+template<typename T>
+constexpr xmaho::std_ext::valmatrix_view<T> xmaho::std_ext::valmatrix_view<T>::block(position_type pos, position_type size) const
+{
+  assert(pos.first + size.first <= row_size_);
+  assert(pos.second + size.second <= col_size_);
+  return {data_ + pos.second * stride_ + pos.first, size.first, size.second, stride_};
+}
+
+template<typename T>
+typename xmaho::std_ext::valmatrix_view<T>::value_type xmaho::std_ext::valmatrix_view<T>::sum() const
+{
+  assert(size());
+  value_type result {row(0).sum()};
+  for (size_type y {1}; y < col_size_; ++y) {
+    const T* const line {data_ + y * stride_};
+    for (size_type x {0}; x < row_size_; ++x)
+      result += line[x];
+  }
+  return result;
+}
+
+template<typename T>
+typename xmaho::std_ext::valmatrix_view<T>::value_type xmaho::std_ext::valmatrix_view<T>::min() const
+{
+  assert(size());
+  return *std::min_element(begin(), end());
+}
+
+template<typename T>
+typename xmaho::std_ext::valmatrix_view<T>::value_type xmaho::std_ext::valmatrix_view<T>::max() const
+{
+  assert(size());
+  return *std::max_element(begin(), end());
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::iterator xmaho::std_ext::valmatrix_view<T>::begin() const noexcept
+{
+  return {data_, 0, row_size_, stride_};
+}
+
+template<typename T>
+constexpr typename xmaho::std_ext::valmatrix_view<T>::iterator xmaho::std_ext::valmatrix_view<T>::end() const noexcept
+{
+  return size() ? iterator{data_ + col_size_ * stride_, 0, row_size_, stride_} : begin();
+}
+
+template<typename T>
+template<typename U, typename Op>
+xmaho::std_ext::valmatrix_view<T>& xmaho::std_ext::valmatrix_view<T>::apply(const U& rhs, Op op)
+{
+  static_assert(!std::is_const_v<T>, "Read only view can't be modified");
+  if constexpr (detail::is_view_scalar_v<U, value_type>) {
+    const auto value {static_cast<value_type>(rhs)};
+    for (size_type y {0}; y < col_size_; ++y) {
+      T* const line {data_ + y * stride_};
+      for (size_type x {0}; x < row_size_; ++x)
+        line[x] = static_cast<value_type>(op(line[x], value));
+    }
+  } else {
+    assert(row_size_ == rhs.row_size());
+    assert(col_size_ == rhs.col_size());
+    const auto [source, source_stride] = detail::matrix_storage(rhs);
+    if (detail::is_partial_overlap(data_, detail::storage_extent(row_size_, col_size_, stride_), stride_,
+                                   source, detail::storage_extent(row_size_, col_size_, source_stride), source_stride)) {
+      valmatrix<value_type> copy(row_size_, col_size_);
+      view(copy) = rhs;
+      return apply(copy, op);
+    }
+    for (size_type y {0}; y < col_size_; ++y) {
+      T* const line {data_ + y * stride_};
+      const value_type* const source_line {source + y * source_stride};
+      for (size_type x {0}; x < row_size_; ++x)
+        line[x] = static_cast<value_type>(op(line[x], source_line[x]));
+    }
+  }
+  return *this;
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<const T> xmaho::std_ext::view(const valmatrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<T> xmaho::std_ext::view(valmatrix<T>& m) noexcept
+{
+  return {m.data(), m.row_size(), m.col_size(), m.row_size()};
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<const T> xmaho::std_ext::block_view(const valmatrix<T>& m, std::pair<std::size_t, std::size_t> pos, std::pair<std::size_t, std::size_t> size)
+{
+  return view(m).block(pos, size);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix_view<T> xmaho::std_ext::block_view(valmatrix<T>& m, std::pair<std::size_t, std::size_t> pos, std::pair<std::size_t, std::size_t> size)
+{
+  return view(m).block(pos, size);
+}
+
+template<typename T>
+xmaho::std_ext::valarray_view<const T> xmaho::std_ext::row_view(const valmatrix<T>& m, std::size_t index)
+{
+  return view(m).row(index);
+}
+
+template<typename T>
+xmaho::std_ext::valarray_view<T> xmaho::std_ext::row_view(valmatrix<T>& m, std::size_t index)
+{
+  return view(m).row(index);
+}
+
+template<typename T>
+xmaho::std_ext::valarray_view<const T> xmaho::std_ext::col_view(const valmatrix<T>& m, std::size_t index)
+{
+  return view(m).col(index);
+}
+
+template<typename T>
+xmaho::std_ext::valarray_view<T> xmaho::std_ext::col_view(valmatrix<T>& m, std::size_t index)
+{
+  return view(m).col(index);
+}
+
+template<typename T>
+xmaho::std_ext::valmatrix<std::remove_const_t<T>> xmaho::std_ext::to_valmatrix(const valmatrix_view<T>& v)
+{
+  valmatrix<std::remove_const_t<T>> result(v.row_size(), v.col_size());
+  std::copy(v.begin(), v.end(), result.data());
+  return result;
+}
+
+template<typename T>
+std::valarray<std::remove_const_t<T>> xmaho::std_ext::to_valarray(const valarray_view<T>& v)
+{
+  std::valarray<std::remove_const_t<T>> result(v.size());
+  std::copy(v.begin(), v.end(), std::begin(result));
+  return result;
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::begin(const valarray_view<T>& v) noexcept
+{
+  return v.begin();
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::end(const valarray_view<T>& v) noexcept
+{
+  return v.end();
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::begin(const valmatrix_view<T>& v) noexcept
+{
+  return v.begin();
+}
+
+template<typename T>
+constexpr auto xmaho::std_ext::end(const valmatrix_view<T>& v) noexcept
+{
+  return v.end();
+}
+
+#endif
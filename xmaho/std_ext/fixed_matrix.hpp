@@ -0,0 +1,873 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_FIXED_MATRIX_H
+#define XMAHO_STD_EXT_FIXED_MATRIX_H
+
+#include "matmul.hpp"
+#include "valmatrix.hpp"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file std_ext/fixed_matrix.hpp
+ * @brief The matrix class that dimention is fixed at compile time.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The matrix class that dimention is fixed at compile time.
+ *
+ * Elements are stored in std::array without heap allocation,
+ * and dimention check is done by type.
+ * Operations are constexpr and unrolled for small matrices such as 3x3 or 4x4 transform.
+ * Elements are stored row by row same as valmatrix.
+ *
+ * @code
+ * constexpr fixed_matrix<int, 2, 2> a {{1, 2, 3, 4}};
+ * constexpr auto b {matmul(a, a)}; // {7, 10, 15, 22}
+ * valmatrix<int> c {b};
+ * @endcode
+ *
+ * @tparam T Value type.
+ * @tparam RowSize Row size (count of column).
+ * @tparam ColSize Column size (count of row).
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+class fixed_matrix
+{
+  static_assert(RowSize && ColSize, "fixed_matrix must not be empty.");
+public:
+  //! @brief Value type.
+  using value_type = T;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+  //! @brief Iterator type.
+  using iterator = typename std::array<T, RowSize * ColSize>::iterator;
+  //! @brief Const iterator type.
+  using const_iterator = typename std::array<T, RowSize * ColSize>::const_iterator;
+
+  /**
+   * @brief Default constructor.
+   *
+   * @post all elements are `T{}`.
+   */
+  constexpr fixed_matrix() noexcept;
+
+  /**
+   * @brief Construct with default value.
+   *
+   * @post all elements are value.
+   *
+   * @param[in] value Default value.
+   */
+  constexpr explicit fixed_matrix(const T& value) noexcept;
+
+  /**
+   * @brief Construct by values.
+   *
+   * @param[in] values Values stored row by row.
+   */
+  constexpr explicit fixed_matrix(const std::array<T, RowSize * ColSize>& values) noexcept;
+
+  /**
+   * @brief Construct by valmatrix.
+   *
+   * @pre matrix.row_size() == RowSize
+   * @pre matrix.col_size() == ColSize
+   *
+   * @param[in] matrix Same dimention valmatrix.
+   */
+  explicit fixed_matrix(const valmatrix<T>& matrix);
+
+  /**
+   * @brief Convert to valmatrix.
+   *
+   * @return valmatrix that has same elements.
+   */
+  operator valmatrix<T>() const;
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Const reference of access point.
+   */
+  constexpr const T& operator[](size_type index) const noexcept;
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Reference of access point.
+   */
+  constexpr T& operator[](size_type index) noexcept;
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point (column index, row index).
+   * @return Const reference of access point.
+   */
+  constexpr const T& operator[](position_type position) const noexcept;
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point (column index, row index).
+   * @return Reference of access point.
+   */
+  constexpr T& operator[](position_type position) noexcept;
+
+  /**
+   * @brief Apply + operator to each elements in the matrix.
+   *
+   * @return Non affect values.
+   */
+  constexpr fixed_matrix operator+() const noexcept;
+
+  /**
+   * @brief Apply - operator to each elements in the matrix.
+   *
+   * @return The matrix that each elements are negative.
+   */
+  constexpr fixed_matrix operator-() const noexcept;
+
+  /**
+   * @brief Apply ~ operator to each elements in the matrix.
+   *
+   * @return The matrix that each elements are applied bitwize not.
+   */
+  constexpr fixed_matrix operator~() const noexcept;
+
+  /**
+   * @brief Addition assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator+=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Addition assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator+=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Addition assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator+=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Subtraction assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator-=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Subtraction assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator-=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Subtraction assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator-=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Multiplication assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator*=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Multiplication assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator*=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Multiplication assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator*=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Division assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator/=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Division assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator/=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Division assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator/=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Residue assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator%=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Residue assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator%=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Residue assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator%=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Bitwise and assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator&=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Bitwise and assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator&=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Bitwise and assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator&=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Bitwise or assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator|=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Bitwise or assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator|=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Bitwise or assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator|=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Xor assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator^=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Xor assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator^=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Xor assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator^=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Shift assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator<<=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Shift assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator<<=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Shift assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator<<=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Counter shift assign to each element in the matrix.
+   *
+   * @param[in] rhs Same dimention matrix.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator>>=(const fixed_matrix& rhs) & noexcept;
+
+  /**
+   * @brief Counter shift assign to each element in the matrix.
+   *
+   * @pre rhs.row_size() == RowSize
+   * @pre rhs.col_size() == ColSize
+   *
+   * @param[in] rhs Same dimention valmatrix.
+   * @return This reference.
+   */
+  fixed_matrix& operator>>=(const valmatrix<T>& rhs) &;
+
+  /**
+   * @brief Counter shift assign to each element in the matrix.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  constexpr fixed_matrix& operator>>=(const T& rhs) & noexcept;
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  static constexpr size_type row_size() noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  static constexpr size_type col_size() noexcept;
+
+  /**
+   * @brief Get count of elements.
+   *
+   * @return row_size() * col_size()
+   */
+  static constexpr size_type size() noexcept;
+
+  /**
+   * @brief Get sum of elements.
+   *
+   * @return Sum of elements.
+   */
+  constexpr T sum() const noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Const begin iterator.
+   */
+  constexpr const_iterator begin() const noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Begin iterator.
+   */
+  constexpr iterator begin() noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return Const end iterator.
+   */
+  constexpr const_iterator end() const noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return End iterator.
+   */
+  constexpr iterator end() noexcept;
+
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * @return Const pointer to first element.
+   */
+  constexpr const T* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * @return Pointer to first element.
+   */
+  constexpr T* data() noexcept;
+
+private:
+  std::array<T, RowSize * ColSize> values_;
+};
+
+/**
+ * @brief Compare all elements.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return true if all elements are equal.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr bool operator==(const fixed_matrix<T, RowSize, ColSize>& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Compare all elements.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return true if any element is not equal.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr bool operator!=(const fixed_matrix<T, RowSize, ColSize>& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Addition operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of addition.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator+(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Addition operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of addition.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator+(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Addition operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of addition.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator+(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Subtraction operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of subtraction.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator-(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Subtraction operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of subtraction.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator-(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Subtraction operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of subtraction.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator-(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Multiplication operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator*(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Multiplication operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator*(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Multiplication operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator*(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Division operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of division.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator/(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Division operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of division.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator/(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Division operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of division.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator/(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Residue operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of residue.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator%(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Residue operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of residue.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator%(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Residue operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of residue.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator%(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Bitwise and operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise and.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator&(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Bitwise and operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise and.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator&(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Bitwise and operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise and.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator&(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Bitwise or operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise or.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator|(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Bitwise or operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise or.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator|(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Bitwise or operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of bitwise or.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator|(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Xor operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of xor.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator^(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Xor operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of xor.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator^(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Xor operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of xor.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator^(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Shift operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator<<(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Shift operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator<<(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Shift operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator<<(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Counter shift operator for fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of counter shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator>>(fixed_matrix<T, RowSize, ColSize> lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Counter shift operator for fixed_matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of counter shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator>>(fixed_matrix<T, RowSize, ColSize> lhs, const T& rhs) noexcept;
+
+/**
+ * @brief Counter shift operator for value with fixed_matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of counter shift.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, RowSize, ColSize> operator>>(const T& lhs, const fixed_matrix<T, RowSize, ColSize>& rhs) noexcept;
+
+/**
+ * @brief Matrix product of fixed_matrix.
+ *
+ * Dimention is checked by type, and all loops are unrolled.
+ *
+ * @param[in] a Left matrix that has M rows and K columns.
+ * @param[in] b Right matrix that has K rows and N columns.
+ * @return Product matrix that has M rows and N columns.
+ */
+template<typename T, std::size_t K, std::size_t M, std::size_t N>
+constexpr fixed_matrix<T, N, M> matmul(const fixed_matrix<T, K, M>& a, const fixed_matrix<T, N, K>& b) noexcept;
+
+/**
+ * @brief Get transposed matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return Transposed matrix.
+ */
+template<typename T, std::size_t RowSize, std::size_t ColSize>
+constexpr fixed_matrix<T, ColSize, RowSize> transpose(const fixed_matrix<T, RowSize, ColSize>& m) noexcept;
+
+}
+
+#include "detail/fixed_matrix.hpp"
+
+#endif
@@ -0,0 +1,299 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_MAPPED_MATRIX_H
+#define XMAHO_STD_EXT_MAPPED_MATRIX_H
+
+#include "matrix_file.hpp"
+#include "valmatrix.hpp"
+#include "valmatrix_expression.hpp"
+#include "valmatrix_view.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file std_ext/mapped_matrix.hpp
+ * @brief The matrix which maps matrix file to memory.
+ *
+ * This header is available on POSIX system.
+ */
+
+#if __has_include(<sys/mman.h>)
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The matrix which maps matrix file of matrix_file.hpp.
+ *
+ * Opening the file costs constant time regardless of matrix size,
+ * and pages of the payload are read when they are accessed.
+ * Use `const T` to map the file as read only.
+ * Otherwise the modification is written back to the file.
+ *
+ * @code
+ * const valmatrix<double> a(1., 3, 2);
+ * mapped_matrix<double> file {"a.mat", a};              // create file
+ * const mapped_matrix<const double> b {"a.mat"};        // map as read only
+ * const valmatrix<double> c {lazy(b) * 2.};             // use as expression operand
+ * @endcode
+ *
+ * @note This class is move only, and the mapping is released at destruction.
+ *
+ * @tparam T Arithmetic element type. const qualified type is read only mapping.
+ */
+template<typename T>
+class mapped_matrix
+{
+public:
+  //! @brief Value type.
+  using value_type = std::remove_const_t<T>;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Map existing matrix file.
+   *
+   * @param[in] path Path of matrix file.
+   * @exception std::system_error Failed to open or map the file.
+   * @exception std::runtime_error The file is invalid or for other element type.
+   */
+  explicit mapped_matrix(const std::filesystem::path& path);
+
+  /**
+   * @brief Create matrix file and map it.
+   *
+   * Existing file is truncated.
+   * T must not be const qualified.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @post all elements are `T{}`.
+   *
+   * @param[in] path Path of matrix file.
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   * @exception std::system_error Failed to create or map the file.
+   */
+  mapped_matrix(const std::filesystem::path& path, size_type row_size, size_type col_size);
+
+  /**
+   * @brief Create matrix file with elements of valmatrix and map it.
+   *
+   * Existing file is truncated.
+   * T must not be const qualified.
+   *
+   * @param[in] path Path of matrix file.
+   * @param[in] m Source matrix.
+   * @exception std::system_error Failed to create or map the file.
+   */
+  mapped_matrix(const std::filesystem::path& path, const valmatrix<value_type>& m);
+
+  //! @brief Move constructor.
+  mapped_matrix(mapped_matrix&& other) noexcept;
+  //! @brief Move assign.
+  mapped_matrix& operator=(mapped_matrix&& other) noexcept;
+  mapped_matrix(const mapped_matrix&) = delete;
+  mapped_matrix& operator=(const mapped_matrix&) = delete;
+
+  //! @brief Release mapping.
+  ~mapped_matrix();
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Const reference of element.
+   */
+  const value_type& operator[](size_type index) const;
+
+  /**
+   * @brief Access by serial index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Reference of element.
+   */
+  T& operator[](size_type index);
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return Const reference of access point.
+   */
+  const value_type& operator[](position_type position) const;
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return Reference of access point.
+   */
+  T& operator[](position_type position);
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get element count.
+   *
+   * @return row_size() * col_size()
+   */
+  size_type size() const noexcept;
+
+  /**
+   * @brief Get pointer to the mapped payload.
+   *
+   * The element of row r and column c is `data()[r * row_size() + c]`.
+   *
+   * @return Const pointer to first element.
+   */
+  const value_type* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the mapped payload.
+   *
+   *
+   * @return Pointer to first element.
+   */
+  T* data() noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Const begin iterator.
+   */
+  const value_type* begin() const noexcept;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   *
+   * @return Begin iterator.
+   */
+  T* begin() noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return Const end iterator.
+   */
+  const value_type* end() const noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   *
+   * @return End iterator.
+   */
+  T* end() noexcept;
+
+  /**
+   * @brief Write modified pages back to the file synchronously.
+   *
+   * It does nothing for read only mapping.
+   *
+   * @exception std::system_error Failed to write.
+   */
+  void flush() const;
+
+private:
+  void* address_ {nullptr};
+  size_type length_ {0};
+  position_type size_ {};
+};
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return Read only view.
+ */
+template<typename T>
+valmatrix_view<const std::remove_const_t<T>> view(const mapped_matrix<T>& m) noexcept;
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return View.
+ */
+template<typename T>
+valmatrix_view<T> view(mapped_matrix<T>& m) noexcept;
+
+/**
+ * @brief Start lazy expression from mapped_matrix.
+ *
+ * @param[in] m The operand matrix.
+ * @return The expression that refers m.
+ */
+template<typename T>
+constexpr auto lazy(const mapped_matrix<T>& m) noexcept;
+
+/**
+ * @brief Copy elements to new valmatrix.
+ *
+ * @param[in] m Source matrix.
+ * @return Copy of matrix.
+ */
+template<typename T>
+valmatrix<std::remove_const_t<T>> to_valmatrix(const mapped_matrix<T>& m);
+
+}
+
+#include "detail/mapped_matrix.hpp"
+
+#endif
+
+#endif
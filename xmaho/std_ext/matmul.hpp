@@ -0,0 +1,174 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_MATMUL_H
+#define XMAHO_STD_EXT_MATMUL_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file std_ext/matmul.hpp
+ * @brief The matrix product for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Return matrix product "a b".
+ *
+ * The operator* of valmatrix is element-wise product.
+ * This function is true matrix product with cache-blocked kernel.
+ *
+ * @pre a.row_size() == b.col_size()
+ * @post result.row_size() == b.row_size()
+ * @post result.col_size() == a.col_size()
+ *
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side matrix.
+ * @return The matrix product.
+ *
+ * @code
+ * const valmatrix<int> a {{1, 2, 3, 4, 5, 6}, 3, 2}; // 2 rows, 3 columns
+ * const valmatrix<int> b {{1, 0, 0, 1, 1, 1}, 2, 3}; // 3 rows, 2 columns
+ * const auto c {matmul(a, b)};
+ * assert(c.row_size() == 2 && c.col_size() == 2);
+ * assert(c[0] == 4 && c[1] == 5 && c[2] == 10 && c[3] == 11);
+ * @endcode
+ */
+template<typename T>
+valmatrix<T> matmul(const valmatrix<T>& a, const valmatrix<T>& b);
+
+/**
+ * @brief Store matrix product "a b" to result.
+ *
+ * Reuse storage of result for repeated products.
+ *
+ * @pre a.row_size() == b.col_size()
+ * @pre result.row_size() == b.row_size()
+ * @pre result.col_size() == a.col_size()
+ * @pre result is neither a nor b.
+ *
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side matrix.
+ * @param[out] result Destination matrix.
+ * @return Reference of result.
+ */
+template<typename T>
+valmatrix<T>& matmul(const valmatrix<T>& a, const valmatrix<T>& b, valmatrix<T>& result);
+
+/**
+ * @brief Default size under which strassen_matmul() uses the blocked kernel.
+ *
+ * Measured with double on x86-64, one level of recursion is even at 512
+ * and pays off from about 1024, so products of half size 512 or less use the blocked kernel.
+ */
+inline constexpr std::size_t default_strassen_cutoff {512};
+
+/**
+ * @brief Return matrix product "a b" by Strassen-Winograd recursion.
+ *
+ * Each level computes the product with 7 half size products instead of 8,
+ * and the products under cutoff use the blocked kernel of matmul().
+ * Odd row or column is peeled and added by the blocked kernel.
+ * The temporaries of all levels are allocated at once.
+ *
+ * @note The error bound is weaker than the classic product by a factor growing with recursion depth.
+ *
+ * @pre a.row_size() == b.col_size()
+ * @post result.row_size() == b.row_size()
+ * @post result.col_size() == a.col_size()
+ *
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side matrix.
+ * @param[in] cutoff Recursion stops when any dimention is not greater than this.
+ * @return The matrix product.
+ */
+template<typename T>
+valmatrix<T> strassen_matmul(const valmatrix<T>& a, const valmatrix<T>& b, std::size_t cutoff = default_strassen_cutoff);
+
+/**
+ * @brief Store matrix product "a b" by Strassen-Winograd recursion to result.
+ *
+ * @pre a.row_size() == b.col_size()
+ * @pre result.row_size() == b.row_size()
+ * @pre result.col_size() == a.col_size()
+ * @pre result is neither a nor b.
+ *
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side matrix.
+ * @param[out] result Destination matrix.
+ * @param[in] cutoff Recursion stops when any dimention is not greater than this.
+ * @return Reference of result.
+ */
+template<typename T>
+valmatrix<T>& strassen_matmul(const valmatrix<T>& a, const valmatrix<T>& b, valmatrix<T>& result, std::size_t cutoff = default_strassen_cutoff);
+
+/**
+ * @brief Return product of chain of matrices in the cheapest order.
+ *
+ * The parenthesization that minimizes count of multiplications
+ * is found by dynamic programming on the dimentions,
+ * and the intermediate products reuse a pool of scratch buffers.
+ *
+ * @code
+ * const valmatrix<double> a(1., 100, 10), b(1., 5, 100), c(1., 50, 5); // 10x100, 100x5, 5x50
+ * const auto abc {multiply_chain(a, b, c)}; // (a b) c: 7500 multiplications instead of 75000.
+ * @endcode
+ *
+ * @pre matrices[i].row_size() == matrices[i + 1].col_size()
+ * @pre !matrices.empty()
+ *
+ * @param[in] matrices Operands from left to right.
+ * @return The matrix product.
+ */
+template<typename T>
+valmatrix<T> multiply_chain(const std::vector<const valmatrix<T>*>& matrices);
+
+/**
+ * @brief Return product of chain of matrices in the cheapest order.
+ *
+ * Same as multiply_chain() with the vector of pointers to the operands.
+ *
+ * @pre Each row_size() is equal to col_size() of the next operand.
+ *
+ * @param[in] first Left most operand.
+ * @param[in] rest Other operands from left to right.
+ * @return The matrix product.
+ */
+template<typename T, typename... Matrices>
+valmatrix<T> multiply_chain(const valmatrix<T>& first, const Matrices&... rest);
+
+}
+
+#include "detail/matmul.hpp"
+
+#endif
@@ -0,0 +1,166 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_MATRIX_FILE_H
+#define XMAHO_STD_EXT_MATRIX_FILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file std_ext/matrix_file.hpp
+ * @brief The binary file format of matrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Kind of element in matrix file.
+ */
+enum class matrix_value_kind : std::uint32_t
+{
+  signed_integer,
+  unsigned_integer,
+  floating_point
+};
+
+/**
+ * @brief Header of matrix file.
+ *
+ * The file is this 64 byte header and following payload.
+ * The payload is `row_size * col_size` elements stored row by row
+ * in byte order of endian_tag without padding,
+ * so the payload is aligned to 64 bytes when the file is mapped.
+ */
+struct matrix_file_header
+{
+  //! @brief "XMAHOMAT".
+  std::array<char, 8> magic;
+  //! @brief Format version.
+  std::uint32_t version;
+  //! @brief matrix_file_endian_tag written by byte order of the writer.
+  std::uint32_t endian_tag;
+  //! @brief Byte size of an element.
+  std::uint32_t value_size;
+  //! @brief Kind of element.
+  matrix_value_kind value_kind;
+  //! @brief Row size of matrix that is count of column.
+  std::uint64_t row_size;
+  //! @brief Column size of matrix that is count of row.
+  std::uint64_t col_size;
+  //! @brief matrix_file_checksum of payload if flags has matrix_file_checksum_flag.
+  std::uint64_t checksum;
+  //! @brief Bit set of matrix_file_checksum_flag.
+  std::uint32_t flags;
+  //! @brief Reserved. It must be zero.
+  std::array<std::uint32_t, 3> reserved;
+};
+
+static_assert(sizeof(matrix_file_header) == 64, "matrix_file_header must be 64 bytes");
+
+//! @brief Magic number at the top of matrix file.
+constexpr std::array<char, 8> matrix_file_magic {'X', 'M', 'A', 'H', 'O', 'M', 'A', 'T'};
+
+//! @brief Current version of matrix file.
+constexpr std::uint32_t matrix_file_version {1};
+
+//! @brief Tag of byte order that is read as other value on different endian.
+constexpr std::uint32_t matrix_file_endian_tag {0x01020304};
+
+//! @brief Flag that checksum field is valid.
+constexpr std::uint32_t matrix_file_checksum_flag {1};
+
+/**
+ * @brief Incremental checksum of matrix file payload.
+ *
+ * This is Fletcher checksum of 32 bit little endian words modulo 2^32,
+ * so the value doesn't depend on byte order of the host.
+ * The last word is padded by zero.
+ *
+ * @code
+ * matrix_file_checksum checksum;
+ * checksum.update(first_chunk, first_chunk_size); // size is multiple of 4 except last
+ * checksum.update(last_chunk, last_chunk_size);
+ * header.checksum = checksum.value();
+ * @endcode
+ */
+class matrix_file_checksum
+{
+public:
+  /**
+   * @brief Append bytes.
+   *
+   * @pre size is multiple of 4 unless this is the last call.
+   *
+   * @param[in] data First byte.
+   * @param[in] size Count of bytes.
+   */
+  void update(const void* data, std::size_t size) noexcept;
+
+  /**
+   * @brief Get checksum of appended bytes.
+   *
+   * @return Checksum.
+   */
+  std::uint64_t value() const noexcept;
+
+private:
+  std::uint32_t sum_ {0};
+  std::uint32_t sum_of_sum_ {0};
+};
+
+/**
+ * @brief Make header of matrix file.
+ *
+ * @tparam T Arithmetic element type.
+ *
+ * @param[in] row_size Row size.
+ * @param[in] col_size Column size.
+ * @return Header for element type T and native byte order.
+ */
+template<typename T>
+constexpr matrix_file_header make_matrix_file_header(std::size_t row_size, std::size_t col_size) noexcept;
+
+/**
+ * @brief Check that header is written for element type T by native byte order.
+ *
+ * @tparam T Arithmetic element type.
+ *
+ * @param[in] header Header read from file.
+ * @exception std::runtime_error The header is invalid or for other type or byte order.
+ */
+template<typename T>
+void check_matrix_file_header(const matrix_file_header& header);
+
+}
+
+#include "detail/matrix_file.hpp"
+
+#endif
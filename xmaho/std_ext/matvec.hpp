@@ -0,0 +1,173 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_MATVEC_H
+#define XMAHO_STD_EXT_MATVEC_H
+
+#include "valmatrix.hpp"
+
+#include <valarray>
+
+/**
+ * @file std_ext/matvec.hpp
+ * @brief The matrix-vector operations (BLAS level 2) for valmatrix and valarray.
+ *
+ * Each function reads the matrix once in memory order without copying rows or columns.
+ * Products with the matrix use inner products of rows,
+ * and products with the transposed matrix add scaled rows to the result,
+ * so both are contiguous in the storage.
+ *
+ * @code
+ * const valmatrix<double> a {{1, 2, 3, 4, 5, 6}, 3, 2}; // 2 rows, 3 columns
+ * const std::valarray<double> x {1, 0, 1};
+ * const auto y {gemv(a, x)};                            // {4, 10}
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The operation applied to the matrix.
+ */
+enum class transpose_mode
+{
+  none,     //!< A.
+  transpose //!< A^T.
+};
+
+/**
+ * @brief The triangular part of the matrix that is read.
+ */
+enum class triangle
+{
+  lower, //!< Lower part including diagonal.
+  upper  //!< Upper part including diagonal.
+};
+
+/**
+ * @brief The diagonal of the triangular matrix.
+ */
+enum class diagonal
+{
+  non_unit, //!< Diagonal is read from the matrix.
+  unit      //!< Diagonal is assumed to be one, and isn't read.
+};
+
+/**
+ * @brief Return matrix-vector product "A x".
+ *
+ * @pre a.row_size() == x.size()
+ *
+ * @param[in] a Matrix.
+ * @param[in] x Vector.
+ * @return The product that size is a.col_size().
+ */
+template<typename T>
+std::valarray<T> gemv(const valmatrix<T>& a, const std::valarray<T>& x);
+
+/**
+ * @brief Compute "y = alpha op(A) x + beta y".
+ *
+ * y isn't read if beta is zero.
+ *
+ * @pre a.row_size() == x.size() && a.col_size() == y.size() if trans is none.
+ * @pre a.col_size() == x.size() && a.row_size() == y.size() if trans is transpose.
+ * @pre y is not x.
+ *
+ * @param[in] alpha Scale of product.
+ * @param[in] a Matrix.
+ * @param[in] x Vector.
+ * @param[in] beta Scale of y.
+ * @param[in,out] y Result vector.
+ * @param[in] trans Operation applied to a.
+ * @return Reference of y.
+ */
+template<typename T>
+std::valarray<T>& gemv(const T& alpha, const valmatrix<T>& a, const std::valarray<T>& x, const T& beta, std::valarray<T>& y, transpose_mode trans = transpose_mode::none);
+
+/**
+ * @brief Compute rank-1 update "A = alpha x y^T + A".
+ *
+ * @pre a.col_size() == x.size()
+ * @pre a.row_size() == y.size()
+ *
+ * @param[in] alpha Scale of outer product.
+ * @param[in] x Column vector.
+ * @param[in] y Row vector.
+ * @param[in,out] a Updated matrix.
+ * @return Reference of a.
+ */
+template<typename T>
+valmatrix<T>& ger(const T& alpha, const std::valarray<T>& x, const std::valarray<T>& y, valmatrix<T>& a);
+
+/**
+ * @brief Solve triangular system "op(A) x = b" in place.
+ *
+ * Only the uplo part of a is read.
+ *
+ * @pre a.row_size() == a.col_size()
+ * @pre a.row_size() == x.size()
+ * @pre Diagonal of a is not zero if diag is non_unit.
+ *
+ * @param[in] a Triangular matrix.
+ * @param[in,out] x Right hand side b, and solution x after return.
+ * @param[in] uplo Triangular part of a.
+ * @param[in] trans Operation applied to a.
+ * @param[in] diag Diagonal of a.
+ * @return Reference of x.
+ */
+template<typename T>
+std::valarray<T>& trsv(const valmatrix<T>& a, std::valarray<T>& x, triangle uplo, transpose_mode trans = transpose_mode::none, diagonal diag = diagonal::non_unit);
+
+/**
+ * @brief Compute "y = alpha A x + beta y" of symmetric matrix.
+ *
+ * Only the uplo part of a is read, and each element of it is read once.
+ * y isn't read if beta is zero.
+ *
+ * @pre a.row_size() == a.col_size()
+ * @pre a.row_size() == x.size() && a.row_size() == y.size()
+ * @pre y is not x.
+ *
+ * @param[in] alpha Scale of product.
+ * @param[in] a Symmetric matrix.
+ * @param[in] x Vector.
+ * @param[in] beta Scale of y.
+ * @param[in,out] y Result vector.
+ * @param[in] uplo Triangular part of a that is stored.
+ * @return Reference of y.
+ */
+template<typename T>
+std::valarray<T>& symv(const T& alpha, const valmatrix<T>& a, const std::valarray<T>& x, const T& beta, std::valarray<T>& y, triangle uplo = triangle::lower);
+
+}
+
+#include "detail/matvec.hpp"
+
+#endif
@@ -0,0 +1,354 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_PARALLEL_H
+#define XMAHO_STD_EXT_PARALLEL_H
+
+#include "valmatrix.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file std_ext/parallel.hpp
+ * @brief The multi-threaded element-wise operations for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The context of parallel execution.
+ *
+ * This class owns worker threads that live until destruction,
+ * so each call doesn't pay thread creation.
+ * The storage is split into chunks at cache line boundaries.
+ * The assignment of chunks to threads is stable,
+ * so the same chunk is always processed by the same thread index.
+ *
+ * @note The worker threads are not pinned to CPUs or NUMA nodes,
+ *       and the scaling on NUMA machines has not been measured.
+ * Small matrices under grain size are processed by the calling thread only.
+ *
+ * @code
+ * parallel_context context {};
+ * valmatrix<float> a(1.f, 4096, 4096), b(2.f, 4096, 4096);
+ * plus_assign(context, a, b); // a += b with all cores.
+ * const auto total {sum(context, a)};
+ * @endcode
+ */
+class parallel_context
+{
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  /**
+   * @brief Construct with thread count.
+   *
+   * @param[in] thread_count Count of threads including the calling thread. 0 means hardware concurrency.
+   * @param[in] grain_size Minimum count of elements per chunk.
+   */
+  explicit parallel_context(size_type thread_count = 0, size_type grain_size = 1u << 16);
+
+  parallel_context(const parallel_context&) = delete;
+  parallel_context& operator=(const parallel_context&) = delete;
+
+  //! @brief Stop and join worker threads.
+  ~parallel_context();
+
+  /**
+   * @brief Get count of threads including the calling thread.
+   *
+   * @return Count of threads.
+   */
+  size_type thread_count() const noexcept;
+
+  /**
+   * @brief Get minimum count of elements per chunk.
+   *
+   * @return Grain size.
+   */
+  size_type grain_size() const noexcept;
+
+  /**
+   * @brief Run function on all threads and wait for them.
+   *
+   * The calling thread runs index 0.
+   * The first exception thrown by function is rethrown.
+   *
+   * @param[in] function Function called with thread index.
+   */
+  void run(const std::function<void(size_type)>& function);
+
+private:
+  void work(size_type index);
+
+  std::vector<std::thread> workers_;
+  size_type grain_size_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_type)>* task_ {};
+  std::exception_ptr exception_ {};
+  size_type generation_ {0};
+  size_type pending_ {0};
+  bool stop_ {false};
+};
+
+/**
+ * @brief Addition assign to each element in the matrix in parallel.
+ *
+ * Same as `m += rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& plus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Subtraction assign to each element in the matrix in parallel.
+ *
+ * Same as `m -= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& minus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Multiplication assign to each element in the matrix in parallel.
+ *
+ * Same as `m *= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& multiplies_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Divition assign to each element in the matrix in parallel.
+ *
+ * Same as `m /= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& divides_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Residue assign to each element in the matrix in parallel.
+ *
+ * Same as `m %= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& modulus_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Bitwise and assign to each element in the matrix in parallel.
+ *
+ * Same as `m &= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& bit_and_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Bitwise or assign to each element in the matrix in parallel.
+ *
+ * Same as `m |= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& bit_or_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Xor assign to each element in the matrix in parallel.
+ *
+ * Same as `m ^= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& bit_xor_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Shift assign to each element in the matrix in parallel.
+ *
+ * Same as `m <<= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& shift_left_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Counter shift assign to each element in the matrix in parallel.
+ *
+ * Same as `m >>= rhs`.
+ *
+ * @pre Same dimention if rhs is valmatrix.
+ * @pre m.size() == rhs.size() if rhs is valarray.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in,out] m Target matrix.
+ * @param[in] rhs valmatrix, valarray or value.
+ * @return Reference of m.
+ */
+template<typename T, typename U>
+valmatrix<T>& shift_right_assign(parallel_context& context, valmatrix<T>& m, const U& rhs);
+
+/**
+ * @brief Get sum of elements in parallel.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @return Sum of elements.
+ */
+template<typename T>
+T sum(parallel_context& context, const valmatrix<T>& m);
+
+/**
+ * @brief Get minimum element in parallel.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @return Minimum element.
+ */
+template<typename T>
+T min(parallel_context& context, const valmatrix<T>& m);
+
+/**
+ * @brief Get maximum element in parallel.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @return Maximum element.
+ */
+template<typename T>
+T max(parallel_context& context, const valmatrix<T>& m);
+
+/**
+ * @brief Apply - operator to each elements in parallel.
+ *
+ * Same as `-m`.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @return The matrix that each elements are negative.
+ */
+template<typename T>
+valmatrix<T> negate(parallel_context& context, const valmatrix<T>& m);
+
+/**
+ * @brief Apply ~ operator to each elements in parallel.
+ *
+ * Same as `~m`.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @return The matrix that each elements are applied bitwize not.
+ */
+template<typename T>
+valmatrix<T> bit_not(parallel_context& context, const valmatrix<T>& m);
+
+}
+
+#include "detail/parallel.hpp"
+
+#endif
@@ -0,0 +1,142 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_REDUCTION_H
+#define XMAHO_STD_EXT_REDUCTION_H
+
+#include "valmatrix.hpp"
+
+#include <valarray>
+
+/**
+ * @file std_ext/reduction.hpp
+ * @brief The reductions along rows or columns of valmatrix.
+ *
+ * Each function reads the matrix once in memory order without temporaries.
+ * Column reductions accumulate whole rows into the result,
+ * so they never stride across the matrix.
+ *
+ * @code
+ * const valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2}; // 2 rows, 3 columns
+ * const auto rows {row_sum(m)};                    // {6, 15}
+ * const auto cols {col_max(m)};                    // {4, 5, 6}
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Get sum of each row.
+ *
+ * @param[in] m Target matrix.
+ * @return Sums that size is m.col_size().
+ */
+template<typename T>
+std::valarray<T> row_sum(const valmatrix<T>& m);
+
+/**
+ * @brief Get minimum element of each row.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] m Target matrix.
+ * @return Minimums that size is m.col_size().
+ */
+template<typename T>
+std::valarray<T> row_min(const valmatrix<T>& m);
+
+/**
+ * @brief Get maximum element of each row.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] m Target matrix.
+ * @return Maximums that size is m.col_size().
+ */
+template<typename T>
+std::valarray<T> row_max(const valmatrix<T>& m);
+
+/**
+ * @brief Get mean of each row.
+ *
+ * Integral types use integral divition.
+ *
+ * @param[in] m Target matrix.
+ * @return Means that size is m.col_size().
+ */
+template<typename T>
+std::valarray<T> row_mean(const valmatrix<T>& m);
+
+/**
+ * @brief Get sum of each column.
+ *
+ * @param[in] m Target matrix.
+ * @return Sums that size is m.row_size().
+ */
+template<typename T>
+std::valarray<T> col_sum(const valmatrix<T>& m);
+
+/**
+ * @brief Get minimum element of each column.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] m Target matrix.
+ * @return Minimums that size is m.row_size().
+ */
+template<typename T>
+std::valarray<T> col_min(const valmatrix<T>& m);
+
+/**
+ * @brief Get maximum element of each column.
+ *
+ * @pre 0 < m.size()
+ *
+ * @param[in] m Target matrix.
+ * @return Maximums that size is m.row_size().
+ */
+template<typename T>
+std::valarray<T> col_max(const valmatrix<T>& m);
+
+/**
+ * @brief Get mean of each column.
+ *
+ * Integral types use integral divition.
+ *
+ * @param[in] m Target matrix.
+ * @return Means that size is m.row_size().
+ */
+template<typename T>
+std::valarray<T> col_mean(const valmatrix<T>& m);
+
+}
+
+#include "detail/reduction.hpp"
+
+#endif
@@ -0,0 +1,117 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_SERIALIZATION_H
+#define XMAHO_STD_EXT_SERIALIZATION_H
+
+#include "matrix_file.hpp"
+#include "valmatrix.hpp"
+
+#include <istream>
+#include <ostream>
+#include <valarray>
+
+/**
+ * @file std_ext/serialization.hpp
+ * @brief The binary serialization of valmatrix and valarray.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Write matrix as matrix file of matrix_file.hpp.
+ *
+ * The payload is written by large chunks without formatting.
+ * The file can be also mapped by mapped_matrix, which doesn't verify the checksum.
+ *
+ * @code
+ * std::ofstream file {"a.mat", std::ios::binary};
+ * serialize(file, a, true);
+ * ...
+ * std::ifstream file {"a.mat", std::ios::binary};
+ * const auto a {deserialize_valmatrix<double>(file)};
+ * @endcode
+ *
+ * @param[in,out] os Output stream opened as binary.
+ * @param[in] m Source matrix.
+ * @param[in] checksum Write checksum of payload if true.
+ * @return os.
+ */
+template<typename T>
+std::ostream& serialize(std::ostream& os, const valmatrix<T>& m, bool checksum = false);
+
+/**
+ * @brief Write array as matrix file of matrix_file.hpp.
+ *
+ * The array is written as matrix of 1 row.
+ *
+ * @param[in,out] os Output stream opened as binary.
+ * @param[in] v Source array.
+ * @param[in] checksum Write checksum of payload if true.
+ * @return os.
+ */
+template<typename T>
+std::ostream& serialize(std::ostream& os, const std::valarray<T>& v, bool checksum = false);
+
+/**
+ * @brief Read matrix from matrix file of matrix_file.hpp.
+ *
+ * The file written by other byte order is converted.
+ * The checksum is verified if it is written.
+ *
+ * @tparam T Element type written in the file.
+ *
+ * @param[in,out] is Input stream opened as binary.
+ * @return Read matrix.
+ * @exception std::runtime_error The stream is invalid, truncated or corrupted.
+ */
+template<typename T>
+valmatrix<T> deserialize_valmatrix(std::istream& is);
+
+/**
+ * @brief Read array from matrix file of matrix_file.hpp.
+ *
+ * All elements of the matrix are read in row by row.
+ * The file written by other byte order is converted.
+ * The checksum is verified if it is written.
+ *
+ * @tparam T Element type written in the file.
+ *
+ * @param[in,out] is Input stream opened as binary.
+ * @return Read array.
+ * @exception std::runtime_error The stream is invalid, truncated or corrupted.
+ */
+template<typename T>
+std::valarray<T> deserialize_valarray(std::istream& is);
+
+}
+
+#include "detail/serialization.hpp"
+
+#endif
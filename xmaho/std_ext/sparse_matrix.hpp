@@ -0,0 +1,423 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_SPARSE_MATRIX_H
+#define XMAHO_STD_EXT_SPARSE_MATRIX_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <valarray>
+#include <vector>
+
+/**
+ * @file std_ext/sparse_matrix.hpp
+ * @brief The compressed sparse matrix for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+//! @brief Order of compression.
+enum class sparse_major
+{
+  row,   //!< Compressed sparse row (CSR).
+  column //!< Compressed sparse column (CSC).
+};
+
+/**
+ * @brief The compressed sparse matrix.
+ *
+ * Only nonzero elements are stored with their indices,
+ * so memory and time of operations scale with the count of nonzero elements.
+ * The dimention follows valmatrix: row_size() is count of column and col_size() is count of row.
+ *
+ * @code
+ * valmatrix<double> dense(3, 3);
+ * dense[4] = 2.;
+ * const csr_matrix<double> sparse {dense};       // one nonzero element
+ * const auto y {matmul(sparse, std::valarray<double>(1., 3))}; // {0, 2, 0}
+ * @endcode
+ *
+ * @tparam T Value type.
+ * @tparam Major Order of compression.
+ */
+template<typename T, sparse_major Major = sparse_major::row>
+class sparse_matrix
+{
+public:
+  //! @brief Value type.
+  using value_type = T;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention (column index, row index).
+  using position_type = std::pair<size_type, size_type>;
+  //! @brief Pair of position and value.
+  using entry_type = std::pair<position_type, T>;
+
+  //! @brief Order of compression.
+  static constexpr sparse_major major {Major};
+
+  /**
+   * @brief Default constructor for empty matrix.
+   *
+   * @post row_size() == 0
+   * @post col_size() == 0
+   */
+  sparse_matrix();
+
+  /**
+   * @brief Construct zero matrix.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  sparse_matrix(size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by entries.
+   *
+   * Values of same position are summed, and zero values are not stored.
+   *
+   * @pre All positions are in the matrix.
+   *
+   * @param[in] entries Pairs of position and value in any order.
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  sparse_matrix(std::vector<entry_type> entries, size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by compressed arrays.
+   *
+   * @pre outer_index.size() is count of rows (CSR) or columns (CSC) + 1.
+   * @pre outer_index is ascending from 0 to values.size().
+   * @pre inner_index.size() == values.size()
+   * @pre inner_index is ascending in each row (CSR) or column (CSC).
+   *
+   * @param[in] outer_index Start offsets of each row (CSR) or column (CSC).
+   * @param[in] inner_index Column (CSR) or row (CSC) index of each element.
+   * @param[in] values Stored elements.
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  sparse_matrix(std::vector<size_type> outer_index, std::vector<size_type> inner_index, std::vector<T> values,
+                size_type row_size, size_type col_size);
+
+  /**
+   * @brief Construct by nonzero elements of valmatrix.
+   *
+   * @param[in] m Dense matrix.
+   */
+  explicit sparse_matrix(const valmatrix<T>& m);
+
+  /**
+   * @brief Convert order of compression.
+   *
+   * @param[in] other Sparse matrix of other order.
+   */
+  template<sparse_major Other, typename = std::enable_if_t<Other != Major>>
+  explicit sparse_matrix(const sparse_matrix<T, Other>& other);
+
+  /**
+   * @brief Get element.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point.
+   * @return Value of element, or zero if it is not stored.
+   */
+  T operator[](position_type position) const;
+
+  /**
+   * @brief Apply - operator to each nonzero element.
+   *
+   * @return The matrix that each elements are negative.
+   */
+  sparse_matrix operator-() const;
+
+  /**
+   * @brief Multiplication assign to each nonzero element.
+   *
+   * Elements that become zero are removed.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  sparse_matrix& operator*=(const T& rhs) &;
+
+  /**
+   * @brief Divition assign to each nonzero element.
+   *
+   * Elements that become zero are removed.
+   *
+   * @param[in] rhs Value.
+   * @return This reference.
+   */
+  sparse_matrix& operator/=(const T& rhs) &;
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get count of stored elements.
+   *
+   * @return Count of nonzero elements.
+   */
+  size_type nonzero_size() const noexcept;
+
+  /**
+   * @brief Get start offsets of each row (CSR) or column (CSC).
+   *
+   * @return Offsets that size is count of rows or columns + 1.
+   */
+  const std::vector<size_type>& outer_index() const noexcept;
+
+  /**
+   * @brief Get column (CSR) or row (CSC) index of each stored element.
+   *
+   * Indices are ascending in each row or column.
+   *
+   * @return Indices that size is nonzero_size().
+   */
+  const std::vector<size_type>& inner_index() const noexcept;
+
+  /**
+   * @brief Get stored elements.
+   *
+   * @return Values that size is nonzero_size().
+   */
+  const std::vector<T>& values() const noexcept;
+
+  /**
+   * @brief Call "function(row, column, value)" for each stored element.
+   *
+   * @param[in] function Function object.
+   */
+  template<typename F>
+  void for_each(F function) const;
+
+private:
+  static position_type to_outer_inner(position_type position) noexcept;
+
+  size_type outer_size() const noexcept;
+
+  void erase_zeros();
+
+  position_type size_;
+  std::vector<size_type> outer_;
+  std::vector<size_type> inner_;
+  std::vector<T> values_;
+};
+
+//! @brief Compressed sparse row matrix.
+template<typename T>
+using csr_matrix = sparse_matrix<T, sparse_major::row>;
+
+//! @brief Compressed sparse column matrix.
+template<typename T>
+using csc_matrix = sparse_matrix<T, sparse_major::column>;
+
+/**
+ * @brief Create valmatrix from sparse matrix.
+ *
+ * @param[in] m Sparse matrix.
+ * @return Dense matrix.
+ */
+template<typename T, sparse_major Major>
+valmatrix<T> to_valmatrix(const sparse_matrix<T, Major>& m);
+
+/**
+ * @brief Return product of sparse matrix and vector.
+ *
+ * @pre a.row_size() == x.size()
+ *
+ * @param[in] a Sparse matrix.
+ * @param[in] x Dense vector.
+ * @return Vector "a x" that size is a.col_size().
+ */
+template<typename T, sparse_major Major>
+std::valarray<T> matmul(const sparse_matrix<T, Major>& a, const std::valarray<T>& x);
+
+/**
+ * @brief Return product of sparse matrix and dense matrix.
+ *
+ * @pre a.row_size() == b.col_size()
+ *
+ * @param[in] a Sparse matrix.
+ * @param[in] b Dense matrix.
+ * @return Dense matrix "a b".
+ */
+template<typename T, sparse_major Major>
+valmatrix<T> matmul(const sparse_matrix<T, Major>& a, const valmatrix<T>& b);
+
+/**
+ * @brief Return product of dense matrix and sparse matrix.
+ *
+ * @pre a.row_size() == b.col_size()
+ *
+ * @param[in] a Dense matrix.
+ * @param[in] b Sparse matrix.
+ * @return Dense matrix "a b".
+ */
+template<typename T, sparse_major Major>
+valmatrix<T> matmul(const valmatrix<T>& a, const sparse_matrix<T, Major>& b);
+
+/**
+ * @brief Addition operator for sparse matrix.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Sparse matrix of union of nonzero elements.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator+(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs);
+
+/**
+ * @brief Subtraction operator for sparse matrix.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Sparse matrix of union of nonzero elements.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator-(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs);
+
+/**
+ * @brief Element-wise multiplication operator for sparse matrix.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Sparse matrix of intersection of nonzero elements.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator*(const sparse_matrix<T, Major>& lhs, const sparse_matrix<T, Major>& rhs);
+
+/**
+ * @brief Element-wise multiplication operator for sparse matrix with dense matrix.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value that is dense.
+ * @return Sparse matrix that has nonzero elements of lhs at most.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator*(const sparse_matrix<T, Major>& lhs, const valmatrix<T>& rhs);
+
+/**
+ * @brief Multiplication operator for sparse matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator*(sparse_matrix<T, Major> lhs, const T& rhs);
+
+/**
+ * @brief Multiplication operator for value with sparse matrix.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of multiplication.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator*(const T& lhs, sparse_matrix<T, Major> rhs);
+
+/**
+ * @brief Divition operator for sparse matrix with value.
+ *
+ * @param[in] lhs Left hand side value.
+ * @param[in] rhs Right hand side value.
+ * @return Result of divition.
+ */
+template<typename T, sparse_major Major>
+sparse_matrix<T, Major> operator/(sparse_matrix<T, Major> lhs, const T& rhs);
+
+/**
+ * @brief Addition assign sparse matrix to dense matrix.
+ *
+ * Only nonzero elements of rhs are touched.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Dense matrix.
+ * @param[in] rhs Sparse matrix.
+ * @return Reference of lhs.
+ */
+template<typename T, sparse_major Major>
+valmatrix<T>& operator+=(valmatrix<T>& lhs, const sparse_matrix<T, Major>& rhs);
+
+/**
+ * @brief Subtraction assign sparse matrix to dense matrix.
+ *
+ * Only nonzero elements of rhs are touched.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Dense matrix.
+ * @param[in] rhs Sparse matrix.
+ * @return Reference of lhs.
+ */
+template<typename T, sparse_major Major>
+valmatrix<T>& operator-=(valmatrix<T>& lhs, const sparse_matrix<T, Major>& rhs);
+
+}
+
+#include "detail/sparse_matrix.hpp"
+
+#endif
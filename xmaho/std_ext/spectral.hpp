@@ -0,0 +1,207 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_SPECTRAL_H
+#define XMAHO_STD_EXT_SPECTRAL_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <valarray>
+#include <vector>
+
+/**
+ * @file std_ext/spectral.hpp
+ * @brief The eigenvalue and singular value decompositions for valmatrix.
+ *
+ * Each class can be constructed empty and compute() can be called repeatedly.
+ * The results and the workspace are kept between calls,
+ * so matrices of the same dimention are decomposed without allocation.
+ *
+ * @code
+ * symmetric_eigen_decomposition<double> eigen {};
+ * singular_value_decomposition<double> svd {};
+ * for (const auto& a : matrices) {
+ *   eigen.compute(a);
+ *   svd.compute(a);
+ *   const auto condition {svd.singular_values()[0] / svd.singular_values()[svd.rank_size() - 1]};
+ * }
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Eigendecomposition "A = V diag(w) V^T" of symmetric matrix.
+ *
+ * The matrix is reduced to tridiagonal form by Householder reflections,
+ * and the tridiagonal matrix is diagonalized by implicit QL iteration with shifts.
+ *
+ * @tparam T Floating point type.
+ */
+template<typename T>
+class symmetric_eigen_decomposition
+{
+  static_assert(std::is_floating_point_v<T>, "symmetric_eigen_decomposition requires floating point type.");
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  //! @brief Construct without decomposition.
+  symmetric_eigen_decomposition() = default;
+
+  /**
+   * @brief Decompose symmetric matrix.
+   *
+   * @pre a.row_size() == a.col_size()
+   * @pre a is symmetric.
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error The iteration doesn't converge.
+   */
+  explicit symmetric_eigen_decomposition(const valmatrix<T>& a);
+
+  /**
+   * @brief Decompose symmetric matrix reusing the storage of the previous call.
+   *
+   * @pre a.row_size() == a.col_size()
+   * @pre a is symmetric.
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error The iteration doesn't converge.
+   */
+  void compute(const valmatrix<T>& a);
+
+  /**
+   * @brief Get eigenvalues.
+   *
+   * @return Eigenvalues in ascending order.
+   */
+  const std::valarray<T>& eigenvalues() const noexcept;
+
+  /**
+   * @brief Get eigenvectors.
+   *
+   * @return Orthogonal matrix that column i is the eigenvector of eigenvalues()[i].
+   */
+  const valmatrix<T>& eigenvectors() const noexcept;
+
+  /**
+   * @brief Get order of A.
+   *
+   * @return Count of rows and columns.
+   */
+  size_type order() const noexcept;
+
+private:
+  std::valarray<T> values_;
+  valmatrix<T> vectors_;
+  std::vector<T> off_diagonal_;
+};
+
+/**
+ * @brief Singular value decomposition "A = U diag(s) V^T".
+ *
+ * One-sided Jacobi rotations orthogonalize the rows or columns of A,
+ * whichever are fewer, and the rotated vectors are contiguous in the workspace.
+ * Small singular values are computed with high relative accuracy.
+ * Singular vectors of zero singular values that A doesn't determine are zero.
+ *
+ * @tparam T Floating point type.
+ */
+template<typename T>
+class singular_value_decomposition
+{
+  static_assert(std::is_floating_point_v<T>, "singular_value_decomposition requires floating point type.");
+public:
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  //! @brief Construct without decomposition.
+  singular_value_decomposition() = default;
+
+  /**
+   * @brief Decompose matrix.
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error The iteration doesn't converge.
+   */
+  explicit singular_value_decomposition(const valmatrix<T>& a);
+
+  /**
+   * @brief Decompose matrix reusing the storage of the previous call.
+   *
+   * @param[in] a Target matrix.
+   * @exception std::domain_error The iteration doesn't converge.
+   */
+  void compute(const valmatrix<T>& a);
+
+  /**
+   * @brief Get singular values.
+   *
+   * @return Singular values in descending order that size is rank_size().
+   */
+  const std::valarray<T>& singular_values() const noexcept;
+
+  /**
+   * @brief Get left singular vectors.
+   *
+   * @return U that has A's rows and rank_size() columns.
+   */
+  const valmatrix<T>& u() const noexcept;
+
+  /**
+   * @brief Get right singular vectors.
+   *
+   * @return V that has A's columns and rank_size() columns.
+   */
+  const valmatrix<T>& v() const noexcept;
+
+  /**
+   * @brief Get count of singular values.
+   *
+   * @return Minimum of A's rows and columns.
+   */
+  size_type rank_size() const noexcept;
+
+private:
+  std::valarray<T> values_;
+  valmatrix<T> u_;
+  valmatrix<T> v_;
+  std::vector<T> work_;
+  std::vector<T> rotation_;
+  std::vector<size_type> order_;
+};
+
+}
+
+#include "detail/spectral.hpp"
+
+#endif
@@ -0,0 +1,147 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_SUMMATION_H
+#define XMAHO_STD_EXT_SUMMATION_H
+
+#include "parallel.hpp"
+#include "valmatrix.hpp"
+
+#include <valarray>
+
+/**
+ * @file std_ext/summation.hpp
+ * @brief The summations of valarray and valmatrix with selectable accuracy.
+ *
+ * std::valarray::sum() adds the elements one by one,
+ * so the rounding error of float grows linearly with the count of elements.
+ * Pairwise summation bounds the error by the logarithm of the count at the same speed,
+ * and Kahan summation bounds it by a constant at a few times of the cost.
+ * The overloads with parallel_context sum a chunk per thread with the method,
+ * and combine the partial sums in the same way.
+ *
+ * @code
+ * const std::valarray<float> v(0.1f, 10000000);
+ * const auto naive {v.sum()};                                       // 1087937
+ * const auto accurate {sum(v, summation_method::kahan)};            // 1000000
+ * parallel_context context {};
+ * const auto fast {sum(context, v, summation_method::pairwise)};    // about 1000000
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The algorithm of summation.
+ *
+ * Types except floating point are summed in order for all methods.
+ */
+enum class summation_method
+{
+  naive,    //!< Add elements in order.
+  pairwise, //!< Add halves recursively. Error grows in O(log n).
+  kahan     //!< Add with compensation of rounding error. Error is O(1).
+};
+
+/**
+ * @brief Get sum of elements.
+ *
+ * @param[in] v Target array.
+ * @param[in] method Algorithm of summation.
+ * @return Sum of elements. Empty array is T{}.
+ */
+template<typename T>
+T sum(const std::valarray<T>& v, summation_method method);
+
+/**
+ * @brief Get sum of elements.
+ *
+ * @param[in] m Target matrix.
+ * @param[in] method Algorithm of summation.
+ * @return Sum of elements. Empty matrix is T{}.
+ */
+template<typename T>
+T sum(const valmatrix<T>& m, summation_method method);
+
+/**
+ * @brief Get sum of elements in parallel.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] v Target array.
+ * @param[in] method Algorithm of summation.
+ * @return Sum of elements. Empty array is T{}.
+ */
+template<typename T>
+T sum(parallel_context& context, const std::valarray<T>& v, summation_method method);
+
+/**
+ * @brief Get sum of elements in parallel.
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] m Target matrix.
+ * @param[in] method Algorithm of summation.
+ * @return Sum of elements. Empty matrix is T{}.
+ */
+template<typename T>
+T sum(parallel_context& context, const valmatrix<T>& m, summation_method method);
+
+/**
+ * @brief Return inner product "a * b" without temporary array.
+ *
+ * Each product is rounded before the summation.
+ *
+ * @pre a.size() == b.size()
+ *
+ * @param[in] a lhs value.
+ * @param[in] b rhs value.
+ * @param[in] method Algorithm of summation.
+ * @return The inner product by a and b.
+ */
+template<typename T>
+T inner_product(const std::valarray<T>& a, const std::valarray<T>& b, summation_method method);
+
+/**
+ * @brief Return inner product "a * b" in parallel.
+ *
+ * @pre a.size() == b.size()
+ *
+ * @param[in] context Parallel execution context.
+ * @param[in] a lhs value.
+ * @param[in] b rhs value.
+ * @param[in] method Algorithm of summation.
+ * @return The inner product by a and b.
+ */
+template<typename T>
+T inner_product(parallel_context& context, const std::valarray<T>& a, const std::valarray<T>& b, summation_method method);
+
+}
+
+#include "detail/summation.hpp"
+
+#endif
@@ -0,0 +1,151 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_SUMMED_AREA_TABLE_H
+#define XMAHO_STD_EXT_SUMMED_AREA_TABLE_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file std_ext/summed_area_table.hpp
+ * @brief The summed-area table (integral image) of valmatrix.
+ *
+ * The table is built in one pass over the matrix,
+ * and the sum of any block is got from four elements of the table
+ * instead of copying the block through gslice.
+ *
+ * @code
+ * const valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2}; // 2 rows, 3 columns
+ * const summed_area_table<int> table {m};
+ * const auto s {table.sum({1, 0}, {2, 2})};        // 2 + 3 + 5 + 6 = 16
+ * @endcode
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Two dimensional prefix sums of valmatrix.
+ *
+ * Element (x, y) of the table holds the sum of the block
+ * from (0, 0) to (x - 1, y - 1) of the source matrix.
+ * The first row and column of the table are zero.
+ *
+ * @note Floating point sums of small blocks are differences of large prefix sums,
+ *       so their absolute error grows with the sum of the whole matrix.
+ *
+ * @tparam T Value type. Prefix sums must not overflow T.
+ */
+template<typename T>
+class summed_area_table
+{
+public:
+  //! @brief Value type.
+  using value_type = T;
+
+  //! @brief Size type.
+  using size_type = std::size_t;
+
+  //! @brief Position type (x:column, y:row).
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Build table of matrix.
+   *
+   * @param[in] m Source matrix.
+   */
+  explicit summed_area_table(const valmatrix<T>& m);
+
+  /**
+   * @brief Get sum of block.
+   *
+   * This is equal to m.block(pos, size).sum() for nonempty block, and costs constant time.
+   *
+   * @pre pos.first + size.first <= row_size()
+   * @pre pos.second + size.second <= col_size()
+   *
+   * @param[in] pos Block's top left index.
+   * @param[in] size Block's size.
+   * @return Sum of block. Empty block is T{}.
+   */
+  T sum(position_type pos, position_type size) const;
+
+  /**
+   * @brief Get sum of whole matrix.
+   *
+   * @return Sum of all elements.
+   */
+  T sum() const;
+
+  /**
+   * @brief Rebuild table after rows of matrix changed.
+   *
+   * Prefix sums of the rows above first are reused,
+   * and the rest are computed again from m.
+   *
+   * @pre m.row_size() == row_size() && m.col_size() == col_size()
+   * @pre first <= col_size()
+   *
+   * @param[in] m Changed source matrix.
+   * @param[in] first Index of the first changed row.
+   */
+  void update(const valmatrix<T>& m, size_type first);
+
+  /**
+   * @brief Get count of columns of source matrix.
+   *
+   * @return Count of columns.
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get count of rows of source matrix.
+   *
+   * @return Count of rows.
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get prefix sums.
+   *
+   * @return Table that has one more row and column than source matrix.
+   */
+  const valmatrix<T>& table() const noexcept;
+
+private:
+  valmatrix<T> table_;
+};
+
+}
+
+#include "detail/summed_area_table.hpp"
+
+#endif
@@ -0,0 +1,82 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_TRANSPOSE_H
+#define XMAHO_STD_EXT_TRANSPOSE_H
+
+#include "valmatrix.hpp"
+
+/**
+ * @file std_ext/transpose.hpp
+ * @brief The matrix transpose for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Return transposed matrix.
+ *
+ * The matrix is divided recursively until tiles fit in cache,
+ * so both reading and writing stay local for any size.
+ *
+ * @post result.row_size() == m.col_size()
+ * @post result.col_size() == m.row_size()
+ *
+ * @param[in] m Target matrix.
+ * @return Transposed matrix.
+ *
+ * @code
+ * const valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2}; // 2 rows, 3 columns
+ * const auto t {transpose(m)};                       // {1, 4, 2, 5, 3, 6}
+ * assert(t.row_size() == 2 && t.col_size() == 3);
+ * @endcode
+ */
+template<typename T>
+valmatrix<T> transpose(const valmatrix<T>& m);
+
+/**
+ * @brief Transpose matrix in place.
+ *
+ * Square matrix swaps recursively divided tiles.
+ * Rectangular matrix follows permutation cycles with one bit of work space per element.
+ *
+ * @post m.row_size() is old m.col_size()
+ * @post m.col_size() is old m.row_size()
+ *
+ * @param[in,out] m Target matrix.
+ * @return Reference of m.
+ */
+template<typename T>
+valmatrix<T>& transpose_in_place(valmatrix<T>& m);
+
+}
+
+#include "detail/transpose.hpp"
+
+#endif
@@ -0,0 +1,361 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_TRANSPOSED_H
+#define XMAHO_STD_EXT_TRANSPOSED_H
+
+#include "matmul.hpp"
+#include "valmatrix.hpp"
+#include "valmatrix_expression.hpp"
+
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file std_ext/transposed.hpp
+ * @brief The lazy transposed view for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief The read only transposed view of valmatrix.
+ *
+ * This class swaps dimention and index mapping without moving elements.
+ * matmul reads it as strided operand, compound assignments and lazy expressions
+ * traverse it tile by tile, and reductions read the original storage in order.
+ *
+ * @note
+ * This class hold reference to the original matrix.
+ * Assigning expression that refers this view to the original matrix evaluates
+ * it into temporary.
+ *
+ * @code
+ * const valmatrix<double> a(1., 3, 2);     // 2 rows, 3 columns
+ * const auto at {transposed(a)};           // 3 rows, 2 columns
+ * const auto gram {matmul(at, a)};         // "A^T A" without copy of A^T
+ * valmatrix<double> b {lazy(at) * 2.};     // tiled evaluation
+ * @endcode
+ *
+ * @tparam T Value type of valmatrix.
+ */
+template<typename T>
+class transposed_view
+{
+public:
+  //! @brief Value type.
+  using value_type = T;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Construct by original matrix.
+   *
+   * @param[in] base Original matrix.
+   */
+  explicit transposed_view(const valmatrix<T>& base) noexcept;
+
+  /**
+   * @brief Access by serial index of transposed matrix.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index.
+   * @return Const reference of access point.
+   */
+  const T& operator[](size_type index) const;
+
+  /**
+   * @brief Access by position of transposed matrix.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point (column index, row index).
+   * @return Const reference of access point.
+   */
+  const T& operator[](position_type position) const;
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column, that is base().col_size().
+   */
+  size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row, that is base().row_size().
+   */
+  size_type col_size() const noexcept;
+
+  /**
+   * @brief Get count of elements.
+   *
+   * @return row_size() * col_size()
+   */
+  size_type size() const noexcept;
+
+  /**
+   * @brief Get sum of elements.
+   *
+   * @return Sum of elements.
+   */
+  T sum() const;
+
+  /**
+   * @brief Get minimum element.
+   *
+   * @pre 0 < size()
+   *
+   * @return Minimum element.
+   */
+  T min() const;
+
+  /**
+   * @brief Get maximum element.
+   *
+   * @pre 0 < size()
+   *
+   * @return Maximum element.
+   */
+  T max() const;
+
+  /**
+   * @brief Get original matrix.
+   *
+   * @return Reference of original matrix.
+   */
+  const valmatrix<T>& base() const noexcept;
+
+private:
+  const valmatrix<T>* base_;
+};
+
+/**
+ * @brief Get transposed view of valmatrix.
+ *
+ * @param[in] m Original matrix.
+ * @return Transposed view.
+ */
+template<typename T>
+transposed_view<T> transposed(const valmatrix<T>& m) noexcept;
+
+/**
+ * @brief Get transposed matrix of transposed view.
+ *
+ * @param[in] m Transposed view.
+ * @return Reference of original matrix.
+ */
+template<typename T>
+const valmatrix<T>& transposed(const transposed_view<T>& m) noexcept;
+
+/**
+ * @brief Create valmatrix from transposed view.
+ *
+ * @param[in] m Transposed view.
+ * @return Transposed copy of original matrix.
+ */
+template<typename T>
+valmatrix<T> to_valmatrix(const transposed_view<T>& m);
+
+/**
+ * @brief Return matrix product with transposed left hand side.
+ *
+ * @pre a.row_size() == b.col_size()
+ *
+ * @param[in] a Left hand side transposed matrix.
+ * @param[in] b Right hand side matrix.
+ * @return The matrix product.
+ */
+template<typename T>
+valmatrix<T> matmul(const transposed_view<T>& a, const valmatrix<T>& b);
+
+/**
+ * @brief Return matrix product with transposed right hand side.
+ *
+ * @pre a.row_size() == b.col_size()
+ *
+ * @param[in] a Left hand side matrix.
+ * @param[in] b Right hand side transposed matrix.
+ * @return The matrix product.
+ */
+template<typename T>
+valmatrix<T> matmul(const valmatrix<T>& a, const transposed_view<T>& b);
+
+/**
+ * @brief Return matrix product of transposed matrices.
+ *
+ * @pre a.row_size() == b.col_size()
+ *
+ * @param[in] a Left hand side transposed matrix.
+ * @param[in] b Right hand side transposed matrix.
+ * @return The matrix product.
+ */
+template<typename T>
+valmatrix<T> matmul(const transposed_view<T>& a, const transposed_view<T>& b);
+
+/**
+ * @brief Addition assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator+=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Subtraction assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator-=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Multiplication assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator*=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Divition assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator/=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Residue assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator%=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Bitwise and assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator&=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Bitwise or assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator|=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Xor assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator^=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Shift assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator<<=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+/**
+ * @brief Counter shift assign transposed matrix to each element.
+ *
+ * @pre lhs.row_size() == rhs.row_size()
+ * @pre lhs.col_size() == rhs.col_size()
+ *
+ * @param[in,out] lhs Target matrix.
+ * @param[in] rhs Transposed matrix.
+ * @return Reference of lhs.
+ */
+template<typename T>
+valmatrix<T>& operator>>=(valmatrix<T>& lhs, const transposed_view<T>& rhs);
+
+}
+
+#include "detail/transposed.hpp"
+
+#endif
@@ -41,6 +41,115 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace xmaho::std_ext
 {
 
+template<typename E>
+class valmatrix_expression;
+
+/**
+ * @brief Layout policy that stores elements row by row.
+ *
+ * The element of row r and column c is stored at `r * row_size + c`.
+ * This is the default layout of valmatrix.
+ */
+struct row_major
+{
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Get serial index of position.
+   *
+   * @param[in] position Position that is {column, row}.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Serial index in the storage.
+   */
+  static constexpr size_type index(position_type position, position_type size) noexcept;
+
+  /**
+   * @brief Get slice of row.
+   *
+   * @param[in] index Row index.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Slice which selects the row.
+   */
+  static std::slice row(size_type index, position_type size) noexcept;
+
+  /**
+   * @brief Get slice of column.
+   *
+   * @param[in] index Column index.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Slice which selects the column.
+   */
+  static std::slice col(size_type index, position_type size) noexcept;
+
+  /**
+   * @brief Get gslice of block.
+   *
+   * The selected elements are ordered by this layout.
+   *
+   * @param[in] pos Block's top left position.
+   * @param[in] sub_size Block's size.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Gslice which selects the block.
+   */
+  static std::gslice block(position_type pos, position_type sub_size, position_type size);
+};
+
+/**
+ * @brief Layout policy that stores elements column by column.
+ *
+ * The element of row r and column c is stored at `c * col_size + r`.
+ * Column access is contiguous and row access is strided.
+ */
+struct column_major
+{
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  /**
+   * @brief Get serial index of position.
+   *
+   * @param[in] position Position that is {column, row}.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Serial index in the storage.
+   */
+  static constexpr size_type index(position_type position, position_type size) noexcept;
+
+  /**
+   * @brief Get slice of row.
+   *
+   * @param[in] index Row index.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Slice which selects the row.
+   */
+  static std::slice row(size_type index, position_type size) noexcept;
+
+  /**
+   * @brief Get slice of column.
+   *
+   * @param[in] index Column index.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Slice which selects the column.
+   */
+  static std::slice col(size_type index, position_type size) noexcept;
+
+  /**
+   * @brief Get gslice of block.
+   *
+   * The selected elements are ordered by this layout.
+   *
+   * @param[in] pos Block's top left position.
+   * @param[in] sub_size Block's size.
+   * @param[in] size Matrix size that is {row_size, col_size}.
+   * @return Gslice which selects the block.
+   */
+  static std::gslice block(position_type pos, position_type sub_size, position_type size);
+};
+
 /**
  * @brief The adapter class for matrix valarray.
  *
@@ -50,9 +159,14 @@ namespace xmaho::std_ext
  *
  * @invariant size() == row_size() * col_size()
  *
+ * Element-wise operations work on the storage order,
+ * so operands of them must have same layout.
+ * Position access, row(), col() and block() follow the layout.
+ *
  * @tparam T Value type of valarray.
+ * @tparam Layout Storage order that is row_major or column_major.
  */
-template<typename T>
+template<typename T, typename Layout = row_major>
 class valmatrix : std::valarray<T>
 {
 public:
@@ -62,6 +176,8 @@ public:
   using size_type = std::size_t;
   //! @brief Specific position type for two dimention.
   using position_type = std::pair<size_type, size_type>;
+  //! @brief Storage order of elements.
+  using layout_type = Layout;
 
   /**
    * @brief Default constructor for empty valmatrix.
@@ -131,6 +247,26 @@ public:
    */
   valmatrix(std::valarray<T>&& values, size_type row_size, size_type col_size);
 
+  /**
+   * @brief Construct by evaluating lazy expression.
+   *
+   * All elements are computed in a single loop.
+   *
+   * @param[in] expression Expression of valmatrix_expression.hpp.
+   */
+  template<typename E>
+  valmatrix(const valmatrix_expression<E>& expression);
+
+  /**
+   * @brief Construct by matrix of other layout.
+   *
+   * Same position has same value, but the storage order is changed.
+   *
+   * @param[in] other Matrix of other layout.
+   */
+  template<typename OtherLayout>
+  explicit valmatrix(const valmatrix<T, OtherLayout>& other);
+
   //! @brief Default copy constructor for overload.
   valmatrix(const valmatrix&) = default;
   //! @brief Default move constructor for overload.
@@ -168,6 +304,22 @@ public:
    */
   valmatrix& operator=(const T& rhs) &;
 
+  /**
+   * @brief Assign by evaluating lazy expression.
+   *
+   * All elements are computed in a single loop and the storage is reused.
+   * The expression may refer this matrix.
+   * When it reads transposed view of this matrix, it is evaluated into temporary.
+   *
+   * @pre row_size() == expression.row_size()
+   * @pre col_size() == expression.col_size()
+   *
+   * @param[in] expression Expression of valmatrix_expression.hpp.
+   * @return This reference.
+   */
+  template<typename E>
+  valmatrix& operator=(const valmatrix_expression<E>& expression) &;
+
   /**
    * @brief Access by position.
    *
@@ -611,6 +763,38 @@ public:
    */
   auto end() noexcept;
 
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * Elements are stored in order of Layout.
+   * The element of row r and column c is `data()[Layout::index({c, r}, {row_size(), col_size()})]`.
+   *
+   * @return Const pointer to first element, or nullptr if empty.
+   */
+  const T* data() const noexcept;
+
+  /**
+   * @brief Get pointer to the contiguous storage.
+   *
+   * Elements are stored in order of Layout.
+   * The element of row r and column c is `data()[Layout::index({c, r}, {row_size(), col_size()})]`.
+   *
+   * @return Pointer to first element, or nullptr if empty.
+   */
+  T* data() noexcept;
+
+  /**
+   * @brief Change dimention without moving elements.
+   *
+   * @note If either value is 0, set 0 to both values.
+   *
+   * @pre row_size * col_size == size()
+   *
+   * @param[in] row_size Row size.
+   * @param[in] col_size Column size.
+   */
+  void reshape(size_type row_size, size_type col_size) noexcept;
+
   /**
    * @brief Swap objects.
    *
@@ -639,8 +823,8 @@ private:
  * @param[in] rhs Right hand side value.
  * @return Result of addition.
  */
-template<typename T>
-valmatrix<T> operator+(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator+(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Addition operator for valmatrix with valarray.
@@ -651,8 +835,8 @@ valmatrix<T> operator+(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of addition.
  */
-template<typename T>
-valmatrix<T> operator+(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator+(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Addition operator for valmatrix with value.
@@ -661,8 +845,8 @@ valmatrix<T> operator+(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of addition.
  */
-template<typename T>
-valmatrix<T> operator+(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator+(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Addition operator for valmatrix with valarray.
@@ -673,8 +857,8 @@ valmatrix<T> operator+(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of addition.
  */
-template<typename T>
-valmatrix<T> operator+(const std::valarray<T>& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator+(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Addition operator for valmatrix with value.
@@ -683,8 +867,8 @@ valmatrix<T> operator+(const std::valarray<T>& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of addition.
  */
-template<typename T>
-valmatrix<T> operator+(const T& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator+(const T& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Subtraction operator for valmatrix.
@@ -696,8 +880,8 @@ valmatrix<T> operator+(const T& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of subtraction.
  */
-template<typename T>
-valmatrix<T> operator-(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Subtraction operator for valmatrix with valarray.
@@ -708,8 +892,8 @@ valmatrix<T> operator-(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of subtraction.
  */
-template<typename T>
-valmatrix<T> operator-(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Subtraction operator for valmatrix with value.
@@ -718,8 +902,8 @@ valmatrix<T> operator-(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of subtraction.
  */
-template<typename T>
-valmatrix<T> operator-(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Subtraction operator for valmatrix with valarray.
@@ -730,8 +914,8 @@ valmatrix<T> operator-(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of subtraction.
  */
-template<typename T>
-valmatrix<T> operator-(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Subtraction operator for valmatrix with value.
@@ -740,8 +924,34 @@ valmatrix<T> operator-(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of subtraction.
  */
-template<typename T>
-valmatrix<T> operator-(const T& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(const T& lhs, const valmatrix<T, Layout>& rhs);
+
+/**
+ * @brief Subtraction operator for valmatrix with valarray.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @pre lhs.size() == rhs.size()
+ *
+ * @param[in] lhs Left hand side value that is valarray.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of subtraction.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs);
+
+/**
+ * @brief Subtraction operator for valmatrix with value.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @param[in] lhs Left hand side value that is value.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of subtraction.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator-(const T& lhs, valmatrix<T, Layout>&& rhs);
 
 /**
  * @brief Multiplication operator for valmatrix.
@@ -753,8 +963,8 @@ valmatrix<T> operator-(const T& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of multiplication.
  */
-template<typename T>
-valmatrix<T> operator*(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator*(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Multiplication operator for valmatrix with valarray.
@@ -765,8 +975,8 @@ valmatrix<T> operator*(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of multiplication.
  */
-template<typename T>
-valmatrix<T> operator*(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator*(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Multiplication operator for valmatrix with value.
@@ -775,8 +985,8 @@ valmatrix<T> operator*(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of multiplication.
  */
-template<typename T>
-valmatrix<T> operator*(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator*(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Multiplication operator for valmatrix with valarray.
@@ -787,8 +997,8 @@ valmatrix<T> operator*(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of multiplication.
  */
-template<typename T>
-valmatrix<T> operator*(const std::valarray<T>& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator*(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Multiplication operator for valmatrix with value.
@@ -797,8 +1007,8 @@ valmatrix<T> operator*(const std::valarray<T>& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of multiplication.
  */
-template<typename T>
-valmatrix<T> operator*(const T& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator*(const T& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Divition operator for valmatrix.
@@ -810,8 +1020,8 @@ valmatrix<T> operator*(const T& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of divition.
  */
-template<typename T>
-valmatrix<T> operator/(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Divition operator for valmatrix with valarray.
@@ -822,8 +1032,8 @@ valmatrix<T> operator/(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of divition.
  */
-template<typename T>
-valmatrix<T> operator/(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Divition operator for valmatrix with value.
@@ -832,8 +1042,8 @@ valmatrix<T> operator/(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of divition.
  */
-template<typename T>
-valmatrix<T> operator/(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Divition operator for valmatrix with valarray.
@@ -844,8 +1054,8 @@ valmatrix<T> operator/(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of divition.
  */
-template<typename T>
-valmatrix<T> operator/(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Divition operator for valmatrix with value.
@@ -854,8 +1064,34 @@ valmatrix<T> operator/(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of divition.
  */
-template<typename T>
-valmatrix<T> operator/(const T& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(const T& lhs, const valmatrix<T, Layout>& rhs);
+
+/**
+ * @brief Divition operator for valmatrix with valarray.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @pre lhs.size() == rhs.size()
+ *
+ * @param[in] lhs Left hand side value that is valarray.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of divition.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs);
+
+/**
+ * @brief Divition operator for valmatrix with value.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @param[in] lhs Left hand side value that is value.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of divition.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator/(const T& lhs, valmatrix<T, Layout>&& rhs);
 
 /**
  * @brief Residue operator for valmatrix.
@@ -867,8 +1103,8 @@ valmatrix<T> operator/(const T& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of residue.
  */
-template<typename T>
-valmatrix<T> operator%(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Residue operator for valmatrix with valarray.
@@ -879,8 +1115,8 @@ valmatrix<T> operator%(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of residue.
  */
-template<typename T>
-valmatrix<T> operator%(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Residue operator for valmatrix with value.
@@ -889,8 +1125,8 @@ valmatrix<T> operator%(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of residue.
  */
-template<typename T>
-valmatrix<T> operator%(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Residue operator for valmatrix with valarray.
@@ -901,8 +1137,8 @@ valmatrix<T> operator%(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of residue.
  */
-template<typename T>
-valmatrix<T> operator%(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Residue operator for valmatrix with value.
@@ -911,8 +1147,34 @@ valmatrix<T> operator%(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of residue.
  */
-template<typename T>
-valmatrix<T> operator%(const T& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(const T& lhs, const valmatrix<T, Layout>& rhs);
+
+/**
+ * @brief Residue operator for valmatrix with valarray.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @pre lhs.size() == rhs.size()
+ *
+ * @param[in] lhs Left hand side value that is valarray.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of residue.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs);
+
+/**
+ * @brief Residue operator for valmatrix with value.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @param[in] lhs Left hand side value that is value.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of residue.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator%(const T& lhs, valmatrix<T, Layout>&& rhs);
 
 /**
  * @brief Bitwise and operator for valmatrix.
@@ -924,8 +1186,8 @@ valmatrix<T> operator%(const T& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of bitwise and.
  */
-template<typename T>
-valmatrix<T> operator&(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator&(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Bitwise and operator for valmatrix with valarray.
@@ -936,8 +1198,8 @@ valmatrix<T> operator&(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of bitwise and.
  */
-template<typename T>
-valmatrix<T> operator&(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator&(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Bitwise and operator for valmatrix with value.
@@ -946,8 +1208,8 @@ valmatrix<T> operator&(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of bitwise and.
  */
-template<typename T>
-valmatrix<T> operator&(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator&(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Bitwise and operator for valmatrix with valarray.
@@ -958,8 +1220,8 @@ valmatrix<T> operator&(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of bitwise and.
  */
-template<typename T>
-valmatrix<T> operator&(const std::valarray<T>& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator&(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Bitwise and operator for valmatrix with value.
@@ -968,8 +1230,8 @@ valmatrix<T> operator&(const std::valarray<T>& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of bitwise and.
  */
-template<typename T>
-valmatrix<T> operator&(const T& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator&(const T& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Bitwise or operator for valmatrix.
@@ -981,8 +1243,8 @@ valmatrix<T> operator&(const T& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of bitwise or.
  */
-template<typename T>
-valmatrix<T> operator|(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator|(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Bitwise or operator for valmatrix with valarray.
@@ -993,8 +1255,8 @@ valmatrix<T> operator|(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of bitwise or.
  */
-template<typename T>
-valmatrix<T> operator|(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator|(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Bitwise or operator for valmatrix with value.
@@ -1003,8 +1265,8 @@ valmatrix<T> operator|(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of bitwise or.
  */
-template<typename T>
-valmatrix<T> operator|(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator|(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Bitwise or operator for valmatrix with valarray.
@@ -1015,8 +1277,8 @@ valmatrix<T> operator|(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of bitwise or.
  */
-template<typename T>
-valmatrix<T> operator|(const std::valarray<T>& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator|(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Bitwise or operator for valmatrix with value.
@@ -1025,8 +1287,8 @@ valmatrix<T> operator|(const std::valarray<T>& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of bitwise or.
  */
-template<typename T>
-valmatrix<T> operator|(const T& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator|(const T& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Xor operator for valmatrix.
@@ -1038,8 +1300,8 @@ valmatrix<T> operator|(const T& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of xor.
  */
-template<typename T>
-valmatrix<T> operator^(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator^(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Xor operator for valmatrix with valarray.
@@ -1050,8 +1312,8 @@ valmatrix<T> operator^(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of xor.
  */
-template<typename T>
-valmatrix<T> operator^(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator^(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Xor operator for valmatrix with value.
@@ -1060,8 +1322,8 @@ valmatrix<T> operator^(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of xor.
  */
-template<typename T>
-valmatrix<T> operator^(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator^(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Xor operator for valmatrix with valarray.
@@ -1072,8 +1334,8 @@ valmatrix<T> operator^(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of xor.
  */
-template<typename T>
-valmatrix<T> operator^(const std::valarray<T>& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator^(const std::valarray<T>& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Xor operator for valmatrix with value.
@@ -1082,8 +1344,8 @@ valmatrix<T> operator^(const std::valarray<T>& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of xor.
  */
-template<typename T>
-valmatrix<T> operator^(const T& lhs, valmatrix<T> rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator^(const T& lhs, valmatrix<T, Layout> rhs);
 
 /**
  * @brief Shift operator for valmatrix.
@@ -1095,8 +1357,8 @@ valmatrix<T> operator^(const T& lhs, valmatrix<T> rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of shift.
  */
-template<typename T>
-valmatrix<T> operator<<(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Shift operator for valmatrix with valarray.
@@ -1107,8 +1369,8 @@ valmatrix<T> operator<<(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of shift.
  */
-template<typename T>
-valmatrix<T> operator<<(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Shift operator for valmatrix with value.
@@ -1117,8 +1379,8 @@ valmatrix<T> operator<<(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of shift.
  */
-template<typename T>
-valmatrix<T> operator<<(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Shift operator for valmatrix with valarray.
@@ -1129,8 +1391,8 @@ valmatrix<T> operator<<(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of shift.
  */
-template<typename T>
-valmatrix<T> operator<<(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Shift operator for valmatrix with value.
@@ -1139,8 +1401,34 @@ valmatrix<T> operator<<(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of shift.
  */
-template<typename T>
-valmatrix<T> operator<<(const T& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(const T& lhs, const valmatrix<T, Layout>& rhs);
+
+/**
+ * @brief Shift operator for valmatrix with valarray.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @pre lhs.size() == rhs.size()
+ *
+ * @param[in] lhs Left hand side value that is valarray.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of shift.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs);
+
+/**
+ * @brief Shift operator for valmatrix with value.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @param[in] lhs Left hand side value that is value.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of shift.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator<<(const T& lhs, valmatrix<T, Layout>&& rhs);
 
 /**
  * @brief Counter shift operator for valmatrix.
@@ -1152,8 +1440,8 @@ valmatrix<T> operator<<(const T& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of counter shift.
  */
-template<typename T>
-valmatrix<T> operator>>(valmatrix<T> lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(valmatrix<T, Layout> lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Counter shift operator for valmatrix with valarray.
@@ -1164,8 +1452,8 @@ valmatrix<T> operator>>(valmatrix<T> lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value that is valarray.
  * @return Result of counter shift.
  */
-template<typename T>
-valmatrix<T> operator>>(valmatrix<T> lhs, const std::valarray<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(valmatrix<T, Layout> lhs, const std::valarray<T>& rhs);
 
 /**
  * @brief Counter shift operator for valmatrix with value.
@@ -1174,8 +1462,8 @@ valmatrix<T> operator>>(valmatrix<T> lhs, const std::valarray<T>& rhs);
  * @param[in] rhs Right hand side value that is value.
  * @return Result of counter shift.
  */
-template<typename T>
-valmatrix<T> operator>>(valmatrix<T> lhs, const T& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(valmatrix<T, Layout> lhs, const T& rhs);
 
 /**
  * @brief Counter shift operator for valmatrix with valarray.
@@ -1186,8 +1474,8 @@ valmatrix<T> operator>>(valmatrix<T> lhs, const T& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of counter shift.
  */
-template<typename T>
-valmatrix<T> operator>>(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(const std::valarray<T>& lhs, const valmatrix<T, Layout>& rhs);
 
 /**
  * @brief Counter shift operator for valmatrix with value.
@@ -1196,8 +1484,34 @@ valmatrix<T> operator>>(const std::valarray<T>& lhs, const valmatrix<T>& rhs);
  * @param[in] rhs Right hand side value.
  * @return Result of counter shift.
  */
-template<typename T>
-valmatrix<T> operator>>(const T& lhs, const valmatrix<T>& rhs);
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(const T& lhs, const valmatrix<T, Layout>& rhs);
+
+/**
+ * @brief Counter shift operator for valmatrix with valarray.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @pre lhs.size() == rhs.size()
+ *
+ * @param[in] lhs Left hand side value that is valarray.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of counter shift.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(const std::valarray<T>& lhs, valmatrix<T, Layout>&& rhs);
+
+/**
+ * @brief Counter shift operator for valmatrix with value.
+ *
+ * The storage of temporary rhs is reused for the result.
+ *
+ * @param[in] lhs Left hand side value that is value.
+ * @param[in] rhs Right hand side value that is temporary.
+ * @return Result of counter shift.
+ */
+template<typename T, typename Layout>
+valmatrix<T, Layout> operator>>(const T& lhs, valmatrix<T, Layout>&& rhs);
 
 /**
  * @brief Get begin iterator.
@@ -1205,8 +1519,8 @@ valmatrix<T> operator>>(const T& lhs, const valmatrix<T>& rhs);
  * @param[in] v Target matrix.
  * @return Const begin iterator.
  */
-template<typename T>
-auto begin(const valmatrix<T>& v) noexcept;
+template<typename T, typename Layout>
+auto begin(const valmatrix<T, Layout>& v) noexcept;
 
 /**
  * @brief Get begin iterator.
@@ -1214,8 +1528,8 @@ auto begin(const valmatrix<T>& v) noexcept;
  * @param[in] v Target matrix.
  * @return Begin iterator.
  */
-template<typename T>
-auto begin(valmatrix<T>& v) noexcept;
+template<typename T, typename Layout>
+auto begin(valmatrix<T, Layout>& v) noexcept;
 
 /**
  * @brief Get end iterator.
@@ -1223,8 +1537,8 @@ auto begin(valmatrix<T>& v) noexcept;
  * @param[in] v Target matrix.
  * @return Const end iterator.
  */
-template<typename T>
-auto end(const valmatrix<T>& v) noexcept;
+template<typename T, typename Layout>
+auto end(const valmatrix<T, Layout>& v) noexcept;
 
 /**
  * @brief Get end iterator.
@@ -1232,8 +1546,8 @@ auto end(const valmatrix<T>& v) noexcept;
  * @param[in] v Target matrix.
  * @return End iterator.
  */
-template<typename T>
-auto end(valmatrix<T>& v) noexcept;
+template<typename T, typename Layout>
+auto end(valmatrix<T, Layout>& v) noexcept;
 
 /**
  * @brief Swap objects.
@@ -1241,8 +1555,8 @@ auto end(valmatrix<T>& v) noexcept;
  * @param[in,out] a Swap target.
  * @param[in,out] b Swap target.
  */
-template<typename T>
-void swap(valmatrix<T>& a, valmatrix<T>& b) noexcept;
+template<typename T, typename Layout>
+void swap(valmatrix<T, Layout>& a, valmatrix<T, Layout>& b) noexcept;
 
 }
 
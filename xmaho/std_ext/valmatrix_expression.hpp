@@ -0,0 +1,361 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_VALMATRIX_EXPRESSION_H
+#define XMAHO_STD_EXT_VALMATRIX_EXPRESSION_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <valarray>
+
+/**
+ * @file std_ext/valmatrix_expression.hpp
+ * @brief The lazy element-wise expression for valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+template<typename E>
+class valmatrix_expression;
+
+template<typename T>
+class transposed_view;
+
+namespace detail
+{
+
+template<typename L, typename R>
+struct is_expression_operands;
+
+template<typename L, typename R>
+constexpr bool is_expression_operands_v {is_expression_operands<L, R>::value};
+
+}
+
+/**
+ * @brief The lazy element-wise expression of valmatrix.
+ *
+ * The operators of valmatrix create a full matrix for each intermediate result.
+ * The operators of this class only build a tree of operations,
+ * and the tree is evaluated in a single loop when it is assigned to valmatrix.
+ *
+ * @note
+ * This class hold reference to operands.
+ * So all operands require long-term life then this instance.
+ *
+ * @tparam E The node type of expression tree.
+ *
+ * @code
+ * valmatrix<double> a(1., 3, 2), b(2., 3, 2), c(3., 3, 2), d(4., 3, 2);
+ * valmatrix<double> result {lazy(a) + lazy(b) * c - d}; // one loop, no temporaries.
+ * result = lazy(result) * 2.; // assign reuses the storage of result.
+ * @endcode
+ */
+template<typename E>
+class valmatrix_expression
+{
+public:
+  //! @brief Value type of the expression.
+  using value_type = typename E::value_type;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+
+  /**
+   * @brief Construct by node of expression tree.
+   *
+   * @param[in] node Node of expression tree.
+   */
+  explicit constexpr valmatrix_expression(E node);
+
+  /**
+   * @brief Evaluate an element.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Serial index of element.
+   * @return Value of element.
+   */
+  constexpr value_type operator[](size_type index) const;
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  constexpr size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  constexpr size_type col_size() const noexcept;
+
+  /**
+   * @brief Get element count.
+   *
+   * @return row_size() * col_size()
+   */
+  constexpr size_type size() const noexcept;
+
+  /**
+   * @brief Evaluate all elements into contiguous storage.
+   *
+   * Elements are evaluated tile by tile if the expression refers transposed_view,
+   * so both the storage and the transposed operand are accessed locally.
+   *
+   * @pre first has size() elements.
+   *
+   * @param[out] first First element of destination.
+   */
+  void copy_to(value_type* first) const;
+
+  /**
+   * @brief Get node of expression tree.
+   *
+   * @return Node of expression tree.
+   */
+  constexpr const E& node() const noexcept;
+
+private:
+  E node_;
+};
+
+/**
+ * @brief Start lazy expression from valmatrix.
+ *
+ * @param[in] m The operand matrix.
+ * @return The expression that refers m.
+ */
+template<typename T>
+constexpr auto lazy(const valmatrix<T>& m) noexcept;
+
+/**
+ * @brief Start lazy expression from transposed_view.
+ *
+ * @param[in] m The operand transposed matrix.
+ * @return The expression that refers m.
+ */
+template<typename T>
+constexpr auto lazy(const transposed_view<T>& m) noexcept;
+
+/**
+ * @brief Addition operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of addition.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator+(const L& lhs, const R& rhs);
+
+/**
+ * @brief Subtraction operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of subtraction.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator-(const L& lhs, const R& rhs);
+
+/**
+ * @brief Multiplication operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of multiplication.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator*(const L& lhs, const R& rhs);
+
+/**
+ * @brief Divition operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of divition.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator/(const L& lhs, const R& rhs);
+
+/**
+ * @brief Residue operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of residue.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator%(const L& lhs, const R& rhs);
+
+/**
+ * @brief Bitwise and operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of bitwise and.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator&(const L& lhs, const R& rhs);
+
+/**
+ * @brief Bitwise or operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of bitwise or.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator|(const L& lhs, const R& rhs);
+
+/**
+ * @brief Xor operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of xor.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator^(const L& lhs, const R& rhs);
+
+/**
+ * @brief Shift operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of shift.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator<<(const L& lhs, const R& rhs);
+
+/**
+ * @brief Counter shift operator for valmatrix expression.
+ *
+ * Either operand is valmatrix_expression.
+ * The other is valmatrix_expression, valmatrix, valarray or value of same value type.
+ *
+ * @pre Both operands have same dimention if they are matrices.
+ * @pre Both operands have same size if either is valarray.
+ *
+ * @param[in] lhs Left hand side operand.
+ * @param[in] rhs Right hand side operand.
+ * @return The expression of counter shift.
+ */
+template<typename L, typename R, typename = std::enable_if_t<detail::is_expression_operands_v<L, R>>>
+constexpr auto operator>>(const L& lhs, const R& rhs);
+
+/**
+ * @brief Apply + operator to each elements lazily.
+ *
+ * @param[in] e The expression.
+ * @return The expression.
+ */
+template<typename E>
+constexpr auto operator+(const valmatrix_expression<E>& e);
+
+/**
+ * @brief Apply - operator to each elements lazily.
+ *
+ * @param[in] e The expression.
+ * @return The expression.
+ */
+template<typename E>
+constexpr auto operator-(const valmatrix_expression<E>& e);
+
+/**
+ * @brief Apply ~ operator to each elements lazily.
+ *
+ * @param[in] e The expression.
+ * @return The expression.
+ */
+template<typename E>
+constexpr auto operator~(const valmatrix_expression<E>& e);
+
+}
+
+#include "detail/valmatrix_expression.hpp"
+
+#endif
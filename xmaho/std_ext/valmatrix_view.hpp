@@ -0,0 +1,848 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2017 - 2020, FORNO
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef XMAHO_STD_EXT_VALMATRIX_VIEW_H
+#define XMAHO_STD_EXT_VALMATRIX_VIEW_H
+
+#include "valmatrix.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <valarray>
+
+/**
+ * @file std_ext/valmatrix_view.hpp
+ * @brief The non-owning views of row, column and block of valmatrix.
+ */
+
+namespace xmaho::std_ext
+{
+
+/**
+ * @brief Non-owning strided view of one dimension.
+ *
+ * This class is used for row and column of valmatrix.
+ * Copy of this class refers same elements, but assignment copies elements like std::slice_array.
+ * Use `const T` for read only view.
+ *
+ * @note
+ * This class hold pointer to the storage of parent.
+ * So the parent requires long-term life then this instance.
+ *
+ * @tparam T Value type. const qualified type is read only view.
+ */
+template<typename T>
+class valarray_view
+{
+public:
+  //! @brief Value type of elements.
+  using value_type = std::remove_const_t<T>;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+
+  //! @brief Strided iterator.
+  class iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator() = default;
+    constexpr iterator(T* ptr, difference_type stride) noexcept : ptr_ {ptr}, stride_ {stride} {}
+
+    constexpr reference operator*() const noexcept {return *ptr_;}
+    constexpr pointer operator->() const noexcept {return ptr_;}
+    constexpr reference operator[](difference_type n) const noexcept {return ptr_[n * stride_];}
+    constexpr iterator& operator++() noexcept {ptr_ += stride_; return *this;}
+    constexpr iterator operator++(int) noexcept {auto tmp {*this}; ++*this; return tmp;}
+    constexpr iterator& operator--() noexcept {ptr_ -= stride_; return *this;}
+    constexpr iterator operator--(int) noexcept {auto tmp {*this}; --*this; return tmp;}
+    constexpr iterator& operator+=(difference_type n) noexcept {ptr_ += n * stride_; return *this;}
+    constexpr iterator& operator-=(difference_type n) noexcept {ptr_ -= n * stride_; return *this;}
+    constexpr iterator operator+(difference_type n) const noexcept {return iterator{*this} += n;}
+    constexpr iterator operator-(difference_type n) const noexcept {return iterator{*this} -= n;}
+    constexpr difference_type operator-(const iterator& rhs) const noexcept {return (ptr_ - rhs.ptr_) / stride_;}
+    constexpr bool operator==(const iterator& rhs) const noexcept {return ptr_ == rhs.ptr_;}
+    constexpr bool operator!=(const iterator& rhs) const noexcept {return ptr_ != rhs.ptr_;}
+    constexpr bool operator<(const iterator& rhs) const noexcept {return ptr_ < rhs.ptr_;}
+    constexpr bool operator>(const iterator& rhs) const noexcept {return rhs < *this;}
+    constexpr bool operator<=(const iterator& rhs) const noexcept {return !(rhs < *this);}
+    constexpr bool operator>=(const iterator& rhs) const noexcept {return !(*this < rhs);}
+
+  private:
+    T* ptr_ {};
+    difference_type stride_ {1};
+  };
+
+  /**
+   * @brief Construct by storage.
+   *
+   * @param[in] data First element.
+   * @param[in] size Count of elements.
+   * @param[in] stride Distance between elements.
+   */
+  constexpr valarray_view(T* data, size_type size, size_type stride) noexcept;
+
+  //! @brief Copy refers same elements.
+  valarray_view(const valarray_view&) = default;
+
+  /**
+   * @brief Convert mutable view to read only view.
+   *
+   * @param[in] other Mutable view.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  constexpr valarray_view(const valarray_view<U>& other) noexcept;
+
+  /**
+   * @brief Assign to each element in the view.
+   *
+   * @pre size() == rhs.size()
+   *
+   * @note rhs may share storage with this view.
+   *
+   * @param[in] rhs Same size view.
+   * @return This reference.
+   */
+  valarray_view& operator=(const valarray_view& rhs);
+
+  /**
+   * @brief Assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @note rhs may share storage with this view.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator=(const U& rhs);
+
+  /**
+   * @brief Access by index.
+   *
+   * @pre index < size()
+   *
+   * @param[in] index Access point.
+   * @return Reference of access point.
+   */
+  constexpr T& operator[](size_type index) const;
+
+  /**
+   * @brief Addition assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator+=(const U& rhs);
+
+  /**
+   * @brief Subtraction assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator-=(const U& rhs);
+
+  /**
+   * @brief Multiplication assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator*=(const U& rhs);
+
+  /**
+   * @brief Divition assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator/=(const U& rhs);
+
+  /**
+   * @brief Residue assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator%=(const U& rhs);
+
+  /**
+   * @brief Bitwise and assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator&=(const U& rhs);
+
+  /**
+   * @brief Bitwise or assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator|=(const U& rhs);
+
+  /**
+   * @brief Xor assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator^=(const U& rhs);
+
+  /**
+   * @brief Shift assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator<<=(const U& rhs);
+
+  /**
+   * @brief Counter shift assign to each element in the view.
+   *
+   * @pre size() == rhs.size() if rhs isn't value.
+   *
+   * @param[in] rhs Value, valarray or valarray_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valarray_view& operator>>=(const U& rhs);
+
+  /**
+   * @brief Get count of elements.
+   *
+   * @return Count of elements.
+   */
+  constexpr size_type size() const noexcept;
+
+  /**
+   * @brief Get distance between elements.
+   *
+   * @return Stride.
+   */
+  constexpr size_type stride() const noexcept;
+
+  /**
+   * @brief Get pointer to first element.
+   *
+   * @return Pointer to first element.
+   */
+  constexpr T* data() const noexcept;
+
+  /**
+   * @brief Get sum of elements without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Sum of elements.
+   */
+  value_type sum() const;
+
+  /**
+   * @brief Get minimum element without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Minimum element.
+   */
+  value_type min() const;
+
+  /**
+   * @brief Get maximum element without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Maximum element.
+   */
+  value_type max() const;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Begin iterator.
+   */
+  constexpr iterator begin() const noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return End iterator.
+   */
+  constexpr iterator end() const noexcept;
+
+private:
+  template<typename U, typename Op>
+  valarray_view& apply(const U& rhs, Op op);
+
+  T* data_;
+  size_type size_;
+  size_type stride_;
+};
+
+/**
+ * @brief Non-owning strided view of two dimension.
+ *
+ * This class is used for block of valmatrix.
+ * Copy of this class refers same elements, but assignment copies elements like std::slice_array.
+ * Iteration is row by row.
+ * Use `const T` for read only view.
+ *
+ * @note
+ * This class hold pointer to the storage of parent.
+ * So the parent requires long-term life then this instance.
+ *
+ * @tparam T Value type. const qualified type is read only view.
+ */
+template<typename T>
+class valmatrix_view
+{
+public:
+  //! @brief Value type of elements.
+  using value_type = std::remove_const_t<T>;
+  //! @brief Size type for access to values.
+  using size_type = std::size_t;
+  //! @brief Specific position type for two dimention.
+  using position_type = std::pair<size_type, size_type>;
+
+  //! @brief Row by row iterator.
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator() = default;
+    constexpr iterator(T* row, size_type x, size_type width, size_type stride) noexcept
+      : row_ {row}, x_ {x}, width_ {width}, stride_ {stride} {}
+
+    constexpr reference operator*() const noexcept {return row_[x_];}
+    constexpr pointer operator->() const noexcept {return row_ + x_;}
+    constexpr iterator& operator++() noexcept
+    {
+      if (++x_ == width_) {
+        x_ = 0;
+        row_ += stride_;
+      }
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept {auto tmp {*this}; ++*this; return tmp;}
+    constexpr bool operator==(const iterator& rhs) const noexcept {return row_ == rhs.row_ && x_ == rhs.x_;}
+    constexpr bool operator!=(const iterator& rhs) const noexcept {return !(*this == rhs);}
+
+  private:
+    T* row_ {};
+    size_type x_ {};
+    size_type width_ {};
+    size_type stride_ {};
+  };
+
+  /**
+   * @brief Construct by storage.
+   *
+   * @param[in] data Top left element.
+   * @param[in] row_size Count of column.
+   * @param[in] col_size Count of row.
+   * @param[in] stride Distance between rows.
+   */
+  constexpr valmatrix_view(T* data, size_type row_size, size_type col_size, size_type stride) noexcept;
+
+  //! @brief Copy refers same elements.
+  valmatrix_view(const valmatrix_view&) = default;
+
+  /**
+   * @brief Convert mutable view to read only view.
+   *
+   * @param[in] other Mutable view.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  constexpr valmatrix_view(const valmatrix_view<U>& other) noexcept;
+
+  /**
+   * @brief Assign to each element in the view.
+   *
+   * @pre row_size() == rhs.row_size()
+   * @pre col_size() == rhs.col_size()
+   *
+   * @note rhs may share storage with this view.
+   *
+   * @param[in] rhs Same dimention view.
+   * @return This reference.
+   */
+  valmatrix_view& operator=(const valmatrix_view& rhs);
+
+  /**
+   * @brief Assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @note rhs may share storage with this view.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator=(const U& rhs);
+
+  /**
+   * @brief Access by position.
+   *
+   * @pre position.first < row_size()
+   * @pre position.second < col_size()
+   *
+   * @param[in] position Access point as column and row.
+   * @return Reference of access point.
+   */
+  constexpr T& operator[](position_type position) const;
+
+  /**
+   * @brief Addition assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator+=(const U& rhs);
+
+  /**
+   * @brief Subtraction assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator-=(const U& rhs);
+
+  /**
+   * @brief Multiplication assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator*=(const U& rhs);
+
+  /**
+   * @brief Divition assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator/=(const U& rhs);
+
+  /**
+   * @brief Residue assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator%=(const U& rhs);
+
+  /**
+   * @brief Bitwise and assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator&=(const U& rhs);
+
+  /**
+   * @brief Bitwise or assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator|=(const U& rhs);
+
+  /**
+   * @brief Xor assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator^=(const U& rhs);
+
+  /**
+   * @brief Shift assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator<<=(const U& rhs);
+
+  /**
+   * @brief Counter shift assign to each element in the view.
+   *
+   * @pre Same dimention if rhs isn't value.
+   *
+   * @param[in] rhs Value, valmatrix or valmatrix_view.
+   * @return This reference.
+   */
+  template<typename U>
+  valmatrix_view& operator>>=(const U& rhs);
+
+  /**
+   * @brief Get row size.
+   *
+   * @return Count of column.
+   */
+  constexpr size_type row_size() const noexcept;
+
+  /**
+   * @brief Get column size.
+   *
+   * @return Count of row.
+   */
+  constexpr size_type col_size() const noexcept;
+
+  /**
+   * @brief Get count of elements.
+   *
+   * @return row_size() * col_size()
+   */
+  constexpr size_type size() const noexcept;
+
+  /**
+   * @brief Get distance between rows.
+   *
+   * @return Stride.
+   */
+  constexpr size_type stride() const noexcept;
+
+  /**
+   * @brief Get pointer to top left element.
+   *
+   * @return Pointer to top left element.
+   */
+  constexpr T* data() const noexcept;
+
+  /**
+   * @brief Get view of row.
+   *
+   * @pre index < col_size()
+   *
+   * @param[in] index Row index.
+   * @return Row view.
+   */
+  constexpr valarray_view<T> row(size_type index) const;
+
+  /**
+   * @brief Get view of column.
+   *
+   * @pre index < row_size()
+   *
+   * @param[in] index Column index.
+   * @return Column view.
+   */
+  constexpr valarray_view<T> col(size_type index) const;
+
+  /**
+   * @brief Get view of block in this view.
+   *
+   * @pre pos.first + size.first <= row_size()
+   * @pre pos.second + size.second <= col_size()
+   *
+   * @param[in] pos Block's top left position as column and row.
+   * @param[in] size Block's size as row size and column size.
+   * @return Block view.
+   */
+  constexpr valmatrix_view block(position_type pos, position_type size) const;
+
+  /**
+   * @brief Get sum of elements without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Sum of elements.
+   */
+  value_type sum() const;
+
+  /**
+   * @brief Get minimum element without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Minimum element.
+   */
+  value_type min() const;
+
+  /**
+   * @brief Get maximum element without copy.
+   *
+   * @pre 0 < size()
+   *
+   * @return Maximum element.
+   */
+  value_type max() const;
+
+  /**
+   * @brief Get begin iterator.
+   *
+   * @return Begin iterator.
+   */
+  constexpr iterator begin() const noexcept;
+
+  /**
+   * @brief Get end iterator.
+   *
+   * @return End iterator.
+   */
+  constexpr iterator end() const noexcept;
+
+private:
+  template<typename U, typename Op>
+  valmatrix_view& apply(const U& rhs, Op op);
+
+  T* data_;
+  size_type row_size_;
+  size_type col_size_;
+  size_type stride_;
+};
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return View of m.
+ */
+template<typename T>
+valmatrix_view<const T> view(const valmatrix<T>& m) noexcept;
+
+/**
+ * @brief Get view of whole matrix.
+ *
+ * @param[in] m Target matrix.
+ * @return View of m.
+ */
+template<typename T>
+valmatrix_view<T> view(valmatrix<T>& m) noexcept;
+
+/**
+ * @brief Get view of block without copy.
+ *
+ * @pre pos.first + size.first <= m.row_size()
+ * @pre pos.second + size.second <= m.col_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] pos Block's top left position as column and row.
+ * @param[in] size Block's size as row size and column size.
+ * @return Read only view of block.
+ *
+ * @code
+ * valmatrix<int> m {{1, 2, 3, 4, 5, 6}, 3, 2};
+ * auto b {block_view(m, {1, 0}, {2, 2})}; // {2, 3, 5, 6}
+ * assert(b.sum() == 16);
+ * b += 10; // m == {1, 12, 13, 4, 15, 16}
+ * @endcode
+ */
+template<typename T>
+valmatrix_view<const T> block_view(const valmatrix<T>& m, std::pair<std::size_t, std::size_t> pos, std::pair<std::size_t, std::size_t> size);
+
+/**
+ * @brief Get view of block without copy.
+ *
+ * @pre pos.first + size.first <= m.row_size()
+ * @pre pos.second + size.second <= m.col_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] pos Block's top left position as column and row.
+ * @param[in] size Block's size as row size and column size.
+ * @return View of block.
+ */
+template<typename T>
+valmatrix_view<T> block_view(valmatrix<T>& m, std::pair<std::size_t, std::size_t> pos, std::pair<std::size_t, std::size_t> size);
+
+/**
+ * @brief Get view of row without copy.
+ *
+ * @pre index < m.col_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] index Row index.
+ * @return Read only view of row.
+ */
+template<typename T>
+valarray_view<const T> row_view(const valmatrix<T>& m, std::size_t index);
+
+/**
+ * @brief Get view of row without copy.
+ *
+ * @pre index < m.col_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] index Row index.
+ * @return View of row.
+ */
+template<typename T>
+valarray_view<T> row_view(valmatrix<T>& m, std::size_t index);
+
+/**
+ * @brief Get view of column without copy.
+ *
+ * @pre index < m.row_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] index Column index.
+ * @return Read only view of column.
+ */
+template<typename T>
+valarray_view<const T> col_view(const valmatrix<T>& m, std::size_t index);
+
+/**
+ * @brief Get view of column without copy.
+ *
+ * @pre index < m.row_size()
+ *
+ * @param[in] m Target matrix.
+ * @param[in] index Column index.
+ * @return View of column.
+ */
+template<typename T>
+valarray_view<T> col_view(valmatrix<T>& m, std::size_t index);
+
+/**
+ * @brief Copy elements of view to new valmatrix.
+ *
+ * @param[in] v Source view.
+ * @return Copy of view.
+ */
+template<typename T>
+valmatrix<std::remove_const_t<T>> to_valmatrix(const valmatrix_view<T>& v);
+
+/**
+ * @brief Copy elements of view to new valarray.
+ *
+ * @param[in] v Source view.
+ * @return Copy of view.
+ */
+template<typename T>
+std::valarray<std::remove_const_t<T>> to_valarray(const valarray_view<T>& v);
+
+/**
+ * @brief Get begin iterator.
+ *
+ * @param[in] v Target view.
+ * @return Begin iterator.
+ */
+template<typename T>
+constexpr auto begin(const valarray_view<T>& v) noexcept;
+
+/**
+ * @brief Get end iterator.
+ *
+ * @param[in] v Target view.
+ * @return End iterator.
+ */
+template<typename T>
+constexpr auto end(const valarray_view<T>& v) noexcept;
+
+/**
+ * @brief Get begin iterator.
+ *
+ * @param[in] v Target view.
+ * @return Begin iterator.
+ */
+template<typename T>
+constexpr auto begin(const valmatrix_view<T>& v) noexcept;
+
+/**
+ * @brief Get end iterator.
+ *
+ * @param[in] v Target view.
+ * @return End iterator.
+ */
+template<typename T>
+constexpr auto end(const valmatrix_view<T>& v) noexcept;
+
+}
+
+#include "detail/valmatrix_view.hpp"
+
+#endif